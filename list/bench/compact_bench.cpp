@@ -0,0 +1,89 @@
+// Scan speed of a list whose nodes got scattered, before and after compact() (whole list, and in steps of 4096 nodes)
+// g++ -std=c++17 -O2 -DNDEBUG -I.. compact_bench.cpp -o compact_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include "../list.hpp"
+#include "../node_pool.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	double ns_per_element(clock_type::time_point start, std::size_t elements)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(elements);
+	}
+
+	// ns per element of a plain range-for sum
+	template <class List>
+	double scan(const List& list)
+	{
+		const auto rounds = 20'000'000 / list.size() + 1;
+		std::int64_t sum{};
+		auto start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			for (auto value : list) {
+				sum += value;
+			}
+		}
+		auto ns = ns_per_element(start, list.size() * rounds);
+		sink = sum;
+		return ns;
+	}
+
+	template <class List>
+	List random_list(std::size_t size)
+	{
+		std::mt19937 gen{ 7 };
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(gen()));
+		}
+		return list;
+	}
+
+	template <class List>
+	void report(const char* name, std::size_t size)
+	{
+		auto list = random_list<List>(size);
+		auto in_order = scan(list);
+
+		list.sort(); // the nodes are relinked in value order, like after a long time of splices and erases
+		auto scattered = scan(list);
+
+		auto start = clock_type::now();
+		list.compact();
+		auto compact_cost = ns_per_element(start, size);
+		auto compacted = scan(list);
+
+		auto stepped_list = random_list<List>(size);
+		stepped_list.sort();
+		for (auto it = stepped_list.begin(); it != stepped_list.end(); ) {
+			it = stepped_list.compact(it, 4'096);
+		}
+		auto stepped = scan(stepped_list);
+
+		std::printf("%-10zu %-10s %10.2f %10.2f %10.2f %10.2f %12.2f\n", size, name, in_order, scattered, compacted, stepped, compact_cost);
+	}
+}
+
+int main()
+{
+	using std_alloc_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	using pool_list = my_lib::list<std::int32_t, my_lib::node_pool<std::int32_t>, my_lib::unchecked_iterators>;
+	constexpr std::size_t sizes[]{ 10'000, 1'000'000, 4'000'000 };
+
+	std::printf("int32 values, ns per element of a range-for scan, and of one compact()\n");
+	std::printf("%-10s %-10s %10s %10s %10s %10s %12s\n", "elements", "allocator", "in order", "scattered", "compact()", "steps 4096", "compact cost");
+	for (auto size : sizes) {
+		report<std_alloc_list>("std", size);
+		report<pool_list>("node_pool", size);
+	}
+	return 0;
+}
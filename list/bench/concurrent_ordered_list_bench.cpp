@@ -0,0 +1,123 @@
+// concurrent_ordered_list vs a sorted my_lib::list behind a std::shared_mutex, read-mostly and write-mostly mixes
+// g++ -std=c++17 -O2 -DNDEBUG -pthread -I.. concurrent_ordered_list_bench.cpp -o concurrent_ordered_list_bench
+// ./concurrent_ordered_list_bench [max threads]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../list.hpp"
+#include "../concurrent_ordered_list.hpp"
+
+namespace
+{
+	volatile long long sink; // keeps the lookups alive
+
+	class locked_sorted_list
+	{
+		my_lib::list<int> list_;
+		std::shared_mutex mutex_;
+
+	public:
+		bool insert(int value)
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex_ };
+			auto it = std::find_if(list_.begin(), list_.end(), [value](int x) { return !(x < value); });
+			if (it != list_.end() && *it == value) {
+				return false;
+			}
+			list_.insert(it, value);
+			return true;
+		}
+
+		bool erase(int value)
+		{
+			std::unique_lock<std::shared_mutex> lock{ mutex_ };
+			auto it = std::find_if(list_.begin(), list_.end(), [value](int x) { return !(x < value); });
+			if (it == list_.end() || *it != value) {
+				return false;
+			}
+			list_.erase(it);
+			return true;
+		}
+
+		bool contains(int value)
+		{
+			std::shared_lock<std::shared_mutex> lock{ mutex_ };
+			auto it = std::find_if(list_.begin(), list_.end(), [value](int x) { return !(x < value); });
+			return it != list_.end() && *it == value;
+		}
+	};
+
+	// every thread runs `ops` random operations on keys [0, range), `read_percent` of them lookups,
+	// the rest split evenly between insert and erase. Returns Mops/s
+	template <class Set>
+	double throughput(std::size_t threads, unsigned read_percent, int range, std::size_t ops)
+	{
+		Set set;
+		for (int key{}; key < range; key += 2) { // half full, inserts and erases keep it so
+			set.insert(key);
+		}
+
+		std::atomic<bool> go{};
+		std::vector<std::thread> workers;
+		for (std::size_t i{}; i < threads; ++i) {
+			workers.emplace_back([&, i] {
+				std::mt19937 gen{ static_cast<unsigned>(i) + 1 };
+				std::uniform_int_distribution<int> keys{ 0, range - 1 };
+				std::uniform_int_distribution<unsigned> kind{ 0, 99 };
+				long long found{};
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t n{}; n < ops; ++n) {
+					auto key = keys(gen);
+					auto roll = kind(gen);
+					if (roll < read_percent) {
+						found += set.contains(key);
+					}
+					else if ((roll - read_percent) % 2 == 0) {
+						set.insert(key);
+					}
+					else {
+						set.erase(key);
+					}
+				}
+				sink = found;
+			});
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		go.store(true, std::memory_order_release);
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		return static_cast<double>(threads * ops) / elapsed.count() / 1e6;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+	if (max_threads == 0) {
+		max_threads = 1;
+	}
+	constexpr int range{ 1024 };
+	constexpr std::size_t ops{ 200'000 }; // per thread
+
+	std::printf("hardware threads: %u, keys: %d\n", std::thread::hardware_concurrency(), range);
+	std::printf("%-8s %-10s %16s %16s\n", "reads %", "threads", "rwlock Mops/s", "lock-free Mops/s");
+	for (unsigned read_percent : { 90u, 10u }) {
+		for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2) {
+			auto locked = throughput<locked_sorted_list>(threads, read_percent, range, ops);
+			auto lock_free = throughput<my_lib::concurrent_ordered_list<int>>(threads, read_percent, range, ops);
+			std::printf("%-8u %-10zu %16.2f %16.2f\n", read_percent, threads, locked, lock_free);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,119 @@
+// concurrent_queue vs my_lib::list behind a mutex, producers/consumers throughput
+// g++ -std=c++17 -O2 -DNDEBUG -pthread -I.. concurrent_queue_bench.cpp -o concurrent_queue_bench
+// ./concurrent_queue_bench [max threads per side]
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../list.hpp"
+#include "../concurrent_queue.hpp"
+
+namespace
+{
+	class mutex_queue
+	{
+		my_lib::list<long long> list_;
+		std::mutex mutex_;
+
+	public:
+		void push_back(long long value)
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			list_.push_back(value);
+		}
+
+		bool try_pop_front(long long& value)
+		{
+			std::lock_guard<std::mutex> lock{ mutex_ };
+			if (list_.empty()) {
+				return false;
+			}
+			value = list_.front();
+			list_.pop_front();
+			return true;
+		}
+	};
+
+	// every producer pushes `per_producer` values, consumers pop until all of them are seen. Returns Mops/s
+	template <class Queue>
+	double throughput(std::size_t producers, std::size_t consumers, std::size_t per_producer)
+	{
+		Queue queue;
+		const auto total = producers * per_producer;
+		std::atomic<std::size_t> popped{};
+		std::atomic<long long> sum{};
+		std::atomic<bool> go{};
+
+		std::vector<std::thread> threads;
+		for (std::size_t i{}; i < producers; ++i) {
+			threads.emplace_back([&] {
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t n{}; n < per_producer; ++n) {
+					queue.push_back(static_cast<long long>(n));
+				}
+			});
+		}
+		for (std::size_t i{}; i < consumers; ++i) {
+			threads.emplace_back([&] {
+				while (!go.load(std::memory_order_acquire)) {}
+				long long local{};
+				long long value{};
+				while (popped.load(std::memory_order_relaxed) < total) {
+					if (queue.try_pop_front(value)) {
+						local += value;
+						popped.fetch_add(1, std::memory_order_relaxed);
+					}
+					else {
+						std::this_thread::yield();
+					}
+				}
+				sum.fetch_add(local);
+			});
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		go.store(true, std::memory_order_release);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		const auto expected = static_cast<long long>(producers) * static_cast<long long>(per_producer * (per_producer - 1) / 2);
+		if (sum.load() != expected) {
+			std::printf("lost values!\n");
+			std::exit(1);
+		}
+		return static_cast<double>(total) / elapsed.count() / 1e6;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+	if (max_threads == 0) {
+		max_threads = 1;
+	}
+	constexpr std::size_t ops{ 1'000'000 }; // pushes per run, split between the producers
+
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	std::printf("%-10s %-10s %16s %16s\n", "producers", "consumers", "mutex Mops/s", "lock-free Mops/s");
+	for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2) {
+		// balanced, fan-out, fan-in
+		std::vector<std::pair<std::size_t, std::size_t>> runs{ { threads, threads } };
+		if (threads > 1) {
+			runs.push_back({ 1, threads });
+			runs.push_back({ threads, 1 });
+		}
+		for (auto [producers, consumers] : runs) {
+			auto locked = throughput<mutex_queue>(producers, consumers, ops / producers);
+			auto lock_free = throughput<my_lib::concurrent_queue<long long>>(producers, consumers, ops / producers);
+			std::printf("%-10zu %-10zu %16.2f %16.2f\n", producers, consumers, locked, lock_free);
+		}
+	}
+	return 0;
+}
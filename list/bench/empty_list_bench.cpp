@@ -0,0 +1,104 @@
+// Cost of empty my_lib::list objects (per-key buckets): object size, heap bytes, construct / move / swap time
+// g++ -std=c++17 -O2 -DNDEBUG -I.. empty_list_bench.cpp -o empty_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../list.hpp"
+
+namespace
+{
+	std::size_t heap_bytes;
+	std::size_t heap_blocks;
+
+	// std::allocator that counts what is live
+	template <class T>
+	struct counting_allocator
+	{
+		using value_type = T;
+
+		counting_allocator() noexcept = default;
+
+		template <class U>
+		counting_allocator(const counting_allocator<U>&) noexcept {}
+
+		T* allocate(std::size_t count)
+		{
+			heap_bytes += count * sizeof(T);
+			++heap_blocks;
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* ptr, std::size_t count) noexcept
+		{
+			heap_bytes -= count * sizeof(T);
+			--heap_blocks;
+			std::allocator<T>{}.deallocate(ptr, count);
+		}
+
+		template <class U>
+		bool operator==(const counting_allocator<U>&) const noexcept
+		{
+			return true;
+		}
+
+		template <class U>
+		bool operator!=(const counting_allocator<U>&) const noexcept
+		{
+			return false;
+		}
+	};
+
+	template <class F>
+	double ns_per_list(std::size_t count, F f)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / static_cast<double>(count);
+	}
+
+	template <class List>
+	void report(const char* name)
+	{
+		constexpr std::size_t count{ 1'000'000 };
+
+		std::vector<List> buckets;
+		buckets.reserve(count);
+		auto construct = ns_per_list(count, [&] {
+			for (std::size_t i{}; i < count; ++i) {
+				buckets.emplace_back();
+			}
+		});
+		auto bytes = heap_bytes;
+		auto blocks = heap_blocks;
+
+		std::vector<List> moved;
+		moved.reserve(count);
+		auto move = ns_per_list(count, [&] {
+			for (auto& bucket : buckets) {
+				moved.push_back(std::move(bucket));
+			}
+		});
+
+		auto swap = ns_per_list(count, [&] {
+			for (std::size_t i{}; i < count; ++i) {
+				buckets[i].swap(moved[i]);
+			}
+		});
+
+		std::printf("%-12s %8zu %12.1f %12.1f %12.2f %12.2f %12.2f\n", name, sizeof(List),
+			static_cast<double>(bytes) / count, static_cast<double>(blocks) / count, construct, move, swap);
+	}
+}
+
+int main()
+{
+	std::printf("%-12s %8s %12s %12s %12s %12s %12s\n", "list", "sizeof", "heap B/list", "allocs/list", "ctor ns", "move ns", "swap ns");
+	report<std::list<int, counting_allocator<int>>>("std::list");
+	report<my_lib::list<int, counting_allocator<int>>>("my_lib::list");
+	return 0;
+}
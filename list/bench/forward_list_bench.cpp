@@ -0,0 +1,135 @@
+// my_lib::forward_list vs my_lib::list vs std::forward_list with int32 values: heap bytes, push_front/pop_front and sort
+// g++ -std=c++17 -O2 -DNDEBUG -I.. forward_list_bench.cpp -o forward_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <memory>
+#include <random>
+#include "../list.hpp"
+#include "../forward_list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+	std::size_t heap_bytes;
+
+	// std::allocator that counts the live bytes (the malloc header of every block is not counted)
+	template <class T>
+	struct counting_allocator
+	{
+		using value_type = T;
+
+		counting_allocator() noexcept = default;
+
+		template <class U>
+		counting_allocator(const counting_allocator<U>&) noexcept {}
+
+		T* allocate(std::size_t count)
+		{
+			heap_bytes += count * sizeof(T);
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* ptr, std::size_t count) noexcept
+		{
+			heap_bytes -= count * sizeof(T);
+			std::allocator<T>{}.deallocate(ptr, count);
+		}
+
+		template <class U>
+		bool operator==(const counting_allocator<U>&) const noexcept
+		{
+			return true;
+		}
+
+		template <class U>
+		bool operator!=(const counting_allocator<U>&) const noexcept
+		{
+			return false;
+		}
+	};
+
+	template <class List>
+	double heap_per_element(std::size_t size)
+	{
+		auto before = heap_bytes;
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_front(static_cast<std::int32_t>(i));
+		}
+		return static_cast<double>(heap_bytes - before) / static_cast<double>(size);
+	}
+
+	// ns per push_front + pop_front pair, the list holds size elements between the rounds
+	template <class List>
+	double push_pop(std::size_t size)
+	{
+		constexpr std::size_t min_ops{ 20'000'000 };
+		auto rounds = min_ops / size + 1;
+
+		List list;
+		std::int64_t sum{};
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			for (std::size_t i{}; i < size; ++i) {
+				list.push_front(static_cast<std::int32_t>(i));
+			}
+			for (std::size_t i{}; i < size; ++i) {
+				sum += list.front();
+				list.pop_front();
+			}
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		sink = sum;
+		return elapsed.count() / static_cast<double>(size * rounds);
+	}
+
+	// ns per element of one sort() of random values
+	template <class List>
+	double sort(std::size_t size)
+	{
+		constexpr std::size_t min_elements{ 5'000'000 };
+		auto rounds = min_elements / size + 1;
+
+		std::mt19937 gen{ 7 };
+		double total{};
+		for (std::size_t r{}; r < rounds; ++r) {
+			List list;
+			for (std::size_t i{}; i < size; ++i) {
+				list.push_front(static_cast<std::int32_t>(gen()));
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			list.sort();
+			std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			total += elapsed.count();
+			sink = list.front();
+		}
+		return total / static_cast<double>(size * rounds);
+	}
+
+	template <class List>
+	void report(const char* name, std::size_t size)
+	{
+		std::printf("%-12zu %-20s %12.1f %12.2f %12.2f\n", size, name, heap_per_element<List>(size), push_pop<List>(size), sort<List>(size));
+	}
+}
+
+int main()
+{
+	using std_forward_list = std::forward_list<std::int32_t, counting_allocator<std::int32_t>>;
+	using my_list = my_lib::list<std::int32_t, counting_allocator<std::int32_t>>;
+	using my_forward_list = my_lib::forward_list<std::int32_t, counting_allocator<std::int32_t>>;
+	constexpr std::size_t sizes[]{ 100, 10'000, 1'000'000 };
+
+	std::printf("int32 values: heap bytes per element, ns per push_front + pop_front, ns per element of sort()\n");
+	std::printf("%-12s %-20s %12s %12s %12s\n", "elements", "list", "B/element", "push/pop", "sort");
+	for (auto size : sizes) {
+		report<std_forward_list>("std::forward_list", size);
+		report<my_list>("my_lib::list", size);
+		report<my_forward_list>("my_lib::forward_list", size);
+	}
+	return 0;
+}
@@ -0,0 +1,129 @@
+// index_list vs my_lib::list vs std::list with int32 values: heap bytes and full scans
+// g++ -std=c++17 -O2 -DNDEBUG -I.. index_list_bench.cpp -o index_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include "../list.hpp"
+#include "../index_list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+	std::size_t heap_bytes;
+
+	// std::allocator that counts the live bytes (the malloc header of every block is not counted)
+	template <class T>
+	struct counting_allocator
+	{
+		using value_type = T;
+
+		counting_allocator() noexcept = default;
+
+		template <class U>
+		counting_allocator(const counting_allocator<U>&) noexcept {}
+
+		T* allocate(std::size_t count)
+		{
+			heap_bytes += count * sizeof(T);
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* ptr, std::size_t count) noexcept
+		{
+			heap_bytes -= count * sizeof(T);
+			std::allocator<T>{}.deallocate(ptr, count);
+		}
+
+		template <class U>
+		bool operator==(const counting_allocator<U>&) const noexcept
+		{
+			return true;
+		}
+
+		template <class U>
+		bool operator!=(const counting_allocator<U>&) const noexcept
+		{
+			return false;
+		}
+	};
+
+	template <class List>
+	List make_list(std::size_t size, bool sorted)
+	{
+		std::mt19937 gen{ 7 };
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(gen() % 1000));
+		}
+		if (sorted) {
+			list.sort(); // the links now jump around the memory, like in a long lived list
+		}
+		return list;
+	}
+
+	// elements per nanosecond
+	template <class List>
+	double scan(const List& list)
+	{
+		constexpr std::size_t min_elements{ 50'000'000 };
+		auto rounds = min_elements / list.size() + 1;
+
+		std::int64_t sum{};
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			for (auto value : list) {
+				sum += value;
+			}
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		sink = sum;
+		return static_cast<double>(list.size() * rounds) / elapsed.count();
+	}
+
+	// built by push_back, the nodes lie in insertion order
+	template <class List>
+	void report_in_order(const char* name, std::size_t size)
+	{
+		auto before = heap_bytes;
+		auto list = make_list<List>(size, false);
+		auto bytes = static_cast<double>(heap_bytes - before) / static_cast<double>(size);
+		std::printf("%-12zu %-14s %12.1f %12.3f\n", size, name, bytes, scan(list));
+	}
+
+	template <class List>
+	void report_sorted(const char* name, std::size_t size)
+	{
+		auto list = make_list<List>(size, true);
+		std::printf("%-12zu %-14s %12.3f\n", size, name, scan(list));
+	}
+}
+
+int main()
+{
+	using std_list = std::list<std::int32_t, counting_allocator<std::int32_t>>;
+	using my_list = my_lib::list<std::int32_t, counting_allocator<std::int32_t>>;
+	using index_list = my_lib::index_list<std::int32_t, counting_allocator<std::int32_t>>;
+	constexpr std::size_t sizes[]{ 1'000, 100'000, 1'000'000, 10'000'000 };
+
+	// first, so no list gets the nodes a sorted list has freed in random order
+	std::printf("int32 values in insertion order: heap bytes per element, scan in elements per ns\n");
+	std::printf("%-12s %-14s %12s %12s\n", "elements", "list", "B/element", "scan");
+	for (auto size : sizes) {
+		report_in_order<std_list>("std::list", size);
+		report_in_order<my_list>("my_lib::list", size);
+		report_in_order<index_list>("index_list", size);
+	}
+
+	std::printf("\nafter sort(), scan in elements per ns\n");
+	std::printf("%-12s %-14s %12s\n", "elements", "list", "scan");
+	for (auto size : sizes) {
+		report_sorted<std_list>("std::list", size);
+		report_sorted<my_list>("my_lib::list", size);
+		report_sorted<index_list>("index_list", size);
+	}
+	return 0;
+}
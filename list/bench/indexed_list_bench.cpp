@@ -0,0 +1,145 @@
+// indexed_list vs my_lib::list: positional access, index of an iterator, range splice and push_back/pop_front
+// g++ -std=c++17 -O2 -DNDEBUG -I.. indexed_list_bench.cpp -o indexed_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../list.hpp"
+#include "../indexed_list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	double ns_since(clock_type::time_point start, std::size_t ops)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(ops);
+	}
+
+	template <class List>
+	List make_list(std::size_t size)
+	{
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(i));
+		}
+		return list;
+	}
+
+	std::vector<std::size_t> random_positions(std::size_t size, std::size_t count)
+	{
+		std::mt19937 gen{ 7 };
+		std::vector<std::size_t> positions(count);
+		for (auto& pos : positions) {
+			pos = gen() % size;
+		}
+		return positions;
+	}
+
+	// ns per element at a random position
+	template <class List>
+	double nth(const List& list, const std::vector<std::size_t>& positions)
+	{
+		std::int64_t sum{};
+		auto start = clock_type::now();
+		for (auto pos : positions) {
+			if constexpr (std::is_same_v<List, my_lib::list<std::int32_t>>) {
+				sum += *std::next(list.begin(), static_cast<std::ptrdiff_t>(pos));
+			}
+			else {
+				sum += *list.nth(pos);
+			}
+		}
+		auto ns = ns_since(start, positions.size());
+		sink = sum;
+		return ns;
+	}
+
+	// ns per index of an iterator at a random position
+	template <class List>
+	double index_of(const List& list, const std::vector<std::size_t>& positions)
+	{
+		std::vector<typename List::const_iterator> its;
+		for (auto pos : positions) {
+			its.push_back(std::next(list.begin(), static_cast<std::ptrdiff_t>(pos)));
+		}
+
+		std::int64_t sum{};
+		auto start = clock_type::now();
+		for (auto it : its) {
+			if constexpr (std::is_same_v<List, my_lib::list<std::int32_t>>) {
+				sum += std::distance(list.begin(), it);
+			}
+			else {
+				sum += static_cast<std::int64_t>(list.index_of(it));
+			}
+		}
+		auto ns = ns_since(start, its.size());
+		sink = sum;
+		return ns;
+	}
+
+	// ns per splice of the middle half to another list and back (the iterators are found before)
+	template <class List>
+	double splice_half(List& list)
+	{
+		constexpr std::size_t rounds{ 200 };
+		List other;
+		auto first = std::next(list.begin(), static_cast<std::ptrdiff_t>(list.size() / 4));
+		auto last = std::next(first, static_cast<std::ptrdiff_t>(list.size() / 2));
+
+		auto start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			other.splice(other.end(), list, first, last);
+			list.splice(last, other, other.begin(), other.end());
+		}
+		auto ns = ns_since(start, 2 * rounds);
+		sink = static_cast<std::int64_t>(list.size());
+		return ns;
+	}
+
+	// ns per push_back + pop_front pair on a list of size elements (a queue)
+	template <class List>
+	double push_pop(List& list)
+	{
+		constexpr std::size_t ops{ 2'000'000 };
+		auto start = clock_type::now();
+		for (std::size_t i{}; i < ops; ++i) {
+			list.push_back(static_cast<std::int32_t>(i));
+			list.pop_front();
+		}
+		auto ns = ns_since(start, ops);
+		sink = list.front();
+		return ns;
+	}
+
+	template <class List>
+	void report(const char* name, std::size_t size)
+	{
+		auto list = make_list<List>(size);
+		auto positions = random_positions(size, size < 100'000 ? 100'000 : 2'000);
+		std::printf("%-10zu %-14s %12.1f %12.1f %12.1f %12.1f\n", size, name, nth(list, positions), index_of(list, positions),
+			splice_half(list), push_pop(list));
+	}
+}
+
+int main()
+{
+	using my_list = my_lib::list<std::int32_t>;
+	using indexed_list = my_lib::indexed_list<std::int32_t>;
+	constexpr std::size_t sizes[]{ 1'000, 100'000, 1'000'000 };
+
+	std::printf("int32 values, ns per operation: nth(k), index_of(it), splice of half the list, push_back + pop_front\n");
+	std::printf("%-10s %-14s %12s %12s %12s %12s\n", "elements", "list", "nth", "index_of", "splice", "push/pop");
+	for (auto size : sizes) {
+		report<my_list>("my_lib::list", size);
+		report<indexed_list>("indexed_list", size);
+	}
+	return 0;
+}
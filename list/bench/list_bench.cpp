@@ -0,0 +1,309 @@
+// my_lib::list vs std::list over the whole interface, several value sizes and element counts.
+// Prints a table and writes the results as JSON (default list_bench.json) to track regressions.
+// g++ -std=c++17 -O2 -DNDEBUG -I.. list_bench.cpp -o list_bench   (or `make` in this directory)
+// ./list_bench [output.json] [--quick]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../list.hpp"
+
+namespace
+{
+	volatile std::uint64_t sink; // keeps the measured work alive
+
+	// a value of Bytes bytes ordered by key_
+	template <std::size_t Bytes>
+	struct blob
+	{
+		std::uint64_t key_;
+		unsigned char pad_[Bytes - sizeof(std::uint64_t)];
+
+		blob(std::uint64_t key = 0) noexcept : key_{ key }, pad_{} {}
+
+		bool operator<(const blob& rhs) const noexcept
+		{
+			return key_ < rhs.key_;
+		}
+
+		bool operator==(const blob& rhs) const noexcept
+		{
+			return key_ == rhs.key_;
+		}
+	};
+
+	std::uint64_t key_of(int value) noexcept
+	{
+		return static_cast<std::uint64_t>(value);
+	}
+
+	template <std::size_t Bytes>
+	std::uint64_t key_of(const blob<Bytes>& value) noexcept
+	{
+		return value.key_;
+	}
+
+	template <class List>
+	std::uint64_t checksum(const List& list) noexcept
+	{
+		return list.empty() ? 0 : list.size() ^ key_of(list.front()) ^ key_of(list.back());
+	}
+
+	template <class List>
+	struct tag
+	{
+		using type = List;
+	};
+
+	struct result
+	{
+		std::string op_;
+		std::string type_;
+		std::size_t type_size_;
+		std::size_t count_;
+		double std_ns_; // per element, best of the runs
+		double my_ns_;
+	};
+
+	// setup(tag<List>) makes the state, op(state) is timed. std and my_lib runs alternate, so both see the same heap
+	template <class StdList, class MyList, class Setup, class Op>
+	std::pair<double, double> measure(std::size_t count, Setup setup, Op op)
+	{
+		using clock = std::chrono::steady_clock;
+		const auto runs = std::clamp<std::size_t>(2'000'000 / count, 3, 100);
+
+		auto run = [&](auto list_tag) {
+			auto state = setup(list_tag);
+			auto start = clock::now();
+			op(state);
+			std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+			return elapsed.count() / static_cast<double>(count);
+		};
+
+		double std_best{ std::numeric_limits<double>::max() };
+		double my_best{ std::numeric_limits<double>::max() };
+		for (std::size_t i{}; i < runs; ++i) {
+			std_best = std::min(std_best, run(tag<StdList>{}));
+			my_best = std::min(my_best, run(tag<MyList>{}));
+		}
+		return { std_best, my_best };
+	}
+
+	template <class T>
+	void run_type(const char* type_name, std::size_t count, std::vector<result>& results)
+	{
+		using std_list = std::list<T>;
+		using my_list = my_lib::list<T>;
+
+		std::mt19937_64 gen{ 2021 };
+		std::vector<T> values(count);
+		for (auto& value : values) {
+			value = T(static_cast<int>(gen() >> 34)); // fits into int
+		}
+
+		auto sorted = values;
+		std::sort(sorted.begin(), sorted.end());
+
+		std::vector<T> pairs(count); // every value twice in a row, for unique
+		for (std::size_t i{}; i < count; ++i) {
+			pairs[i] = values[i / 2];
+		}
+
+		auto add = [&](const char* op, auto setup, auto run) {
+			auto [std_ns, my_ns] = measure<std_list, my_list>(count, setup, run);
+			results.push_back({ op, type_name, sizeof(T), count, std_ns, my_ns });
+			std::printf("%-14s %-10s %10zu %12.2f %12.2f %8.2f\n", op, type_name, count, std_ns, my_ns, std_ns / my_ns);
+		};
+
+		auto empty = [](auto list_tag) { return typename decltype(list_tag)::type{}; };
+		auto filled = [&](auto list_tag) { return typename decltype(list_tag)::type(values.begin(), values.end()); };
+		auto two_filled = [&](auto list_tag) {
+			using list = typename decltype(list_tag)::type;
+			return std::pair<list, list>{ list(values.begin(), values.end()), list(values.begin(), values.end()) };
+		};
+
+		add("push_back", empty, [&](auto& list) {
+			for (auto& value : values) {
+				list.push_back(value);
+			}
+			sink = checksum(list);
+		});
+
+		add("push_front", empty, [&](auto& list) {
+			for (auto& value : values) {
+				list.push_front(value);
+			}
+			sink = checksum(list);
+		});
+
+		add("emplace", empty, [&](auto& list) {
+			list.emplace_back(values.front());
+			auto pos = list.begin(); // every value goes before the first one, in the middle of the list
+			for (std::size_t i{ 1 }; i < count; ++i) {
+				list.emplace(pos, values[i]);
+			}
+			sink = checksum(list);
+		});
+
+		add("iterate", filled, [](auto& list) {
+			std::uint64_t sum{};
+			for (auto& value : list) {
+				sum += key_of(value);
+			}
+			sink = sum;
+		});
+
+		add("sort", filled, [](auto& list) {
+			list.sort();
+			sink = checksum(list);
+		});
+
+		add("merge", [&](auto list_tag) {
+			using list = typename decltype(list_tag)::type;
+			auto half = sorted.begin() + static_cast<std::ptrdiff_t>(count / 2);
+			std::vector<T> lhs(sorted.begin(), half);
+			std::vector<T> rhs(half, sorted.end());
+			// interleaved halves, so the merge has to switch sides all the time
+			for (std::size_t i{}; i < lhs.size() && i < rhs.size(); i += 2) {
+				std::swap(lhs[i], rhs[i]);
+			}
+			std::sort(lhs.begin(), lhs.end());
+			std::sort(rhs.begin(), rhs.end());
+			return std::pair<list, list>{ list(lhs.begin(), lhs.end()), list(rhs.begin(), rhs.end()) };
+		}, [](auto& lists) {
+			lists.first.merge(lists.second);
+			sink = checksum(lists.first);
+		});
+
+		add("splice", two_filled, [](auto& lists) {
+			auto& [to, from] = lists;
+			auto pos = to.begin();
+			while (!from.empty()) { // one element at a time
+				to.splice(pos, from, from.begin());
+			}
+			sink = checksum(to);
+		});
+
+		add("remove_if", filled, [](auto& list) {
+			list.remove_if([](const T& value) { return key_of(value) % 2 == 0; });
+			sink = checksum(list);
+		});
+
+		add("unique", [&](auto list_tag) {
+			return typename decltype(list_tag)::type(pairs.begin(), pairs.end());
+		}, [](auto& list) {
+			list.unique();
+			sink = checksum(list);
+		});
+
+		add("reverse", filled, [](auto& list) {
+			list.reverse();
+			sink = checksum(list);
+		});
+
+		add("copy_assign", two_filled, [](auto& lists) { // same size, nodes are reused
+			lists.first = lists.second;
+			sink = checksum(lists.first);
+		});
+
+		add("copy_construct", filled, [](auto& list) {
+			auto copy{ list };
+			sink = checksum(copy);
+		});
+
+		add("move_assign", two_filled, [](auto& lists) { // the old nodes are freed
+			lists.first = std::move(lists.second);
+			sink = checksum(lists.first);
+		});
+
+		add("assign", filled, [&](auto& list) { // same size, nodes are reused
+			list.assign(sorted.begin(), sorted.end());
+			sink = checksum(list);
+		});
+
+		add("clear", filled, [](auto& list) {
+			list.clear();
+			sink = checksum(list);
+		});
+	}
+
+	const char* compiler_name() noexcept
+	{
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc";
+#else
+		return "unknown";
+#endif
+	}
+
+	bool write_json(const char* path, const std::vector<result>& results)
+	{
+		auto file = std::fopen(path, "w");
+		if (!file) {
+			return false;
+		}
+
+		std::fprintf(file, "{\n  \"compiler\": \"%s\",\n", compiler_name());
+#ifdef NDEBUG
+		std::fprintf(file, "  \"ndebug\": true,\n");
+#else
+		std::fprintf(file, "  \"ndebug\": false,\n");
+#endif
+		std::fprintf(file, "  \"unit\": \"ns per element\",\n  \"results\": [\n");
+		for (std::size_t i{}; i < results.size(); ++i) {
+			auto& r = results[i];
+			std::fprintf(file, "    { \"op\": \"%s\", \"type\": \"%s\", \"type_size\": %zu, \"count\": %zu, "
+				"\"std_list\": %.3f, \"my_lib_list\": %.3f, \"speedup\": %.3f }%s\n",
+				r.op_.c_str(), r.type_.c_str(), r.type_size_, r.count_, r.std_ns_, r.my_ns_, r.std_ns_ / r.my_ns_,
+				i + 1 == results.size() ? "" : ",");
+		}
+		std::fprintf(file, "  ]\n}\n");
+		return std::fclose(file) == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* output = "list_bench.json";
+	bool quick{};
+	for (int i{ 1 }; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--quick") == 0) {
+			quick = true;
+		}
+		else {
+			output = argv[i];
+		}
+	}
+
+	std::vector<std::size_t> counts{ 1'000, 100'000, 1'000'000 };
+	if (quick) {
+		counts = { 1'000, 50'000 };
+	}
+
+	std::vector<result> results;
+	std::printf("%-14s %-10s %10s %12s %12s %8s\n", "op", "type", "elements", "std ns/elem", "my_lib ns/elem", "speedup");
+	for (auto count : counts) {
+		run_type<int>("int", count, results);
+		run_type<blob<32>>("blob32", count, results);
+		run_type<blob<128>>("blob128", count, results);
+	}
+
+	if (!write_json(output, results)) {
+		std::fprintf(stderr, "cannot write %s\n", output);
+		return 1;
+	}
+	std::printf("results written to %s\n", output);
+	return 0;
+}
@@ -0,0 +1,78 @@
+// node_pool vs std::allocator on my_lib::list
+// g++ -std=c++17 -O2 -DNDEBUG -I.. node_pool_bench.cpp -o node_pool_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include "../list.hpp"
+#include "../node_pool.hpp"
+
+namespace
+{
+	volatile long long sink; // keeps the measured loops alive
+
+	template <class F>
+	double ns_per_op(std::size_t ops, F f)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / static_cast<double>(ops);
+	}
+
+	// queue of `depth` elements, every op is one push_back and one pop_front
+	template <class List>
+	double churn(std::size_t depth, std::size_t ops)
+	{
+		List list;
+		for (std::size_t i{}; i < depth; ++i) {
+			list.push_back(static_cast<int>(i));
+		}
+
+		long long sum{};
+		auto result = ns_per_op(ops, [&] {
+			for (std::size_t i{}; i < ops; ++i) {
+				list.push_back(static_cast<int>(i));
+				sum += list.front();
+				list.pop_front();
+			}
+		});
+		sink = sum;
+		return result;
+	}
+
+	// build `size` elements and destroy them, `rounds` times
+	template <class List>
+	double fill_clear(std::size_t size, std::size_t rounds)
+	{
+		return ns_per_op(size * rounds, [&] {
+			for (std::size_t r{}; r < rounds; ++r) {
+				List list;
+				for (std::size_t i{}; i < size; ++i) {
+					list.emplace_back(static_cast<int>(i));
+				}
+			}
+		});
+	}
+}
+
+int main()
+{
+	using plain_list = my_lib::list<int>;
+	using pool_list = my_lib::list<int, my_lib::node_pool<int>>;
+
+	std::printf("%-24s %14s %14s\n", "benchmark (ns/op)", "std::allocator", "node_pool");
+	for (std::size_t depth : { 16, 1024, 65536 }) {
+		constexpr std::size_t ops{ 4'000'000 };
+		auto plain = churn<plain_list>(depth, ops);
+		auto pool = churn<pool_list>(depth, ops);
+		std::printf("churn depth=%-12zu %14.2f %14.2f\n", depth, plain, pool);
+	}
+
+	for (std::size_t size : { 100, 10'000, 1'000'000 }) {
+		auto rounds = 4'000'000 / size;
+		auto plain = fill_clear<plain_list>(size, rounds);
+		auto pool = fill_clear<pool_list>(size, rounds);
+		std::printf("fill+destroy size=%-7zu %14.2f %14.2f\n", size, plain, pool);
+	}
+	return 0;
+}
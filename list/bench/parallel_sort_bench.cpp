@@ -0,0 +1,55 @@
+// my_lib::sort(policy, list, pred) scaling over thread counts
+// g++ -std=c++17 -O2 -DNDEBUG -pthread -I.. parallel_sort_bench.cpp -o parallel_sort_bench   (+ -ltbb when libstdc++ finds TBB)
+// ./parallel_sort_bench [max threads]
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../list.hpp"
+#include "../parallel.hpp"
+#include "../node_pool.hpp"
+
+namespace
+{
+	template <class Sort>
+	double sort_ms(const std::vector<int>& values, Sort sort)
+	{
+		// every list gets its own pool, so all runs see the same node layout
+		my_lib::list<int, my_lib::node_pool<int>> list(values.begin(), values.end());
+
+		auto start = std::chrono::steady_clock::now();
+		sort(list);
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+	if (max_threads == 0) {
+		max_threads = 1;
+	}
+
+	std::mt19937 gen{ 2021 };
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	std::printf("%-12s %-10s %12s %10s\n", "elements", "threads", "ms", "speedup");
+	for (std::size_t size : { 1'000'000, 10'000'000 }) {
+		std::vector<int> values(size);
+		for (auto& value : values) {
+			value = static_cast<int>(gen());
+		}
+
+		auto serial = sort_ms(values, [](auto& list) { list.sort(); });
+		std::printf("%-12zu %-10s %12.2f %10.2f\n", size, "sort()", serial, 1.0);
+
+		for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2) {
+			auto parallel = sort_ms(values, [threads](auto& list) { my_lib::sort(my_lib::execution::par(threads), list); });
+			std::printf("%-12zu %-10zu %12.2f %10.2f\n", size, threads, parallel, serial / parallel);
+		}
+	}
+	return 0;
+}
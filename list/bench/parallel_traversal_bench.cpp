@@ -0,0 +1,126 @@
+// my_lib::count_if / transform_reduce (policy, list, ...) over thread counts on a scattered list, and the break-even list size
+// g++ -std=c++17 -O2 -DNDEBUG -pthread -I.. parallel_traversal_bench.cpp -o parallel_traversal_bench   (+ -ltbb when libstdc++ finds TBB)
+// ./parallel_traversal_bench [max threads]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <thread>
+#include "../list.hpp"
+#include "../parallel.hpp"
+
+namespace
+{
+	volatile double sink; // keeps the measured calls alive
+
+	using clock_type = std::chrono::steady_clock;
+	using list_type = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+
+	// sorted by random values, so list order jumps around the heap
+	list_type make_scattered(std::size_t size)
+	{
+		std::mt19937 gen{ 2021 };
+		list_type list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(gen() >> 1));
+		}
+		list.sort();
+		return list;
+	}
+
+	// best of a few runs, in microseconds
+	template <class Scan>
+	double best_us(Scan scan)
+	{
+		double best{ 1e300 };
+		for (int run{}; run < 5; ++run) {
+			auto start = clock_type::now();
+			sink = static_cast<double>(scan());
+			std::chrono::duration<double, std::micro> elapsed = clock_type::now() - start;
+			best = std::min(best, elapsed.count());
+		}
+		return best;
+	}
+
+	bool cheap(std::int32_t value)
+	{
+		return (value & 7) == 0;
+	}
+
+	// about 50 ns of arithmetic per element
+	double costly(std::int32_t value)
+	{
+		double x{ static_cast<double>(value & 1023) };
+		for (int i{}; i < 8; ++i) {
+			x = std::sqrt(x + 1.0) * 1.5;
+		}
+		return x;
+	}
+
+	// serial (transform_reduce on one thread is both ends on the calling one, like count_if), then per thread count:
+	// cut + scan (what the calls without segments do) and the scan alone with segments cut beforehand
+	void scaling(const char* name, const list_type& list, std::size_t max_threads, bool heavy)
+	{
+		auto serial = heavy
+			? best_us([&] { return my_lib::transform_reduce(my_lib::execution::par(1), list, 0.0, std::plus<>{}, &costly); })
+			: best_us([&] { return list.count_if(&cheap); });
+		std::printf("%-24s %-8s %12.0f %12s %10.2f %10s\n", name, "serial", serial, "", 1.0, "");
+
+		for (std::size_t threads{ 1 }; threads <= max_threads; threads *= 2) {
+			auto policy = my_lib::execution::par(threads);
+			my_lib::list_segments segments{ list, threads };
+			double cut_and_scan{};
+			double scan{};
+			if (heavy) {
+				cut_and_scan = best_us([&] {
+					return my_lib::transform_reduce(policy, list, my_lib::list_segments{ list, threads }, 0.0, std::plus<>{}, &costly);
+				});
+				scan = best_us([&] { return my_lib::transform_reduce(policy, list, segments, 0.0, std::plus<>{}, &costly); });
+			}
+			else {
+				cut_and_scan = best_us([&] { return my_lib::count_if(policy, list, my_lib::list_segments{ list, threads }, &cheap); });
+				scan = best_us([&] { return my_lib::count_if(policy, list, segments, &cheap); });
+			}
+			std::printf("%-24s %-8zu %12.0f %12.0f %10.2f %10.2f\n", name, threads, cut_and_scan, scan,
+				serial / cut_and_scan, serial / scan);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+	if (max_threads == 0) {
+		max_threads = 1;
+	}
+
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	std::printf("%-24s %-8s %12s %12s %10s %10s\n", "us", "threads", "cut + scan", "scan", "speedup", "speedup");
+	for (std::size_t size : { 1'000'000, 4'000'000 }) {
+		auto list = make_scattered(size);
+		char name[64];
+		std::snprintf(name, sizeof(name), "count_if %zuM", size / 1'000'000);
+		scaling(name, list, max_threads, false);
+		std::snprintf(name, sizeof(name), "transform_reduce %zuM", size / 1'000'000);
+		scaling(name, list, max_threads, true);
+	}
+
+	// smallest lists where the parallel scan with segments cut beforehand beats the serial one
+	std::printf("\nbreak-even, %zu threads, segments cut beforehand\n", max_threads);
+	std::printf("%-10s %14s %14s %14s %14s\n", "elements", "count_if", "par", "reduce", "par");
+	auto policy = my_lib::execution::par(max_threads);
+	for (std::size_t size : { 1'000, 4'000, 16'000, 64'000, 256'000 }) {
+		auto list = make_scattered(size);
+		my_lib::list_segments segments{ list, max_threads };
+		std::printf("%-10zu %14.1f %14.1f %14.1f %14.1f\n", size,
+			best_us([&] { return list.count_if(&cheap); }),
+			best_us([&] { return my_lib::count_if(policy, list, segments, &cheap); }),
+			best_us([&] { return my_lib::transform_reduce(my_lib::execution::par(1), list, 0.0, std::plus<>{}, &costly); }),
+			best_us([&] { return my_lib::transform_reduce(policy, list, segments, 0.0, std::plus<>{}, &costly); }));
+	}
+	return 0;
+}
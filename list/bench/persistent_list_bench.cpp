@@ -0,0 +1,93 @@
+// Startup of a big list: built from scratch with std::allocator vs reopened from a mapped_arena file
+// g++ -std=c++17 -O2 -DNDEBUG -I.. persistent_list_bench.cpp -o persistent_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include "../list.hpp"
+#include "../mapped_arena.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+	using std_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	using arena_allocator = my_lib::mapped_arena_allocator<std::int32_t>;
+	using arena_list = my_lib::list<std::int32_t, arena_allocator, my_lib::unchecked_iterators>;
+
+	double ms_since(clock_type::time_point start)
+	{
+		std::chrono::duration<double, std::milli> elapsed = clock_type::now() - start;
+		return elapsed.count();
+	}
+
+	template <class List>
+	void fill(List& list, std::size_t size)
+	{
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(i));
+		}
+	}
+
+	template <class List>
+	std::int64_t sum(const List& list)
+	{
+		std::int64_t result{};
+		for (auto value : list) {
+			result += value;
+		}
+		return result;
+	}
+
+	void report(std::size_t size, const std::string& path)
+	{
+		// the usual startup: every element allocated and constructed again
+		auto start = clock_type::now();
+		{
+			std_list list;
+			fill(list, size);
+			auto build = ms_since(start);
+			start = clock_type::now();
+			sink = sum(list);
+			std::printf("%-10zu %-22s %12.1f %12.1f\n", size, "std::allocator, build", build, ms_since(start));
+		}
+
+		// the first run makes the file
+		std::filesystem::remove(path);
+		start = clock_type::now();
+		{
+			my_lib::mapped_arena arena{ path, 4096 + size * sizeof(my_lib::list_node<std::int32_t, my_lib::offset_ptr<void>>) * 2 };
+			auto& list = arena.find_or_construct<arena_list>(arena_allocator{ arena });
+			fill(list, size);
+		}
+		std::printf("%-10zu %-22s %12.1f %12s\n", size, "arena, build and close", ms_since(start), "");
+
+		// every run after that only maps it (the pages come from the page cache on the first walk)
+		start = clock_type::now();
+		{
+			my_lib::mapped_arena arena{ path, 0 };
+			auto& list = arena.find_or_construct<arena_list>(arena_allocator{ arena });
+			auto open = ms_since(start);
+			start = clock_type::now();
+			sink = sum(list);
+			std::printf("%-10zu %-22s %12.3f %12.1f\n", size, "arena, reopen", open, ms_since(start));
+		}
+		std::filesystem::remove(path);
+	}
+}
+
+int main()
+{
+	constexpr std::size_t sizes[]{ 1'000'000, 10'000'000 };
+	auto path = (std::filesystem::temp_directory_path() / "persistent_list_bench.arena").string();
+
+	std::printf("int32 values, ms to get the list ready and ms of the first full walk\n");
+	std::printf("%-10s %-22s %12s %12s\n", "elements", "startup", "ready", "first walk");
+	for (auto size : sizes) {
+		report(size, path);
+	}
+	return 0;
+}
@@ -0,0 +1,92 @@
+// count / min_element over a list of arithmetic values: std algorithms on iterators vs the list members, nodes in order and scattered
+// g++ -std=c++17 -O2 -DNDEBUG -I.. search_bench.cpp -o search_bench
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include "../list.hpp"
+
+namespace
+{
+	volatile double sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	double ns_per_element(clock_type::time_point start, std::size_t elements)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(elements);
+	}
+
+	// values 0..3, so count(1) matches a random quarter: a branch on the match is mispredicted often
+	template <class List>
+	List make_list(std::size_t size, bool scattered)
+	{
+		std::mt19937 gen{ 7 };
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<typename List::value_type>(gen()));
+		}
+		if (scattered) {
+			list.sort(); // relinks the nodes in value order, far from the allocation order
+		}
+		for (auto& value : list) {
+			value = static_cast<typename List::value_type>(gen() % 4);
+		}
+		return list;
+	}
+
+	template <class T>
+	void report(const char* name, std::size_t size, bool scattered)
+	{
+		using list_type = my_lib::list<T, std::allocator<T>, my_lib::unchecked_iterators>;
+		const auto list = make_list<list_type>(size, scattered);
+		const auto rounds = 20'000'000 / size + 1;
+		double sum{};
+
+		auto start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			sum += static_cast<double>(std::count(list.begin(), list.end(), T{ 1 }));
+		}
+		auto std_count = ns_per_element(start, size * rounds);
+
+		start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			sum += static_cast<double>(list.count(T{ 1 }));
+		}
+		auto count = ns_per_element(start, size * rounds);
+
+		start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			sum += static_cast<double>(*std::min_element(list.begin(), list.end()));
+		}
+		auto std_min = ns_per_element(start, size * rounds);
+
+		start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			sum += static_cast<double>(*list.min_element());
+		}
+		auto min = ns_per_element(start, size * rounds);
+
+		sink = sum;
+		std::printf("%-10zu %-6s %-10s %12.2f %12.2f %12.2f %12.2f\n", size, name, scattered ? "scattered" : "in order",
+			std_count, count, std_min, min);
+	}
+}
+
+int main()
+{
+	constexpr std::size_t sizes[]{ 10'000, 1'000'000 };
+
+	std::printf("ns per element, values 0..3\n");
+	std::printf("%-10s %-6s %-10s %12s %12s %12s %12s\n", "elements", "T", "nodes", "std::count", "count", "std::min_el", "min_element");
+	for (auto size : sizes) {
+		for (auto scattered : { false, true }) {
+			report<std::int32_t>("int32", size, scattered);
+			report<float>("float", size, scattered);
+		}
+	}
+	return 0;
+}
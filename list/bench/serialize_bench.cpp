@@ -0,0 +1,184 @@
+// serialize / deserialize vs element by element I/O (write each value, read each value and push_back), GB/s of values
+// g++ -std=c++17 -O2 -DNDEBUG -I.. serialize_bench.cpp -o serialize_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <vector>
+#include "../list.hpp"
+#include "../node_pool.hpp"
+#include "../serialize.hpp"
+
+namespace
+{
+	volatile std::size_t sink_size; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	// in memory, to see the cost of the format and of building the list without the disk
+	struct memory_stream
+	{
+		std::vector<char> bytes_;
+		std::size_t read_{};
+		bool good_{ true };
+
+		void write(const char* data, std::streamsize count)
+		{
+			bytes_.insert(bytes_.end(), data, data + count);
+		}
+
+		void read(char* data, std::streamsize count)
+		{
+			auto size = static_cast<std::size_t>(count);
+			if (bytes_.size() - read_ < size) {
+				good_ = false;
+				return;
+			}
+			std::memcpy(data, bytes_.data() + read_, size);
+			read_ += size;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return good_;
+		}
+	};
+
+	double gb_per_s(clock_type::time_point start, std::size_t bytes)
+	{
+		std::chrono::duration<double> elapsed = clock_type::now() - start;
+		return static_cast<double>(bytes) / elapsed.count() / 1e9;
+	}
+
+	// best of a few runs of measure(results), the page cache and the heap make single runs noisy
+	template <class Measure>
+	void best_of(double (&results)[4], Measure measure)
+	{
+		for (int run{}; run < 3; ++run) {
+			double now[4]{};
+			measure(now);
+			for (int i{}; i < 4; ++i) {
+				results[i] = results[i] < now[i] ? now[i] : results[i];
+			}
+		}
+	}
+
+	template <class List>
+	void naive_write(const List& list, memory_stream& out)
+	{
+		std::uint64_t count{ list.size() };
+		out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		for (const auto& value : list) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+	}
+
+	template <class List>
+	void naive_write(const List& list, std::ofstream& out)
+	{
+		std::uint64_t count{ list.size() };
+		out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		for (const auto& value : list) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+	}
+
+	template <class List, class Source>
+	List naive_read(Source& in)
+	{
+		List list;
+		std::uint64_t count{};
+		in.read(reinterpret_cast<char*>(&count), sizeof(count));
+		for (std::uint64_t i{}; i < count; ++i) {
+			typename List::value_type value{};
+			in.read(reinterpret_cast<char*>(&value), sizeof(value));
+			list.push_back(value);
+		}
+		return list;
+	}
+
+	// write and read through memory, then through a file. GB/s of value bytes
+	template <class List>
+	void report(const char* name, std::size_t size, const std::string& path)
+	{
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<typename List::value_type>(i));
+		}
+		auto bytes = size * sizeof(typename List::value_type);
+
+		double memory[4]{};
+		best_of(memory, [&](double (&result)[4]) {
+			memory_stream out;
+			out.bytes_.reserve(bytes * 2);
+			auto start = clock_type::now();
+			naive_write(list, out);
+			result[0] = gb_per_s(start, bytes);
+			start = clock_type::now();
+			sink_size = naive_read<List>(out).size();
+			result[1] = gb_per_s(start, bytes);
+
+			memory_stream fast;
+			fast.bytes_.reserve(bytes * 2);
+			start = clock_type::now();
+			my_lib::serialize(list, fast);
+			result[2] = gb_per_s(start, bytes);
+			start = clock_type::now();
+			sink_size = my_lib::deserialize<List>(fast).size();
+			result[3] = gb_per_s(start, bytes);
+		});
+
+		double file[4]{};
+		best_of(file, [&](double (&result)[4]) {
+			// removed and opened outside the clock: truncating an old file costs milliseconds of its own
+			std::filesystem::remove(path);
+			std::ofstream out{ path, std::ios::binary };
+			auto start = clock_type::now();
+			naive_write(list, out);
+			out.close();
+			result[0] = gb_per_s(start, bytes);
+			std::ifstream in{ path, std::ios::binary };
+			start = clock_type::now();
+			sink_size = naive_read<List>(in).size();
+			result[1] = gb_per_s(start, bytes);
+
+			std::filesystem::remove(path);
+			std::ofstream fast_out{ path, std::ios::binary };
+			start = clock_type::now();
+			my_lib::serialize(list, fast_out);
+			fast_out.close();
+			result[2] = gb_per_s(start, bytes);
+			std::ifstream fast_in{ path, std::ios::binary };
+			start = clock_type::now();
+			sink_size = my_lib::deserialize<List>(fast_in).size();
+			result[3] = gb_per_s(start, bytes);
+		});
+		std::filesystem::remove(path);
+
+		std::printf("%-10zu %-16s %-7s %9.2f %9.2f %9.2f %9.2f\n", size, name, "memory", memory[0], memory[2], memory[1], memory[3]);
+		std::printf("%-10zu %-16s %-7s %9.2f %9.2f %9.2f %9.2f\n", size, name, "file", file[0], file[2], file[1], file[3]);
+	}
+}
+
+int main()
+{
+	using int_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	using pool_list = my_lib::list<std::int32_t, my_lib::node_pool<std::int32_t>, my_lib::unchecked_iterators>;
+	using double_list = my_lib::list<double, std::allocator<double>, my_lib::unchecked_iterators>;
+	constexpr std::size_t sizes[]{ 1'000'000, 10'000'000 };
+	auto path = (std::filesystem::temp_directory_path() / "serialize_bench.bin").string();
+
+	std::printf("GB/s of values, element by element (naive) vs serialize / deserialize\n");
+	std::printf("%-10s %-16s %-7s %9s %9s %9s %9s\n", "elements", "list", "stream", "naive w", "serialize", "naive r", "deserial.");
+	for (auto size : sizes) {
+		report<int_list>("int32", size, path);
+		report<pool_list>("int32 node_pool", size, path);
+		report<double_list>("double", size, path);
+	}
+	return 0;
+}
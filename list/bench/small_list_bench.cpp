@@ -0,0 +1,94 @@
+// list vs small_list<T, 4> for lists of 0..8 elements: build + destroy one list, and walks over 100k lists filled in order and shuffled
+// g++ -std=c++17 -O2 -DNDEBUG -I.. small_list_bench.cpp -o small_list_bench
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../list.hpp"
+#include "../small_list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+	using std_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	using small = my_lib::small_list<std::int32_t, 4, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+
+	double ns_per(clock_type::time_point start, std::size_t count)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(count);
+	}
+
+	// a list of size elements made, summed and destroyed
+	template <class List>
+	double build(std::size_t size, std::size_t rounds)
+	{
+		std::int64_t sum{};
+		auto start = clock_type::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			List list;
+			for (std::size_t i{}; i < size; ++i) {
+				list.push_back(static_cast<std::int32_t>(r + i));
+			}
+			sum += list.back();
+		}
+		auto result = ns_per(start, rounds);
+		sink = sum;
+		return result;
+	}
+
+	// every list gets an element in turn, then every list is walked. In order the heap nodes of neighbour lists
+	// are neighbours in memory (one stream for the prefetcher), shuffled the lists grow in random order
+	// like lists filled at different times
+	template <class List>
+	double walk(std::size_t size, std::size_t lists, bool shuffled)
+	{
+		std::vector<List> all(lists);
+		std::vector<std::size_t> order(lists);
+		std::iota(order.begin(), order.end(), std::size_t{});
+		std::mt19937 gen{ 7 };
+		for (std::size_t i{}; i < size; ++i) {
+			if (shuffled) {
+				std::shuffle(order.begin(), order.end(), gen);
+			}
+			for (auto index : order) {
+				all[index].push_back(static_cast<std::int32_t>(i));
+			}
+		}
+
+		std::int64_t sum{};
+		auto start = clock_type::now();
+		for (int round{}; round < 10; ++round) {
+			for (const auto& list : all) {
+				for (auto value : list) {
+					sum += value;
+				}
+			}
+		}
+		auto result = ns_per(start, lists * 10);
+		sink = sum;
+		return result;
+	}
+}
+
+int main()
+{
+	constexpr std::size_t rounds{ 2'000'000 };
+	constexpr std::size_t lists{ 100'000 };
+
+	std::printf("sizeof: list %zu, small_list<int32, 4> %zu bytes\n", sizeof(std_list), sizeof(small));
+	std::printf("ns per list\n");
+	std::printf("%-9s %12s %12s %12s %12s %14s %14s\n", "elements", "build list", "build small",
+		"walk list", "walk small", "shuffled list", "shuffled small");
+	for (std::size_t size : { 0, 1, 2, 4, 5, 8 }) {
+		std::printf("%-9zu %12.1f %12.1f %12.1f %12.1f %14.1f %14.1f\n", size, build<std_list>(size, rounds), build<small>(size, rounds),
+			walk<std_list>(size, lists, false), walk<small>(size, lists, false), walk<std_list>(size, lists, true), walk<small>(size, lists, true));
+	}
+	return 0;
+}
@@ -0,0 +1,46 @@
+// my_lib::list::sort vs std::list::sort on random ints
+// g++ -std=c++17 -O2 -DNDEBUG -I.. sort_bench.cpp -o sort_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <vector>
+#include "../list.hpp"
+
+namespace
+{
+	template <class List>
+	double sort_ms(List& list)
+	{
+		auto start = std::chrono::steady_clock::now();
+		list.sort();
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count();
+	}
+}
+
+int main()
+{
+	std::mt19937 gen{ 2021 };
+	std::printf("%-12s %14s %14s %8s\n", "elements", "std::list ms", "my_lib ms", "ratio");
+	for (std::size_t size : { 10'000, 100'000, 1'000'000, 10'000'000 }) {
+		std::vector<int> values(size);
+		for (auto& value : values) {
+			value = static_cast<int>(gen());
+		}
+
+		// both lists are filled together, so their nodes are spread over the heap the same way
+		std::list<int> std_list;
+		my_lib::list<int> my_list;
+		for (auto value : values) {
+			std_list.push_back(value);
+			my_list.push_back(value);
+		}
+
+		auto std_ms = sort_ms(std_list);
+		auto my_ms = sort_ms(my_list);
+		std::printf("%-12zu %14.2f %14.2f %8.2f\n", size, std_ms, my_ms, std_ms / my_ms);
+	}
+	return 0;
+}
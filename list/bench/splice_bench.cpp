@@ -0,0 +1,60 @@
+// Range splice between two lists: counted by splice, count given by the caller, lazy_size
+// g++ -std=c++17 -O2 -DNDEBUG -I.. splice_bench.cpp -o splice_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "../list.hpp"
+
+namespace
+{
+	volatile std::size_t sink; // keeps the measured loops alive
+
+	using eager_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	using lazy_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators, my_lib::lazy_size>;
+
+	enum class mode { counted, given_count, lazy };
+
+	// ns per splice of the back half of a list to another list (and back), like a worker handing over a segment
+	template <class List>
+	double move_half(std::size_t size, mode how)
+	{
+		constexpr std::size_t rounds{ 2'000 };
+		List from;
+		List to;
+		for (std::size_t i{}; i < size; ++i) {
+			from.push_back(static_cast<std::int32_t>(i));
+		}
+		auto half = size / 2;
+		auto first = std::next(from.begin(), static_cast<std::ptrdiff_t>(size - half)); // the caller keeps its segment starts
+
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			if (how == mode::given_count) {
+				to.splice(to.end(), from, first, from.end(), half);
+				from.splice(from.end(), to, to.begin(), to.end(), half);
+			}
+			else {
+				to.splice(to.end(), from, first, from.end());
+				from.splice(from.end(), to, to.begin(), to.end());
+			}
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		sink = from.size(); // a lazy list counts here, once
+		return elapsed.count() / static_cast<double>(2 * rounds);
+	}
+}
+
+int main()
+{
+	constexpr std::size_t sizes[]{ 100, 10'000, 1'000'000 };
+
+	std::printf("ns per splice of half a list to another list\n");
+	std::printf("%-10s %16s %16s %16s\n", "elements", "eager, counted", "eager, count", "lazy_size");
+	for (auto size : sizes) {
+		std::printf("%-10zu %16.1f %16.1f %16.1f\n", size, move_half<eager_list>(size, mode::counted),
+			move_half<eager_list>(size, mode::given_count), move_half<lazy_list>(size, mode::lazy));
+	}
+	return 0;
+}
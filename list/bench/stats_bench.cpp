@@ -0,0 +1,120 @@
+// Cost of the collect_stats policy: ns per operation with no_stats and with collect_stats, on operations that count once per call
+// g++ -std=c++17 -O2 -DNDEBUG -I.. stats_bench.cpp -o stats_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include "../list_stats.hpp"
+
+namespace
+{
+	volatile std::size_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	template <class Stats>
+	using list_type = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators, my_lib::eager_size, Stats>;
+
+	double ns_per_op(clock_type::time_point start, std::size_t ops)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(ops);
+	}
+
+	template <class List>
+	List make_list(std::size_t size)
+	{
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(i));
+		}
+		return list;
+	}
+
+	// push_back + pop_front: one allocation and one free counted per op
+	template <class Stats>
+	double churn(std::size_t ops)
+	{
+		auto list = make_list<list_type<Stats>>(64);
+		auto start = clock_type::now();
+		for (std::size_t i{}; i < ops; ++i) {
+			list.push_back(static_cast<std::int32_t>(i));
+			list.pop_front();
+		}
+		auto result = ns_per_op(start, ops);
+		sink = list.size();
+		return result;
+	}
+
+	// find on a short list: one traversal counted per call, the list is 16 elements
+	template <class Stats>
+	double find(std::size_t ops)
+	{
+		const auto list = make_list<list_type<Stats>>(16);
+		std::size_t found{};
+		auto start = clock_type::now();
+		for (std::size_t i{}; i < ops; ++i) {
+			found += list.find(static_cast<std::int32_t>(i & 15)) != list.end();
+		}
+		auto result = ns_per_op(start, ops);
+		sink = found;
+		return result;
+	}
+
+	// one element back and forth between two lists: one splice counted per op
+	template <class Stats>
+	double splice(std::size_t ops)
+	{
+		auto lhs = make_list<list_type<Stats>>(64);
+		auto rhs = make_list<list_type<Stats>>(64);
+		auto start = clock_type::now();
+		for (std::size_t i{}; i < ops; ++i) {
+			if (i & 1) lhs.splice(lhs.end(), rhs, rhs.begin());
+			else rhs.splice(rhs.end(), lhs, lhs.begin());
+		}
+		auto result = ns_per_op(start, ops);
+		sink = lhs.size() + rhs.size();
+		return result;
+	}
+
+	// sort of 32 elements: two clock reads per call
+	template <class Stats>
+	double sort(std::size_t ops)
+	{
+		auto list = make_list<list_type<Stats>>(32);
+		auto start = clock_type::now();
+		for (std::size_t i{}; i < ops; ++i) {
+			list.sort([i](std::int32_t lhs, std::int32_t rhs) { return (i & 1) ? lhs < rhs : rhs < lhs; });
+		}
+		auto result = ns_per_op(start, ops);
+		sink = list.size();
+		return result;
+	}
+
+	template <class Measure>
+	void report(const char* name, Measure measure_without, Measure measure_with, std::size_t ops)
+	{
+		auto without = measure_without(ops);
+		auto with = measure_with(ops);
+		std::printf("%-26s %12.2f %14.2f %8.2fx\n", name, without, with, with / without);
+	}
+}
+
+int main()
+{
+	constexpr std::size_t ops{ 5'000'000 };
+
+	std::printf("sizeof(list): no_stats %zu, collect_stats %zu bytes\n",
+		sizeof(list_type<my_lib::no_stats>), sizeof(list_type<my_lib::collect_stats>));
+	std::printf("%-26s %12s %14s %9s\n", "ns per op", "no_stats", "collect_stats", "ratio");
+	report("push_back + pop_front", &churn<my_lib::no_stats>, &churn<my_lib::collect_stats>, ops);
+	report("find, 16 elements", &find<my_lib::no_stats>, &find<my_lib::collect_stats>, ops);
+	report("splice one element", &splice<my_lib::no_stats>, &splice<my_lib::collect_stats>, ops);
+	report("sort, 32 elements", &sort<my_lib::no_stats>, &sort<my_lib::collect_stats>, ops / 10);
+
+	auto list = make_list<list_type<my_lib::collect_stats>>(1000);
+	list.remove_if([](std::int32_t value) { return value % 3 == 0; });
+	list.sort();
+	std::printf("\nstats() after 1000 push_back, remove_if and sort:\n%s\n", list.stats().to_json().c_str());
+	return 0;
+}
@@ -0,0 +1,108 @@
+// Walks over a list whose nodes are scattered in memory: std::list (one serial pointer chase) vs my_lib::list (prefetching kernels)
+// g++ -std=c++17 -O2 -DNDEBUG -I.. traversal_bench.cpp -o traversal_bench
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <optional>
+#include <random>
+#include "../list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	using clock_type = std::chrono::steady_clock;
+
+	double ns_per_element(clock_type::time_point start, std::size_t size)
+	{
+		std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+		return elapsed.count() / static_cast<double>(size);
+	}
+
+	// random values, then sort(): the nodes are relinked in value order, so the next node is anywhere in the heap
+	template <class List>
+	List scattered_list(std::size_t size)
+	{
+		std::mt19937 gen{ 7 };
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(gen() >> 1)); // >= 0, -1 is never found
+		}
+		list.sort();
+		return list;
+	}
+
+	struct times
+	{
+		double find;
+		double equal;
+		double sum;
+		double remove_if;
+		double destroy;
+	};
+
+	template <class List>
+	times measure(std::size_t size)
+	{
+		times result{};
+		auto list = scattered_list<List>(size);
+		auto copy = scattered_list<List>(size); // equal, a copy constructor would allocate the nodes in order
+
+		auto start = clock_type::now();
+		if constexpr (std::is_same_v<List, std::list<std::int32_t>>) {
+			sink = std::find(list.begin(), list.end(), -1) == list.end();
+		}
+		else {
+			sink = list.find(-1) == list.end();
+		}
+		result.find = ns_per_element(start, size);
+
+		start = clock_type::now();
+		sink = list == copy;
+		result.equal = ns_per_element(start, size);
+
+		start = clock_type::now();
+		if constexpr (std::is_same_v<List, std::list<std::int32_t>>) {
+			sink = std::accumulate(list.begin(), list.end(), std::int64_t{});
+		}
+		else {
+			sink = list.accumulate(std::int64_t{});
+		}
+		result.sum = ns_per_element(start, size);
+
+		start = clock_type::now();
+		list.remove_if([](std::int32_t value) { return value % 16 == 0; });
+		result.remove_if = ns_per_element(start, size);
+
+		std::optional<List> doomed{ std::move(copy) };
+		start = clock_type::now();
+		doomed.reset();
+		result.destroy = ns_per_element(start, size);
+		return result;
+	}
+
+	template <class List>
+	void report(const char* name, std::size_t size)
+	{
+		auto t = measure<List>(size);
+		std::printf("%-10zu %-14s %10.2f %10.2f %10.2f %10.2f %10.2f\n", size, name, t.find, t.equal, t.sum, t.remove_if, t.destroy);
+	}
+}
+
+int main()
+{
+	using my_list = my_lib::list<std::int32_t, std::allocator<std::int32_t>, my_lib::unchecked_iterators>;
+	constexpr std::size_t sizes[]{ 100'000, 1'000'000, 4'000'000 };
+
+	std::printf("int32 values, nodes scattered by sort(), ns per element\n");
+	std::printf("%-10s %-14s %10s %10s %10s %10s %10s\n", "elements", "list", "find miss", "==", "sum", "remove_if", "destroy");
+	for (auto size : sizes) {
+		report<std::list<std::int32_t>>("std::list", size);
+		report<my_list>("my_lib::list", size);
+	}
+	return 0;
+}
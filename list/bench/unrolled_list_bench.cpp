@@ -0,0 +1,61 @@
+// Full scans of unrolled_list vs my_lib::list vs std::list
+// g++ -std=c++17 -O2 -DNDEBUG -I.. unrolled_list_bench.cpp -o unrolled_list_bench
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <random>
+#include "../list.hpp"
+#include "../unrolled_list.hpp"
+
+namespace
+{
+	volatile std::int64_t sink; // keeps the measured loops alive
+
+	// a list that was sorted once has its nodes spread over the heap in random order, like a long lived one
+	template <class List>
+	List make_list(std::size_t size)
+	{
+		std::mt19937 gen{ 7 };
+		List list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(static_cast<std::int32_t>(gen() % 1000));
+		}
+		list.sort();
+		return list;
+	}
+
+	// elements per nanosecond
+	template <class List>
+	double scan(std::size_t size)
+	{
+		auto list = make_list<List>(size);
+		constexpr std::size_t min_elements{ 50'000'000 };
+		auto rounds = min_elements / size + 1;
+
+		std::int64_t sum{};
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t r{}; r < rounds; ++r) {
+			for (auto value : list) {
+				sum += value;
+			}
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		sink = sum;
+		return static_cast<double>(size * rounds) / elapsed.count();
+	}
+}
+
+int main()
+{
+	std::printf("scan of int32 after sort(), elements per ns\n");
+	std::printf("%-12s %12s %12s %14s %8s\n", "elements", "std::list", "my_lib::list", "unrolled_list", "gain");
+	for (std::size_t size : { 1'000, 100'000, 1'000'000, 10'000'000 }) {
+		auto std_rate = scan<std::list<std::int32_t>>(size);
+		auto list_rate = scan<my_lib::list<std::int32_t>>(size);
+		auto unrolled_rate = scan<my_lib::unrolled_list<std::int32_t>>(size);
+		std::printf("%-12zu %12.3f %12.3f %14.3f %7.1fx\n", size, std_rate, list_rate, unrolled_rate, unrolled_rate / list_rate);
+	}
+	return 0;
+}
@@ -0,0 +1,336 @@
+#pragma once
+#ifndef MY_LIB_CONCURRENT_ORDERED_LIST
+#define MY_LIB_CONCURRENT_ORDERED_LIST
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <functional>
+#include <optional>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include "hazard_pointers.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * concurrent_ordered_list_node
+	 * concurrent_ordered_list
+	 *
+	 * concurrent_ordered_list is a sorted set (Harris's list, with Michael's hazard pointer version of the search):
+	 * lock-free insert, erase and contains from any number of threads.
+	 * erase first marks the low bit of the node's next_ (logical delete, no insert can go after it any more),
+	 * then unlinks it. Searches help to unlink marked nodes they meet. Unlinked nodes are retired and freed
+	 * when no thread holds a hazard pointer to them.
+	 * The allocator is called concurrently, so it must be thread safe (std::allocator is, node_pool is not).
+	 */
+
+	// next_ is the successor with the "erased" mark in its low bit, value_ never changes after the insert
+	template <class T>
+	struct concurrent_ordered_list_node
+	{
+		// type aliases
+		using value_type = T;
+		using nodeptr = concurrent_ordered_list_node*;
+
+		// data
+		std::atomic<std::uintptr_t> next_;
+		value_type					value_;
+
+		template <class... Args>
+		concurrent_ordered_list_node(Args&&... args) : next_{ 0 }, value_{ std::forward<Args>(args)... } {}
+
+		// copying
+		concurrent_ordered_list_node(const concurrent_ordered_list_node&)				= delete;
+		concurrent_ordered_list_node& operator=(const concurrent_ordered_list_node&)	= delete;
+
+	// Create and destroy functions
+	public:
+		template <class NodeAlloc, class... Args>
+		[[nodiscard]] static nodeptr create_node(NodeAlloc& allocator, Args&&... args)
+		{
+			nodeptr node = allocator.allocate(1);
+			try {
+				std::allocator_traits<NodeAlloc>::construct(allocator, node, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				std::allocator_traits<NodeAlloc>::deallocate(allocator, node, 1);
+				throw;
+			}
+			return node;
+		}
+
+		template <class NodeAlloc>
+		static void free_node(NodeAlloc& allocator, nodeptr ptr) noexcept
+		{
+			std::allocator_traits<NodeAlloc>::destroy(allocator, ptr);
+			std::allocator_traits<NodeAlloc>::deallocate(allocator, ptr, 1);
+		}
+	};
+
+	template <class T, class Cmp = std::less<T>, class Alloc = std::allocator<T>>
+	class concurrent_ordered_list
+	{
+		// type aliases
+	public:
+		using value_type = T;
+		using key_compare = Cmp;
+		using allocator_type = Alloc;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = std::size_t;
+
+	private:
+		using node_type = concurrent_ordered_list_node<T>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using nodeptr = typename node_type::nodeptr;
+		using link = std::atomic<std::uintptr_t>;
+		using hazard_domain = detail::hazard_domain<nodeptr, 2>; // the current node and the one before it, they swap slots
+		using guard = typename hazard_domain::guard;
+
+		static_assert(std::is_same_v<typename node_allocator_traits::pointer, nodeptr>,
+			"my_lib::concurrent_ordered_list needs an allocator with raw pointers, they are swapped atomically");
+		static_assert(alignof(node_type) > 1, "the low bit of a node address is used as the mark");
+
+		constexpr static std::uintptr_t mark{ 1 };
+
+		link head_{ 0 };
+		hazard_domain hazards_;
+		node_allocator_type allocator_;
+		Cmp cmp_;
+
+		// where a search stopped: cur_ is the first node not less than the key, prev_ is the link to it
+		struct position
+		{
+			link* prev_;
+			nodeptr cur_;
+			std::uintptr_t next_; // cur_->next_, not marked
+		};
+
+		// Ctors
+	public:
+		concurrent_ordered_list() : concurrent_ordered_list(Cmp{}) {}
+
+		explicit concurrent_ordered_list(const Cmp& cmp, const Alloc& allocator = Alloc{}) : allocator_{ allocator }, cmp_{ cmp } {}
+
+		// nodes are shared with other threads, the list cannot be copied or moved
+		concurrent_ordered_list(const concurrent_ordered_list&)				= delete;
+		concurrent_ordered_list& operator=(const concurrent_ordered_list&)	= delete;
+
+		// no other thread may use the list any more
+		~concurrent_ordered_list() noexcept
+		{
+			for (auto node = to_node(head_.load(std::memory_order_relaxed)); node; ) {
+				auto next = to_node(node->next_.load(std::memory_order_relaxed));
+				node_type::free_node(allocator_, node);
+				node = next;
+			}
+			hazards_.drain(free_retired());
+		}
+
+		// helpers
+	private:
+		[[nodiscard]] static nodeptr to_node(std::uintptr_t word) noexcept
+		{
+			return reinterpret_cast<nodeptr>(word & ~mark);
+		}
+
+		[[nodiscard]] static std::uintptr_t to_word(nodeptr node) noexcept
+		{
+			return reinterpret_cast<std::uintptr_t>(node);
+		}
+
+		[[nodiscard]] auto free_retired() noexcept
+		{
+			return [this](nodeptr node) { node_type::free_node(allocator_, node); };
+		}
+
+		// Marked nodes met on the way are unlinked. If a link changes under the search, it starts again
+		[[nodiscard]] bool find(guard& hazards, const_reference key, position& pos)
+		{
+		try_again:
+			link* prev = &head_;
+			std::size_t cur_slot{};
+			auto cur = to_node(prev->load(std::memory_order_acquire));
+			for (;;) {
+				if (!cur) {
+					pos = { prev, nullptr, 0 };
+					return false;
+				}
+
+				hazards.set(cur_slot, cur);
+				if (prev->load(std::memory_order_seq_cst) != to_word(cur)) { // cur may be freed already
+					goto try_again;
+				}
+
+				auto next = cur->next_.load(std::memory_order_acquire);
+				if (next & mark) {
+					auto expected = to_word(cur);
+					if (!prev->compare_exchange_strong(expected, next & ~mark, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+						goto try_again;
+					}
+					hazards.retire(cur, free_retired());
+					cur = to_node(next);
+					continue;
+				}
+
+				if (!cmp_(cur->value_, key)) {
+					pos = { prev, cur, next };
+					return !cmp_(key, cur->value_);
+				}
+
+				prev = &cur->next_;
+				cur_slot ^= 1; // the slot of cur keeps prev readable
+				cur = to_node(next);
+			}
+		}
+
+		// Modifiers
+	public:
+		// Returns false (and destroys the new value) if an equal value is in the list
+		template <class... Args>
+		bool emplace(Args&&... args)
+		{
+			auto node = node_type::create_node(allocator_, std::forward<Args>(args)...);
+
+			guard hazards{ hazards_ };
+			position pos;
+			for (;;) {
+				if (find(hazards, node->value_, pos)) {
+					node_type::free_node(allocator_, node);
+					return false;
+				}
+
+				node->next_.store(to_word(pos.cur_), std::memory_order_relaxed);
+				auto expected = to_word(pos.cur_);
+				if (pos.prev_->compare_exchange_strong(expected, to_word(node), std::memory_order_release, std::memory_order_relaxed)) {
+					return true;
+				}
+			}
+		}
+
+		bool insert(const_reference value)
+		{
+			return emplace(value);
+		}
+
+		bool insert(value_type&& value)
+		{
+			return emplace(std::move(value));
+		}
+
+		// Returns false if no equal value was found. Only the thread that marks the node erases it
+		bool erase(const_reference key)
+		{
+			guard hazards{ hazards_ };
+			position pos;
+			for (;;) {
+				if (!find(hazards, key, pos)) {
+					return false;
+				}
+
+				auto next = pos.next_;
+				if (!pos.cur_->next_.compare_exchange_strong(next, next | mark, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					continue; // erased by another thread or a node was inserted after it, look again
+				}
+
+				auto expected = to_word(pos.cur_);
+				if (pos.prev_->compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					hazards.retire(pos.cur_, free_retired());
+				}
+				else {
+					static_cast<void>(find(hazards, key, pos)); // the search unlinks it
+				}
+				return true;
+			}
+		}
+
+		// Lookup
+	public:
+		[[nodiscard]] bool contains(const_reference key)
+		{
+			guard hazards{ hazards_ };
+			position pos;
+			return find(hazards, key, pos);
+		}
+
+		// Calls f(value) in order for every value that stays in the list during the walk, each at most once.
+		// Values inserted or erased meanwhile may be seen or not. When the walk has to start again,
+		// the last value seen is copied to skip what was visited, so T must be copy constructible
+		template <class F>
+		void for_each(F f)
+		{
+			guard hazards{ hazards_ };
+			std::optional<value_type> resume; // the walk starts again after this value
+
+		restart:
+			link* prev = &head_;
+			std::size_t cur_slot{};
+			nodeptr prev_node{};
+			bool prev_visited{}; // prev_node may also be one skipped after a restart
+			auto cur = to_node(prev->load(std::memory_order_acquire));
+			for (;;) {
+				if (!cur) {
+					return;
+				}
+
+				hazards.set(cur_slot, cur);
+				if (prev->load(std::memory_order_seq_cst) != to_word(cur)) {
+					if (prev_visited) {
+						resume.emplace(prev_node->value_);
+					}
+					goto restart;
+				}
+
+				auto next = cur->next_.load(std::memory_order_acquire);
+
+				if (next & mark) {
+					auto expected = to_word(cur);
+					if (!prev->compare_exchange_strong(expected, next & ~mark, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+						if (prev_visited) {
+							resume.emplace(prev_node->value_);
+						}
+						goto restart;
+					}
+					hazards.retire(cur, free_retired());
+					cur = to_node(next);
+					continue;
+				}
+
+				prev_visited = !resume || cmp_(*resume, cur->value_);
+				if (prev_visited) {
+					f(static_cast<const_reference>(cur->value_));
+				}
+
+				prev = &cur->next_;
+				prev_node = cur;
+				cur_slot ^= 1;
+				cur = to_node(next);
+			}
+		}
+
+		// Observers
+	public:
+		// A snapshot, other threads may change it right away
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return head_.load(std::memory_order_acquire) == 0;
+		}
+
+		[[nodiscard]] key_compare key_comp() const
+		{
+			return cmp_;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+	};
+}
+
+#endif
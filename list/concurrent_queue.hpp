@@ -0,0 +1,245 @@
+#pragma once
+#ifndef MY_LIB_CONCURRENT_QUEUE
+#define MY_LIB_CONCURRENT_QUEUE
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <cassert>
+#include "hazard_pointers.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * concurrent_queue_node
+	 * concurrent_queue
+	 *
+	 * concurrent_queue is a Michael-Scott queue: lock-free push_back and try_pop_front from any number of threads.
+	 * The head is a dummy node, the first value lives in head_->next_. Popped nodes are not freed at once,
+	 * they are retired and freed when no thread holds a hazard pointer to them.
+	 * The allocator is called concurrently, so it must be thread safe (std::allocator is, node_pool is not).
+	 */
+
+	// next_ is atomic, the value is constructed in storage_ by push and destroyed by the pop that takes it,
+	// so the dummy head and retired nodes hold no value
+	template <class T>
+	struct concurrent_queue_node
+	{
+		// type aliases
+		using value_type = T;
+		using nodeptr = concurrent_queue_node*;
+
+		// data
+		std::atomic<nodeptr> next_;
+		alignas(T) unsigned char storage_[sizeof(T)];
+
+		concurrent_queue_node() noexcept : next_{ nullptr } {}
+
+		// copying
+		concurrent_queue_node(const concurrent_queue_node&)				= delete;
+		concurrent_queue_node& operator=(const concurrent_queue_node&)	= delete;
+
+		[[nodiscard]] T* value() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(storage_));
+		}
+
+	// Create and destroy functions
+	public:
+		template <class NodeAlloc>
+		[[nodiscard]] static nodeptr create_head(NodeAlloc& allocator)
+		{
+			nodeptr head = allocator.allocate(1);
+			return ::new (static_cast<void*>(head)) concurrent_queue_node{};
+		}
+
+		template <class NodeAlloc, class... Args>
+		[[nodiscard]] static nodeptr create_node(NodeAlloc& allocator, Args&&... args)
+		{
+			auto node = create_head(allocator);
+			try {
+				std::allocator_traits<NodeAlloc>::construct(allocator, node->value(), std::forward<Args>(args)...);
+			}
+			catch (...) {
+				free_without_value(allocator, node);
+				throw;
+			}
+			return node;
+		}
+
+		template <class NodeAlloc>
+		static void free_without_value(NodeAlloc& allocator, nodeptr ptr) noexcept
+		{
+			ptr->~concurrent_queue_node();
+			std::allocator_traits<NodeAlloc>::deallocate(allocator, ptr, 1);
+		}
+
+		template <class NodeAlloc>
+		static void free_node(NodeAlloc& allocator, nodeptr ptr) noexcept
+		{
+			std::allocator_traits<NodeAlloc>::destroy(allocator, ptr->value());
+			free_without_value(allocator, ptr);
+		}
+	};
+
+	template <class T, class Alloc = std::allocator<T>>
+	class concurrent_queue
+	{
+		// type aliases
+	public:
+		using value_type = T;
+		using allocator_type = Alloc;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = std::size_t;
+
+	private:
+		using node_type = concurrent_queue_node<T>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using nodeptr = typename node_type::nodeptr;
+		using hazard_domain = detail::hazard_domain<nodeptr, 2>; // head and head->next_ in pop, tail in push
+
+		static_assert(std::is_same_v<typename node_allocator_traits::pointer, nodeptr>,
+			"my_lib::concurrent_queue needs an allocator with raw pointers, they are swapped atomically");
+
+		constexpr static std::size_t cache_line{ 64 };
+
+		// head_ and tail_ are hammered by different threads, keep them on different lines
+		alignas(cache_line) std::atomic<nodeptr> head_;
+		alignas(cache_line) std::atomic<nodeptr> tail_;
+		alignas(cache_line) hazard_domain hazards_;
+		node_allocator_type allocator_;
+
+		// Ctors
+	public:
+		concurrent_queue() : concurrent_queue(Alloc{}) {}
+
+		explicit concurrent_queue(const Alloc& allocator) : allocator_{ allocator }
+		{
+			auto head = node_type::create_head(allocator_);
+			head_.store(head, std::memory_order_relaxed);
+			tail_.store(head, std::memory_order_relaxed);
+		}
+
+		// nodes are shared with other threads, the queue cannot be copied or moved
+		concurrent_queue(const concurrent_queue&)				= delete;
+		concurrent_queue& operator=(const concurrent_queue&)	= delete;
+
+		// no other thread may use the queue any more
+		~concurrent_queue() noexcept
+		{
+			auto node = head_.load(std::memory_order_relaxed);
+			auto next = node->next_.load(std::memory_order_relaxed);
+			node_type::free_without_value(allocator_, node);
+			for (node = next; node; node = next) {
+				next = node->next_.load(std::memory_order_relaxed);
+				node_type::free_node(allocator_, node);
+			}
+
+			hazards_.drain(free_retired());
+		}
+
+		// helpers
+	private:
+		// popped nodes hold no value
+		[[nodiscard]] auto free_retired() noexcept
+		{
+			return [this](nodeptr node) { node_type::free_without_value(allocator_, node); };
+		}
+
+		// Modifiers
+	public:
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			auto node = node_type::create_node(allocator_, std::forward<Args>(args)...);
+
+			typename hazard_domain::guard guard{ hazards_ };
+			for (;;) {
+				auto tail = guard.protect(0, tail_);
+				auto next = tail->next_.load(std::memory_order_acquire);
+				if (next) { // tail_ is behind, help it
+					tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+					continue;
+				}
+
+				if (tail->next_.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+					tail_.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+					return;
+				}
+			}
+		}
+
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Moves the first value into value. Returns false if the queue was empty.
+		// If the move assignment throws, the element is lost
+		bool try_pop_front(reference value)
+		{
+			typename hazard_domain::guard guard{ hazards_ };
+			for (;;) {
+				auto head = guard.protect(0, head_);
+				auto next = head->next_.load(std::memory_order_acquire);
+				if (!next) {
+					return false;
+				}
+
+				guard.set(1, next);
+				if (head_.load(std::memory_order_seq_cst) != head) { // next may be gone already
+					continue;
+				}
+
+				auto tail = tail_.load(std::memory_order_acquire);
+				if (head == tail) { // tail_ is behind, help it before head_ passes it
+					tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+					continue;
+				}
+
+				if (head_.compare_exchange_strong(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					// next is the new dummy, only this thread touches its value
+					auto ptr = next->value();
+					try {
+						value = std::move(*ptr);
+					}
+					catch (...) {
+						node_allocator_traits::destroy(allocator_, ptr);
+						guard.retire(head, free_retired());
+						throw;
+					}
+					node_allocator_traits::destroy(allocator_, ptr);
+					guard.retire(head, free_retired());
+					return true;
+				}
+			}
+		}
+
+		// Observers
+	public:
+		// A snapshot, other threads may change it right away. The head is not dereferenced
+		// (it could be freed meanwhile), so a push that has not moved tail_ yet is not seen
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,882 @@
+#pragma once
+#ifndef MY_LIB_FORWARD_LIST
+#define MY_LIB_FORWARD_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <initializer_list>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cassert>
+#include "my_utilities.hpp" // my custom library
+#include "link_algorithms.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * forward_list_const_iterator
+	 * forward_list_iterator
+	 * forward_list_node
+	 * forward_list
+	 *
+	 * Singly linked sibling of my_lib::list: a node has no prev_ (16 instead of 24 bytes for an int on 64-bit)
+	 * and a link change costs one store instead of two. Like std::forward_list it does not keep a size, so
+	 * splice_after never counts, but a range still costs a walk to its last node (O(length of the range)).
+	 * The head is embedded (before_begin()) and no node points back to it, so moves and swaps only exchange one pointer.
+	 */
+
+	template <class MyList>
+	class forward_list_const_iterator
+	{
+		// type aliases
+	public:
+		using iterator_category = std::forward_iterator_tag;
+
+		using nodeptr = typename MyList::nodeptr;
+		using value_type = typename MyList::value_type;
+		using pointer = typename MyList::const_pointer;
+		using reference = typename MyList::const_reference;
+		using difference_type = typename MyList::difference_type;
+
+	private:
+		nodeptr ptr_; // nullptr is end()
+
+		// Ctors
+	public:
+		explicit forward_list_const_iterator(const nodeptr ptr) noexcept : ptr_{ ptr } {}
+
+		forward_list_const_iterator() noexcept = default;
+
+		// Access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			assert(ptr_ && "cannot dereference end iterator");
+			return MyList::forward_list_node_type::value_of(ptr_);
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return std::addressof(**this);
+		}
+
+		// Increment
+	public:
+		forward_list_const_iterator& operator++() noexcept
+		{
+			assert(ptr_ && "cannot increment end iterator");
+			ptr_ = ptr_->next_;
+			return *this;
+		}
+
+		forward_list_const_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] bool operator ==(const forward_list_const_iterator& rhs) const noexcept
+		{
+			return ptr_ == rhs.ptr_;
+		}
+
+		[[nodiscard]] bool operator !=(const forward_list_const_iterator& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+	public:
+		const nodeptr& get_pointer() const noexcept
+		{
+			return ptr_;
+		}
+	};
+
+	template <class MyList>
+	class forward_list_iterator : public forward_list_const_iterator<MyList>
+	{
+	// type aliases
+	public:
+		using mybase			= forward_list_const_iterator<MyList>;
+		using mybase::mybase; // ctors
+
+		using nodeptr			= typename MyList::nodeptr;
+		using value_type		= typename MyList::value_type;
+		using pointer			= typename MyList::pointer;
+		using reference			= typename MyList::reference;
+		using difference_type	= typename MyList::difference_type;
+
+	// public access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return const_cast<reference>(mybase::operator*());
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return const_cast<pointer>(mybase::operator->());
+		}
+
+	// increment
+	public:
+		forward_list_iterator& operator++() noexcept
+		{
+			mybase::operator++();
+			return *this;
+		}
+
+		forward_list_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+	// compare
+	public:
+		using mybase::operator==;
+		using mybase::operator!=;
+	};
+
+	// The link of a node, the head of a forward_list is a bare forward_list_node_base
+	template <class Pointer>
+	struct forward_list_node_base
+	{
+		// type aliases
+		using nodeptr = typename std::pointer_traits<Pointer>::template rebind<forward_list_node_base>;
+
+		// data
+		nodeptr		next_; // next node, nullptr after the last one
+
+		forward_list_node_base() noexcept : next_{} {}
+
+		explicit forward_list_node_base(nodeptr next) noexcept : next_{ next } {}
+
+		// copying
+		forward_list_node_base(const forward_list_node_base&)				= delete;
+		forward_list_node_base& operator=(const forward_list_node_base&)	= delete;
+	};
+
+	template <class T, class Pointer>
+	struct forward_list_node : forward_list_node_base<Pointer>
+	{
+		// type aliases
+		using value_type = T;
+		using node_base = forward_list_node_base<Pointer>;
+		using nodeptr = typename node_base::nodeptr;
+		using node_pointer = typename std::pointer_traits<Pointer>::template rebind<forward_list_node>; // fancy pointers too
+
+		// data
+		value_type	value_; // the stored value
+
+		template <class...Args>
+		forward_list_node(nodeptr next, Args&&... args) : node_base{ next },
+														  value_{ std::forward<Args>(args)... }{}
+
+		// copying
+		forward_list_node(const forward_list_node&)				= delete;
+		forward_list_node& operator=(const forward_list_node&)	= delete;
+
+	// Casts, ptr must not be a head
+	public:
+		[[nodiscard]] static value_type& value_of(const nodeptr& ptr) noexcept
+		{
+			return static_cast<forward_list_node&>(*ptr).value_;
+		}
+
+		[[nodiscard]] static node_pointer as_node(const nodeptr& ptr) noexcept
+		{
+			return std::pointer_traits<node_pointer>::pointer_to(static_cast<forward_list_node&>(*ptr));
+		}
+
+		[[nodiscard]] static nodeptr as_base(const node_pointer& ptr) noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(static_cast<node_base&>(*ptr));
+		}
+
+	// Destroy functions
+	public:
+		template <class NodeAlloc>
+		static void free_node(NodeAlloc& allocator, nodeptr ptr) noexcept
+		{
+			auto node = as_node(ptr);
+			std::allocator_traits<NodeAlloc>::destroy(allocator, std::addressof(node->value_));
+			node->node_base::~node_base();
+			std::allocator_traits<NodeAlloc>::deallocate(allocator, node, 1);
+		}
+
+		// frees first and everything after it
+		template <class NodeAlloc>
+		static void free_chain(NodeAlloc& allocator, nodeptr first) noexcept
+		{
+			for (nodeptr next; first; first = next) {
+				next = first->next_;
+				free_node(allocator, first);
+			}
+		}
+	};
+
+	template <class T, class Alloc = std::allocator<T>>
+	class forward_list
+	{
+		// type aliases
+	public:
+		// value type aliases
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		// allocator types aliases and node pointer aliases
+		using allocator_type = Alloc;
+		using list_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+		using list_allocator_traits = std::allocator_traits<list_allocator>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<forward_list_node<T, typename std::allocator_traits<Alloc>::void_pointer>>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using forward_list_node_type = forward_list_node<T, typename node_allocator_traits::void_pointer>;
+		using node_base = typename forward_list_node_type::node_base;
+		using nodeptr = typename forward_list_node_type::nodeptr; // links, the head is only a node_base
+		using node_pointer = typename node_allocator_traits::pointer; // what the allocator gives
+
+		// iterator aliases
+		using iterator = forward_list_iterator<forward_list<T, Alloc>>;
+		using const_iterator = forward_list_const_iterator<forward_list<T, Alloc>>;
+
+		// list data
+	private:
+		node_allocator_type allocator_;
+		node_base head_; // before_begin(), head_.next_ is the first node
+
+		// helpers
+	private:
+		[[nodiscard]] nodeptr head() const noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(const_cast<node_base&>(head_));
+		}
+
+		[[nodiscard]] static reference value_of(const nodeptr& ptr) noexcept
+		{
+			return forward_list_node_type::value_of(ptr);
+		}
+
+		// allocate and construct the node, nothing points to it yet
+		template <class... Args>
+		[[nodiscard]] nodeptr create_node(nodeptr next, Args&&... args)
+		{
+			auto node = allocator_.allocate(1);
+			try {
+				node_allocator_traits::construct(allocator_, std::addressof(*node), next, std::forward<Args>(args)...); // node may be a fancy pointer
+			}
+			catch (...) {
+				allocator_.deallocate(node, 1);
+				throw;
+			}
+			return forward_list_node_type::as_base(node);
+		}
+
+		// Builds the nodes with make(next) in a detached chain and links it after where. If a ctor throws
+		// the chain is freed and the list is not changed. Returns the last new node (where if none was made)
+		template <class More, class Make>
+		nodeptr insert_chain_after(nodeptr where, More more, Make make)
+		{
+			nodeptr first{};
+			nodeptr last{};
+			try {
+				while (more()) {
+					auto node = make();
+					if (last) {
+						last->next_ = node;
+					}
+					else {
+						first = node;
+					}
+					last = node;
+				}
+			}
+			catch (...) {
+				forward_list_node_type::free_chain(allocator_, first);
+				throw;
+			}
+
+			if (!first) return where;
+			last->next_ = where->next_;
+			where->next_ = first;
+			return last;
+		}
+
+		template <class Iter>
+		nodeptr insert_range_after(nodeptr where, Iter first, Iter last)
+		{
+			return insert_chain_after(where, [&first, &last] { return first != last; }, [this, &first] {
+				auto node = create_node(nodeptr{}, *first);
+				++first;
+				return node;
+			});
+		}
+
+		nodeptr insert_n_after(nodeptr where, size_type count, const_reference value)
+		{
+			return insert_chain_after(where, [&count] { return count-- != 0; }, [this, &value] {
+				return create_node(nodeptr{}, value);
+			});
+		}
+
+		// frees the nodes after where up to last (not included)
+		void erase_range_after(nodeptr where, nodeptr last) noexcept
+		{
+			auto node = where->next_;
+			where->next_ = last;
+			while (node != last) {
+				auto next = node->next_;
+				forward_list_node_type::free_node(allocator_, node);
+				node = next;
+			}
+		}
+
+		// the node before last in [where, last), where if none
+		[[nodiscard]] static nodeptr before(nodeptr where, nodeptr last) noexcept
+		{
+			while (where->next_ != last) {
+				where = where->next_;
+			}
+			return where;
+		}
+
+		// Ctors and dtor
+	public:
+		forward_list() noexcept(noexcept(allocator_type{})) : forward_list(allocator_type{}) {}
+
+		explicit forward_list(const allocator_type& allocator) noexcept : allocator_{ allocator } {}
+
+		explicit forward_list(size_type count, const allocator_type& allocator = allocator_type{}) : forward_list(allocator)
+		{
+			insert_chain_after(head(), [&count] { return count-- != 0; }, [this] { return create_node(nodeptr{}); });
+		}
+
+		forward_list(size_type count, const_reference value, const allocator_type& allocator = allocator_type{}) : forward_list(allocator)
+		{
+			insert_n_after(head(), count, value);
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		forward_list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : forward_list(allocator)
+		{
+			insert_range_after(head(), first, last);
+		}
+
+		forward_list(const forward_list& rhs) : forward_list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.allocator_))
+		{
+			insert_range_after(head(), rhs.begin(), rhs.end());
+		}
+
+		forward_list(const forward_list& rhs, const allocator_type& allocator) : forward_list(allocator)
+		{
+			insert_range_after(head(), rhs.begin(), rhs.end());
+		}
+
+		forward_list(forward_list&& rhs) noexcept : allocator_{ rhs.allocator_ }
+		{
+			head_.next_ = std::exchange(rhs.head_.next_, nodeptr{});
+		}
+
+		forward_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type{}) : forward_list(allocator)
+		{
+			insert_range_after(head(), ilist.begin(), ilist.end());
+		}
+
+		~forward_list() noexcept
+		{
+			forward_list_node_type::free_chain(allocator_, head_.next_);
+		}
+
+		// Member functions (operator=, assign, get_allocator)
+	public:
+		forward_list& operator=(const forward_list& rhs)
+		{
+			if (this != std::addressof(rhs)) {
+				assign(rhs.begin(), rhs.end());
+			}
+			return *this;
+		}
+
+		forward_list& operator=(forward_list&& rhs) noexcept(node_allocator_traits::propagate_on_container_move_assignment::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this == std::addressof(rhs)) return *this;
+
+			if (allocator_ == rhs.allocator_) {
+				clear();
+				head_.next_ = std::exchange(rhs.head_.next_, nodeptr{});
+			}
+			else if constexpr (node_allocator_traits::propagate_on_container_move_assignment::value) {
+				clear(); // use old allocator to free the storage
+				allocator_ = rhs.allocator_;
+				head_.next_ = std::exchange(rhs.head_.next_, nodeptr{});
+			}
+			else {
+				assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+				rhs.clear();
+			}
+			return *this;
+		}
+
+		forward_list& operator=(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		// The existing nodes are reused, the rest is erased or appended
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		void assign(Iter first, const Iter last)
+		{
+			auto prev = head();
+			for (; prev->next_ && first != last; prev = prev->next_, ++first) {
+				value_of(prev->next_) = *first;
+			}
+
+			if (first != last) {
+				insert_range_after(prev, first, last);
+			}
+			else {
+				erase_range_after(prev, nodeptr{});
+			}
+		}
+
+		void assign(size_type count, const_reference value)
+		{
+			auto prev = head();
+			for (; prev->next_ && count != 0; prev = prev->next_, --count) {
+				value_of(prev->next_) = value;
+			}
+
+			if (count != 0) {
+				insert_n_after(prev, count, value);
+			}
+			else {
+				erase_range_after(prev, nodeptr{});
+			}
+		}
+
+		void assign(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+
+		// Element access
+	public:
+		[[nodiscard]] reference front() noexcept
+		{
+			assert(head_.next_ && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		[[nodiscard]] const_reference front() const noexcept
+		{
+			assert(head_.next_ && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		// Iterators
+	public:
+		[[nodiscard]] iterator before_begin() noexcept
+		{
+			return iterator{ head() };
+		}
+
+		[[nodiscard]] const_iterator before_begin() const noexcept
+		{
+			return const_iterator{ head() };
+		}
+
+		[[nodiscard]] const_iterator cbefore_begin() const noexcept
+		{
+			return before_begin();
+		}
+
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator{ nodeptr{} };
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator{ nodeptr{} };
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		// Capacity
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return !head_.next_;
+		}
+
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			auto diff_max = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+			auto alnode_max = static_cast<size_type>(node_allocator_traits::max_size(allocator_));
+			if (diff_max < alnode_max) return diff_max;
+			return alnode_max;
+		}
+
+		// Modifiers
+	public:
+		void clear() noexcept
+		{
+			forward_list_node_type::free_chain(allocator_, head_.next_);
+			head_.next_ = nodeptr{};
+		}
+
+		iterator insert_after(const_iterator pos, const_reference value)
+		{
+			return emplace_after(pos, value);
+		}
+
+		iterator insert_after(const_iterator pos, value_type&& value)
+		{
+			return emplace_after(pos, std::move(value));
+		}
+
+		// returns the last inserted element, pos if count is 0
+		iterator insert_after(const_iterator pos, size_type count, const_reference value)
+		{
+			assert(pos.get_pointer() && "cannot insert after end iterator");
+			return iterator{ insert_n_after(pos.get_pointer(), count, value) };
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		iterator insert_after(const_iterator pos, Iter first, Iter last)
+		{
+			assert(pos.get_pointer() && "cannot insert after end iterator");
+			return iterator{ insert_range_after(pos.get_pointer(), first, last) };
+		}
+
+		iterator insert_after(const_iterator pos, std::initializer_list<value_type> ilist)
+		{
+			return insert_after(pos, ilist.begin(), ilist.end());
+		}
+
+		template <class... Args>
+		iterator emplace_after(const_iterator pos, Args&&... what)
+		{
+			auto where = pos.get_pointer();
+			assert(where && "cannot insert after end iterator");
+
+			auto node = create_node(where->next_, std::forward<Args>(what)...);
+			where->next_ = node;
+			return iterator{ node };
+		}
+
+		// erases the element after pos, returns the one after it
+		iterator erase_after(const_iterator pos) noexcept
+		{
+			auto where = pos.get_pointer();
+			assert(where && where->next_ && "no element after the iterator");
+
+			auto node = where->next_;
+			where->next_ = node->next_;
+			forward_list_node_type::free_node(allocator_, node);
+			return iterator{ where->next_ };
+		}
+
+		// erases (first, last)
+		iterator erase_after(const_iterator first, const_iterator last) noexcept
+		{
+			assert(first.get_pointer() && "cannot erase after end iterator");
+			erase_range_after(first.get_pointer(), last.get_pointer());
+			return iterator{ last.get_pointer() };
+		}
+
+		void push_front(const_reference value)
+		{
+			emplace_front(value);
+		}
+
+		void push_front(value_type&& value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		template <class... Args>
+		reference emplace_front(Args&&... what)
+		{
+			head_.next_ = create_node(head_.next_, std::forward<Args>(what)...);
+			return value_of(head_.next_);
+		}
+
+		void pop_front() noexcept
+		{
+			assert(head_.next_ && "cannot pop on empty container");
+			auto node = head_.next_;
+			head_.next_ = node->next_;
+			forward_list_node_type::free_node(allocator_, node);
+		}
+
+		void resize(size_type new_size)
+		{
+			auto prev = head();
+			for (; prev->next_ && new_size != 0; prev = prev->next_, --new_size) {}
+
+			if (new_size != 0) {
+				insert_chain_after(prev, [&new_size] { return new_size-- != 0; }, [this] { return create_node(nodeptr{}); });
+			}
+			else {
+				erase_range_after(prev, nodeptr{});
+			}
+		}
+
+		void resize(size_type new_size, const_reference value)
+		{
+			auto prev = head();
+			for (; prev->next_ && new_size != 0; prev = prev->next_, --new_size) {}
+
+			if (new_size != 0) {
+				insert_n_after(prev, new_size, value);
+			}
+			else {
+				erase_range_after(prev, nodeptr{});
+			}
+		}
+
+		void swap(forward_list& rhs) noexcept(node_allocator_traits::propagate_on_container_swap::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this != std::addressof(rhs)) {
+				if constexpr (node_allocator_traits::propagate_on_container_swap::value) {
+					std::swap(allocator_, rhs.allocator_);
+				}
+				else {
+					assert(allocator_ == rhs.allocator_ && "list allocators incompatible for swap");
+				}
+
+				std::swap(head_.next_, rhs.head_.next_);
+			}
+		}
+
+		// Operations
+	public:
+		template <class Cmp = std::less<value_type>>
+		void merge(forward_list& rhs, Cmp cmp = Cmp{})
+		{
+			merge(std::move(rhs), cmp);
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(forward_list&& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs)) return;
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for merge");
+			assert(std::is_sorted(begin(), end(), cmp) && std::is_sorted(rhs.begin(), rhs.end(), cmp) && "sequence not ordered");
+
+			auto node_cmp = [&cmp](const nodeptr& lhs, const nodeptr& rhs) { return cmp(value_of(lhs), value_of(rhs)); };
+			head_.next_ = detail::forward_merge(head_.next_, std::exchange(rhs.head_.next_, nodeptr{}), node_cmp);
+		}
+
+
+		void splice_after(const_iterator pos, forward_list& rhs) noexcept
+		{
+			splice_after(pos, std::move(rhs));
+		}
+
+		// O(n) in the size of rhs: its last node has to be found
+		void splice_after(const_iterator pos, forward_list&& rhs) noexcept
+		{
+			splice_after(pos, std::move(rhs), rhs.before_begin(), rhs.end());
+		}
+
+		void splice_after(const_iterator pos, forward_list& rhs, const_iterator it) noexcept
+		{
+			splice_after(pos, std::move(rhs), it);
+		}
+
+		// moves the element after it
+		void splice_after(const_iterator pos, forward_list&& rhs, const_iterator it) noexcept
+		{
+			auto where = pos.get_pointer();
+			auto prev = it.get_pointer();
+			assert(where && prev && prev->next_ && "no element after the iterator");
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+			if (where == prev || where == prev->next_) return; // already there
+
+			auto node = prev->next_;
+			prev->next_ = node->next_;
+			node->next_ = where->next_;
+			where->next_ = node;
+		}
+
+		void splice_after(const_iterator pos, forward_list& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			splice_after(pos, std::move(rhs), first, last);
+		}
+
+		// Moves (first, last) after pos. O(length of the range): the node before last is searched
+		void splice_after(const_iterator pos, forward_list&& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			auto where = pos.get_pointer();
+			auto begin = first.get_pointer();
+			auto end = last.get_pointer();
+			assert(where && begin && "cannot splice after end iterator");
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+			if (begin->next_ == end) return; // empty range
+
+			auto back = before(begin, end);
+			auto range = begin->next_;
+			begin->next_ = end;
+			back->next_ = where->next_;
+			where->next_ = range;
+		}
+
+
+		void remove(const_reference value)
+		{
+			remove_if([&value](const_reference current) { return current == value; });
+		}
+
+		template <class Predicate>
+		void remove_if(Predicate pred)
+		{
+			for (auto prev = head(); prev->next_; ) {
+				auto node = prev->next_;
+				if (pred(value_of(node))) {
+					prev->next_ = node->next_;
+					forward_list_node_type::free_node(allocator_, node);
+				}
+				else {
+					prev = node;
+				}
+			}
+		}
+
+
+		void reverse() noexcept
+		{
+			nodeptr reversed{};
+			for (auto node = head_.next_; node; ) {
+				auto next = node->next_;
+				node->next_ = reversed;
+				reversed = node;
+				node = next;
+			}
+			head_.next_ = reversed;
+		}
+
+		void unique()
+		{
+			unique(std::equal_to<value_type>{});
+		}
+
+		template <class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			auto node = head_.next_;
+			if (!node) return;
+
+			while (node->next_) {
+				auto next = node->next_;
+				if (pred(value_of(node), value_of(next))) {
+					node->next_ = next->next_;
+					forward_list_node_type::free_node(allocator_, next);
+				}
+				else {
+					node = next;
+				}
+			}
+		}
+
+		// bottom-up merge sort, stable, only links are changed
+		template <class BinaryPred = std::less<value_type>>
+		void sort(BinaryPred pred = BinaryPred{})
+		{
+			auto node_pred = [&pred](const nodeptr& lhs, const nodeptr& rhs) { return pred(value_of(lhs), value_of(rhs)); };
+			head_.next_ = detail::forward_sort_chain(head_.next_, node_pred);
+		}
+	};
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator==(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		auto lhsit = lhs.begin();
+		auto rhsit = rhs.begin();
+		for (; lhsit != lhs.end() && rhsit != rhs.end(); ++lhsit, ++rhsit) {
+			if (!(*lhsit == *rhsit)) return false;
+		}
+		return lhsit == lhs.end() && rhsit == rhs.end();
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator!=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>=(const forward_list<T, Alloc>& lhs, const forward_list<T, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+}
+
+namespace std {
+	template <class T, class Alloc>
+	void swap(my_lib::forward_list<T, Alloc>& lhs, my_lib::forward_list<T, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
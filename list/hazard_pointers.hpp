@@ -0,0 +1,200 @@
+#pragma once
+#ifndef MY_LIB_HAZARD_POINTERS
+#define MY_LIB_HAZARD_POINTERS
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * detail::hazard_cache
+	 * detail::hazard_domain
+	 *
+	 * Safe memory reclamation for the lock-free containers (concurrent_queue, concurrent_ordered_list).
+	 * Before a thread dereferences a shared node it publishes the pointer in a hazard slot. An unlinked node
+	 * is retired instead of freed, and it is freed only when no slot holds it.
+	 */
+
+	namespace detail
+	{
+		// the record used last by this thread, domain_id_ tells which domain it belongs to (ids are never reused)
+		struct hazard_cache
+		{
+			std::uint64_t domain_id_{};
+			void* record_{};
+		};
+
+		inline thread_local hazard_cache this_thread_hazards{};
+		inline std::atomic<std::uint64_t> next_hazard_domain_id{ 1 };
+
+		// Hazard slots of one container. A thread takes a free record for the time of one operation
+		// (through a guard) and usually gets the same one back from the cache next time.
+		// Records live as long as the domain. The owner calls drain() before the domain is destroyed
+		template <class Nodeptr, std::size_t Slots>
+		class hazard_domain
+		{
+			struct record
+			{
+				std::atomic<Nodeptr> hazards_[Slots]{};
+				std::atomic<bool> active_{ true };
+				record* next_{}; // immutable once the record is published
+				std::vector<Nodeptr> retired_; // touched only by the owner of the record
+			};
+
+			constexpr static std::size_t min_scan{ 64 }; // retired nodes a record collects before it looks at the hazards
+
+			std::atomic<record*> records_{};
+			std::atomic<std::size_t> record_count_{};
+			const std::uint64_t id_{ next_hazard_domain_id.fetch_add(1, std::memory_order_relaxed) };
+
+			// Ctors
+		public:
+			hazard_domain() noexcept = default;
+
+			hazard_domain(const hazard_domain&)				= delete;
+			hazard_domain& operator=(const hazard_domain&)	= delete;
+
+			~hazard_domain() noexcept
+			{
+				for (auto node = records_.load(std::memory_order_relaxed); node; ) {
+					auto next = node->next_;
+					delete node;
+					node = next;
+				}
+			}
+
+		public:
+			// Holds a record for one operation, the slots are cleared when it is destroyed
+			class guard
+			{
+				hazard_domain& domain_;
+				record* record_;
+
+			public:
+				explicit guard(hazard_domain& domain) : domain_{ domain }, record_{ domain.acquire() } {}
+
+				guard(const guard&)				= delete;
+				guard& operator=(const guard&)	= delete;
+
+				~guard() noexcept
+				{
+					for (auto& hazard : record_->hazards_) {
+						hazard.store(nullptr, std::memory_order_release);
+					}
+					record_->active_.store(false, std::memory_order_release);
+				}
+
+				// Publishes the node in the slot. The caller still has to check that the node is reachable afterwards
+				void set(std::size_t slot, Nodeptr node) noexcept
+				{
+					record_->hazards_[slot].store(node, std::memory_order_seq_cst);
+				}
+
+				// Loads src into the slot and checks it is still there, after that the node cannot be freed
+				[[nodiscard]] Nodeptr protect(std::size_t slot, const std::atomic<Nodeptr>& src) noexcept
+				{
+					auto node = src.load(std::memory_order_relaxed);
+					for (;;) {
+						set(slot, node);
+						auto again = src.load(std::memory_order_seq_cst);
+						if (again == node) {
+							return node;
+						}
+						node = again;
+					}
+				}
+
+				// node is unlinked, free(node) is called when no slot holds it (maybe by another thread later)
+				template <class Free>
+				void retire(Nodeptr node, Free free)
+				{
+					domain_.retire(record_, node, free);
+				}
+			};
+
+			// Frees every retired node, no other thread may use the domain
+			template <class Free>
+			void drain(Free free) noexcept
+			{
+				for (auto node = records_.load(std::memory_order_acquire); node; node = node->next_) {
+					for (auto retired : node->retired_) {
+						free(retired);
+					}
+					node->retired_.clear();
+				}
+			}
+
+		private:
+			[[nodiscard]] record* acquire()
+			{
+				auto& cache = this_thread_hazards;
+				if (cache.domain_id_ == id_) {
+					auto cached = static_cast<record*>(cache.record_);
+					if (!cached->active_.exchange(true, std::memory_order_acquire)) {
+						return cached;
+					}
+				}
+
+				auto node = records_.load(std::memory_order_acquire);
+				for (; node; node = node->next_) {
+					if (!node->active_.load(std::memory_order_relaxed) && !node->active_.exchange(true, std::memory_order_acquire)) {
+						break;
+					}
+				}
+
+				if (!node) {
+					node = new record{}; // active_ is true already
+					node->next_ = records_.load(std::memory_order_relaxed);
+					while (!records_.compare_exchange_weak(node->next_, node, std::memory_order_release, std::memory_order_relaxed)) {}
+					record_count_.fetch_add(1, std::memory_order_relaxed);
+				}
+
+				cache = { id_, node };
+				return node;
+			}
+
+			template <class Free>
+			void retire(record* owner, Nodeptr node, Free& free)
+			{
+				owner->retired_.push_back(node);
+				auto threshold = std::max(min_scan, 2 * Slots * record_count_.load(std::memory_order_relaxed));
+				if (owner->retired_.size() >= threshold) {
+					scan(owner, free);
+				}
+			}
+
+			// Frees the retired nodes of the record that are not in any hazard slot
+			template <class Free>
+			void scan(record* owner, Free& free)
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				std::vector<Nodeptr> hazards;
+				for (auto node = records_.load(std::memory_order_acquire); node; node = node->next_) {
+					for (auto& hazard : node->hazards_) {
+						if (auto ptr = hazard.load(std::memory_order_acquire)) {
+							hazards.push_back(ptr);
+						}
+					}
+				}
+				std::sort(hazards.begin(), hazards.end());
+
+				auto& retired = owner->retired_;
+				auto kept = std::partition(retired.begin(), retired.end(), [&hazards](Nodeptr ptr) {
+					return std::binary_search(hazards.begin(), hazards.end(), ptr);
+				});
+				for (auto it = kept; it != retired.end(); ++it) {
+					free(*it);
+				}
+				retired.erase(kept, retired.end());
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,1058 @@
+#pragma once
+#ifndef MY_LIB_INDEX_LIST
+#define MY_LIB_INDEX_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <initializer_list>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include "my_utilities.hpp" // my custom library
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * index_list_const_iterator
+	 * index_list_iterator
+	 * index_list_node
+	 * index_list
+	 *
+	 * index_list keeps its nodes in one growable array and links them with 32-bit indices: a node of an int
+	 * takes 12 bytes instead of the 24 of list_node plus the allocator header. Slot 0 is the head, freed slots
+	 * go to a free stack. When the array grows the values are moved to the same indices, so the links stay.
+	 * Iterators hold the list and an index: they survive the growth and every insert / erase of other elements,
+	 * but not a swap or a move of the list. Elements spliced or merged from another index_list are moved
+	 * (there is no shared array), inside one list splice only relinks.
+	 */
+
+	template <class MyList>
+	class index_list_const_iterator
+	{
+		// type aliases
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		using index_type = typename MyList::index_type;
+		using value_type = typename MyList::value_type;
+		using pointer = typename MyList::const_pointer;
+		using reference = typename MyList::const_reference;
+		using difference_type = typename MyList::difference_type;
+
+	private:
+		const MyList* list_{};
+		index_type index_{}; // end() is the head, index 0
+
+		// Ctors
+	public:
+		index_list_const_iterator(const MyList* list, index_type index) noexcept : list_{ list }, index_{ index } {}
+
+		index_list_const_iterator() noexcept = default;
+
+		// Access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			assert(list_ && "value-initialized iterator");
+			assert(index_ != MyList::head_index && "cannot dereference end iterator");
+			return list_->value_of(index_);
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return std::addressof(**this);
+		}
+
+		// Increment / decrement
+	public:
+		index_list_const_iterator& operator++() noexcept
+		{
+			assert(list_ && list_->nodes_ && "value-initialized iterator or empty list");
+			index_ = list_->node(index_).next_;
+			return *this;
+		}
+
+		index_list_const_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		index_list_const_iterator& operator--() noexcept
+		{
+			assert(list_ && list_->nodes_ && "value-initialized iterator or empty list");
+			index_ = list_->node(index_).prev_;
+			return *this;
+		}
+
+		index_list_const_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] bool operator ==(const index_list_const_iterator& rhs) const noexcept
+		{
+			return index_ == rhs.index_ && list_ == rhs.list_;
+		}
+
+		[[nodiscard]] bool operator !=(const index_list_const_iterator& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+	public:
+		[[nodiscard]] index_type get_index() const noexcept
+		{
+			return index_;
+		}
+
+		[[nodiscard]] const MyList* get_list() const noexcept
+		{
+			return list_;
+		}
+	};
+
+	template <class MyList>
+	class index_list_iterator : public index_list_const_iterator<MyList>
+	{
+	// type aliases
+	public:
+		using mybase			= index_list_const_iterator<MyList>;
+		using mybase::mybase; // ctors
+
+		using index_type		= typename MyList::index_type;
+		using value_type		= typename MyList::value_type;
+		using pointer			= typename MyList::pointer;
+		using reference			= typename MyList::reference;
+		using difference_type	= typename MyList::difference_type;
+
+	// public access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return const_cast<reference>(mybase::operator*());
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return const_cast<pointer>(mybase::operator->());
+		}
+
+	// increment / decrement
+	public:
+		index_list_iterator& operator++() noexcept
+		{
+			mybase::operator++();
+			return *this;
+		}
+
+		index_list_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		index_list_iterator& operator--() noexcept
+		{
+			mybase::operator--();
+			return *this;
+		}
+
+		index_list_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+	// compare
+	public:
+		using mybase::operator==;
+		using mybase::operator!=;
+	};
+
+	// One slot of the array. The value is constructed only while the slot is linked,
+	// a free slot uses next_ for the free stack
+	template <class T>
+	struct index_list_node
+	{
+		std::uint32_t next_;
+		std::uint32_t prev_;
+		alignas(T) unsigned char value_[sizeof(T)];
+
+		[[nodiscard]] T* value() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(value_));
+		}
+	};
+
+	template <class T, class Alloc = std::allocator<T>>
+	class index_list
+	{
+		friend index_list_const_iterator<index_list<T, Alloc>>;
+		// type aliases
+	public:
+		// value type aliases
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using index_type = std::uint32_t;
+
+		// allocator types aliases
+		using allocator_type = Alloc;
+		using list_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+		using list_allocator_traits = std::allocator_traits<list_allocator>;
+		using node_type = index_list_node<T>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using nodeptr = typename node_allocator_traits::pointer; // the array
+
+		// iterator aliases
+		using iterator = index_list_iterator<index_list<T, Alloc>>;
+		using const_iterator = index_list_const_iterator<index_list<T, Alloc>>;
+
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		constexpr static index_type head_index{ 0 };
+		constexpr static index_type no_index{ std::numeric_limits<index_type>::max() }; // end of the free stack
+
+		// list data
+	private:
+		node_allocator_type allocator_;
+		nodeptr nodes_{}; // nullptr until the first insert or reserve
+		index_type capacity_{}; // slots in nodes_, the head included
+		index_type used_{}; // slots [0, used_) were handed out, the rest was never touched
+		index_type free_{ no_index }; // freed slots linked by next_
+		index_type size_{};
+
+		// Slot helpers
+	private:
+		[[nodiscard]] node_type& node(index_type index) const noexcept
+		{
+			return nodes_[index];
+		}
+
+		[[nodiscard]] reference value_of(index_type index) const noexcept
+		{
+			return *node(index).value();
+		}
+
+		// an unused list has no array, its head is only an index
+		[[nodiscard]] index_type next_of(index_type index) const noexcept
+		{
+			return nodes_ ? node(index).next_ : head_index;
+		}
+
+		[[nodiscard]] static size_type max_nodes() noexcept
+		{
+			return static_cast<size_type>(no_index); // indices [0, no_index)
+		}
+
+		// free slots without a grow
+		[[nodiscard]] size_type available() const noexcept
+		{
+			return capacity_ == 0 ? 0 : capacity_ - 1 - size_;
+		}
+
+		// Moves the values to a bigger array at the same indices, the links are copied as they are.
+		// If a move throws the old array is kept (the values are copied when their move may throw)
+		void grow(size_type min_capacity)
+		{
+			if (min_capacity > max_nodes()) {
+				throw std::length_error{ "index_list too long" };
+			}
+
+			size_type new_capacity = capacity_ < 8 ? 8 : capacity_ + capacity_ / 2; // 1.5, the slack is memory too
+			if (new_capacity > max_nodes()) {
+				new_capacity = max_nodes();
+			}
+			if (new_capacity < min_capacity) {
+				new_capacity = min_capacity;
+			}
+
+			auto nodes = allocator_.allocate(new_capacity);
+			for (size_type i{}; i < new_capacity; ++i) {
+				::new (static_cast<void*>(std::addressof(nodes[i]))) node_type; // only links, nothing to initialize
+			}
+
+			if (!nodes_) {
+				nodes[head_index].next_ = head_index;
+				nodes[head_index].prev_ = head_index;
+				used_ = 1;
+			}
+			else {
+				auto index = node(head_index).next_;
+				try {
+					for (; index != head_index; index = node(index).next_) {
+						node_allocator_traits::construct(allocator_, nodes[index].value(), std::move_if_noexcept(value_of(index)));
+					}
+				}
+				catch (...) {
+					for (auto done = node(head_index).next_; done != index; done = node(done).next_) {
+						node_allocator_traits::destroy(allocator_, nodes[done].value());
+					}
+					allocator_.deallocate(nodes, new_capacity);
+					throw;
+				}
+
+				for (index_type i{}; i < used_; ++i) {
+					nodes[i].next_ = node(i).next_;
+					nodes[i].prev_ = node(i).prev_;
+				}
+				free_storage();
+			}
+
+			nodes_ = nodes;
+			capacity_ = static_cast<index_type>(new_capacity);
+		}
+
+		// destroys the values and frees the array, the members are not reset
+		void free_storage() noexcept
+		{
+			if (!nodes_) return;
+
+			for (auto index = node(head_index).next_; index != head_index; index = node(index).next_) {
+				node_allocator_traits::destroy(allocator_, node(index).value());
+			}
+			allocator_.deallocate(nodes_, capacity_);
+		}
+
+		// the top of the free stack, else the next never used slot. There must be one (see available)
+		[[nodiscard]] index_type acquire_slot() noexcept
+		{
+			if (free_ != no_index) {
+				auto index = free_;
+				free_ = node(index).next_;
+				return index;
+			}
+			return used_++;
+		}
+
+		void release_slot(index_type index) noexcept
+		{
+			node(index).next_ = free_;
+			free_ = index;
+		}
+
+		void link_before(index_type where, index_type index) noexcept
+		{
+			auto& current = node(index);
+			current.next_ = where;
+			current.prev_ = node(where).prev_;
+			node(current.prev_).next_ = index;
+			node(where).prev_ = index;
+		}
+
+		void unlink(index_type index) noexcept
+		{
+			auto& current = node(index);
+			node(current.prev_).next_ = current.next_;
+			node(current.next_).prev_ = current.prev_;
+		}
+
+		// construct the value in a new slot linked before where
+		template <class... Args>
+		index_type create_node(index_type where, Args&&... args)
+		{
+			if (available() == 0) {
+				// args may refer to an element that grow() moves, so the value is made first
+				value_type value(std::forward<Args>(args)...);
+				grow(static_cast<size_type>(capacity_) + 1);
+				return create_node(where, std::move(value));
+			}
+
+			auto index = acquire_slot();
+			try {
+				node_allocator_traits::construct(allocator_, node(index).value(), std::forward<Args>(args)...);
+			}
+			catch (...) {
+				release_slot(index);
+				throw;
+			}
+
+			link_before(where, index);
+			++size_;
+			return index;
+		}
+
+		// unlink, destroy and free the slot, returns the next index
+		index_type erase_node(index_type index) noexcept
+		{
+			assert(index != head_index && "cannot erase end iterator");
+			auto next = node(index).next_;
+			unlink(index);
+			node_allocator_traits::destroy(allocator_, node(index).value());
+			release_slot(index);
+			--size_;
+			return next;
+		}
+
+		// Takes the array of rhs, this list owns nothing
+		void take(index_list& rhs) noexcept
+		{
+			nodes_		= std::exchange(rhs.nodes_, nodeptr{});
+			capacity_	= std::exchange(rhs.capacity_, 0);
+			used_		= std::exchange(rhs.used_, 0);
+			free_		= std::exchange(rhs.free_, no_index);
+			size_		= std::exchange(rhs.size_, 0);
+		}
+
+		void range_verify([[maybe_unused]] const const_iterator& pos) const noexcept
+		{
+			assert(pos.get_list() == this && "iterator of another list");
+		}
+
+		// Ctors and dtor
+	public:
+		index_list() noexcept(noexcept(allocator_type{})) : index_list(allocator_type{}) {}
+
+		explicit index_list(const allocator_type& allocator) noexcept : allocator_{ allocator } {}
+
+		explicit index_list(size_type count, const allocator_type& allocator = allocator_type{}) : index_list(allocator)
+		{
+			resize(count);
+		}
+
+		index_list(size_type count, const_reference value, const allocator_type& allocator = allocator_type{}) : index_list(allocator)
+		{
+			insert(end(), count, value);
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		index_list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : index_list(allocator)
+		{
+			insert(end(), first, last);
+		}
+
+		index_list(const index_list& rhs) : index_list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.allocator_))
+		{
+			insert(end(), rhs.begin(), rhs.end());
+		}
+
+		index_list(const index_list& rhs, const allocator_type& allocator) : index_list(allocator)
+		{
+			insert(end(), rhs.begin(), rhs.end());
+		}
+
+		index_list(index_list&& rhs) noexcept : allocator_{ rhs.allocator_ }
+		{
+			take(rhs);
+		}
+
+		index_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type{}) : index_list(allocator)
+		{
+			insert(end(), ilist.begin(), ilist.end());
+		}
+
+		~index_list() noexcept
+		{
+			free_storage();
+		}
+
+		// Member functions (operator=, assign, get_allocator)
+	public:
+		index_list& operator=(const index_list& rhs)
+		{
+			if (this != std::addressof(rhs)) {
+				assign(rhs.begin(), rhs.end());
+			}
+			return *this;
+		}
+
+		index_list& operator=(index_list&& rhs) noexcept(node_allocator_traits::propagate_on_container_move_assignment::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this == std::addressof(rhs)) return *this;
+
+			if (allocator_ == rhs.allocator_) {
+				free_storage();
+				take(rhs);
+			}
+			else if constexpr (node_allocator_traits::propagate_on_container_move_assignment::value) {
+				free_storage(); // use old allocator to free the storage
+				allocator_ = rhs.allocator_;
+				take(rhs);
+			}
+			else {
+				assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+				rhs.clear();
+			}
+			return *this;
+		}
+
+		index_list& operator=(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		void assign(Iter first, const Iter last)
+		{
+			clear();
+			insert(end(), first, last);
+		}
+
+		void assign(size_type count, const_reference value)
+		{
+			if (size_ != 0) {
+				value_type copy(value); // value may be an element
+				clear();
+				insert(end(), count, copy);
+			}
+			else {
+				insert(end(), count, value);
+			}
+		}
+
+		void assign(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+
+		// Element access
+	public:
+		[[nodiscard]] reference front()
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return value_of(node(head_index).next_);
+		}
+
+		[[nodiscard]] const_reference front() const
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return value_of(node(head_index).next_);
+		}
+
+		[[nodiscard]] reference back()
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return value_of(node(head_index).prev_);
+		}
+
+		[[nodiscard]] const_reference back() const
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return value_of(node(head_index).prev_);
+		}
+
+		// Iterators
+	public:
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator(this, next_of(head_index));
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator(this, next_of(head_index));
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator(this, head_index);
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator(this, head_index);
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator(end());
+		}
+
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator(end());
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator(begin());
+		}
+
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator(begin());
+		}
+
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return rbegin();
+		}
+
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return rend();
+		}
+
+		// Capacity
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size_ == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			auto alnode_max = static_cast<size_type>(node_allocator_traits::max_size(allocator_));
+			return std::min(max_nodes(), alnode_max) - 1; // the head takes a slot
+		}
+
+		// elements that fit without a grow
+		[[nodiscard]] size_type capacity() const noexcept
+		{
+			return capacity_ == 0 ? 0 : capacity_ - 1;
+		}
+
+		// Grows the array once to count elements, iterators stay valid
+		void reserve(size_type count)
+		{
+			if (count > max_size()) {
+				throw std::length_error{ "index_list::reserve() count exceeds max_size()" };
+			}
+			if (count > capacity()) {
+				grow(count + 1);
+			}
+		}
+
+		// Modifiers
+	public:
+		// The array is kept, the next inserts take the slots in order again
+		void clear() noexcept
+		{
+			if (!nodes_) return;
+
+			for (auto index = node(head_index).next_; index != head_index; index = node(index).next_) {
+				node_allocator_traits::destroy(allocator_, node(index).value());
+			}
+			node(head_index).next_ = head_index;
+			node(head_index).prev_ = head_index;
+			used_ = 1;
+			free_ = no_index;
+			size_ = 0;
+		}
+
+		iterator insert(const_iterator pos, const_reference value)
+		{
+			return emplace(pos, value);
+		}
+
+		iterator insert(const_iterator pos, value_type&& value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		iterator insert(const_iterator pos, size_type count, const_reference value)
+		{
+			range_verify(pos);
+			if (count == 0) return iterator(this, pos.get_index());
+
+			if (count > available()) {
+				value_type copy(value); // value may be an element that reserve moves
+				reserve(size_ + count);
+				return insert(pos, count, copy);
+			}
+
+			auto first = create_node(pos.get_index(), value);
+			for (size_type i{ 1 }; i < count; ++i) {
+				create_node(pos.get_index(), value);
+			}
+			return iterator(this, first);
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		iterator insert(const_iterator pos, Iter first, Iter last)
+		{
+			range_verify(pos);
+			if (first == last) return iterator(this, pos.get_index());
+
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>) {
+				reserve(size_ + static_cast<size_type>(std::distance(first, last))); // one grow
+			}
+
+			auto result = create_node(pos.get_index(), *first);
+			for (++first; first != last; ++first) {
+				create_node(pos.get_index(), *first);
+			}
+			return iterator(this, result);
+		}
+
+		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+		{
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+
+		template <class... Args>
+		iterator emplace(const_iterator pos, Args&&... what)
+		{
+			range_verify(pos);
+			return iterator(this, create_node(pos.get_index(), std::forward<Args>(what)...));
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			range_verify(pos);
+			return iterator(this, erase_node(pos.get_index()));
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			range_verify(first);
+			range_verify(last);
+
+			auto index = first.get_index();
+			while (index != last.get_index()) {
+				index = erase_node(index);
+			}
+			return iterator(this, index);
+		}
+
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		template <class... Args>
+		reference emplace_back(Args&&... what)
+		{
+			return value_of(create_node(head_index, std::forward<Args>(what)...));
+		}
+
+		void pop_back() noexcept
+		{
+			assert(size_ != 0 && "pop_back() on empty container");
+			erase_node(node(head_index).prev_);
+		}
+
+		void push_front(const_reference value)
+		{
+			emplace_front(value);
+		}
+
+		void push_front(value_type&& value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		template <class... Args>
+		reference emplace_front(Args&&... what)
+		{
+			return value_of(create_node(next_of(head_index), std::forward<Args>(what)...));
+		}
+
+		void pop_front() noexcept
+		{
+			assert(size_ != 0 && "pop_front() on empty container");
+			erase_node(node(head_index).next_);
+		}
+
+		void resize(size_type new_size)
+		{
+			if (size_ < new_size) {
+				reserve(new_size);
+				while (size_ < new_size) {
+					emplace_back();
+				}
+			}
+			else {
+				while (new_size < size_) {
+					pop_back();
+				}
+			}
+		}
+
+		void resize(size_type new_size, const_reference value)
+		{
+			if (size_ < new_size) {
+				insert(end(), new_size - size_, value);
+			}
+			else {
+				while (new_size < size_) {
+					pop_back();
+				}
+			}
+		}
+
+		// iterators keep pointing to their old list
+		void swap(index_list& rhs) noexcept(node_allocator_traits::propagate_on_container_swap::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this != std::addressof(rhs)) {
+				if constexpr (node_allocator_traits::propagate_on_container_swap::value) {
+					std::swap(allocator_, rhs.allocator_);
+				}
+				else {
+					assert(allocator_ == rhs.allocator_ && "list allocators incompatible for swap");
+				}
+
+				std::swap(nodes_, rhs.nodes_);
+				std::swap(capacity_, rhs.capacity_);
+				std::swap(used_, rhs.used_);
+				std::swap(free_, rhs.free_);
+				std::swap(size_, rhs.size_);
+			}
+		}
+
+		// Operations
+	public:
+		// rhs elements are moved into this list, rhs is empty afterwards
+		template <class Cmp = std::less<value_type>>
+		void merge(index_list& rhs, Cmp cmp = Cmp{})
+		{
+			merge(std::move(rhs), cmp);
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(index_list&& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs) || rhs.size_ == 0) return;
+			assert(std::is_sorted(begin(), end(), cmp) && std::is_sorted(rhs.begin(), rhs.end(), cmp) && "sequence not ordered");
+
+			reserve(size_ + rhs.size_);
+			auto index = next_of(head_index);
+			while (rhs.size_ != 0) {
+				auto rhs_index = rhs.node(head_index).next_;
+				while (index != head_index && !cmp(rhs.value_of(rhs_index), value_of(index))) {
+					index = node(index).next_;
+				}
+				create_node(index, std::move(rhs.value_of(rhs_index)));
+				rhs.erase_node(rhs_index);
+			}
+		}
+
+
+		void splice(const_iterator pos, index_list& rhs)
+		{
+			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, index_list&& rhs)
+		{
+			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, index_list& rhs, const_iterator it)
+		{
+			splice(pos, std::move(rhs), it);
+		}
+
+		void splice(const_iterator pos, index_list&& rhs, const_iterator it)
+		{
+			auto next = it;
+			splice(pos, std::move(rhs), it, ++next);
+		}
+
+		void splice(const_iterator pos, index_list& rhs, const_iterator first, const_iterator last)
+		{
+			splice(pos, std::move(rhs), first, last);
+		}
+
+		// Inside one list the range is relinked in O(1). From another list the values are moved
+		// one by one and their slots freed there, iterators to them become invalid
+		void splice(const_iterator pos, index_list&& rhs, const_iterator first, const_iterator last)
+		{
+			range_verify(pos);
+			rhs.range_verify(first);
+			rhs.range_verify(last);
+			if (first == last) return;
+
+			auto where = pos.get_index();
+			auto begin = first.get_index();
+			auto end = last.get_index();
+			if (this == std::addressof(rhs)) {
+				if (where == end) return; // already there
+
+				auto back = node(end).prev_;
+				node(node(begin).prev_).next_ = end;
+				node(end).prev_ = node(begin).prev_;
+
+				node(begin).prev_ = node(where).prev_;
+				node(node(where).prev_).next_ = begin;
+				node(back).next_ = where;
+				node(where).prev_ = back;
+				return;
+			}
+
+			reserve(size_ + static_cast<size_type>(std::distance(first, last)));
+			while (begin != end) {
+				create_node(where, std::move(rhs.value_of(begin)));
+				begin = rhs.erase_node(begin);
+			}
+		}
+
+
+		void remove(const_reference value)
+		{
+			remove_if([&value](const_reference current) { return current == value; });
+		}
+
+		template <class Predicate>
+		void remove_if(Predicate pred)
+		{
+			for (auto index = next_of(head_index); index != head_index; ) {
+				if (pred(value_of(index))) {
+					index = erase_node(index);
+				}
+				else {
+					index = node(index).next_;
+				}
+			}
+		}
+
+
+		void reverse() noexcept
+		{
+			if (size_ < 2) return;
+
+			auto index = head_index;
+			do {
+				auto& current = node(index);
+				std::swap(current.next_, current.prev_);
+				index = current.prev_; // the old next
+			} while (index != head_index);
+		}
+
+		void unique()
+		{
+			unique(std::equal_to<value_type>{});
+		}
+
+		template <class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			if (size_ < 2) return;
+
+			auto index = node(head_index).next_;
+			while (node(index).next_ != head_index) {
+				auto next = node(index).next_;
+				if (pred(value_of(index), value_of(next))) {
+					erase_node(next);
+				}
+				else {
+					index = next;
+				}
+			}
+		}
+
+		// Stable sort of the indices, then the chain is relinked in that order. Values are not moved,
+		// iterators stay valid. If pred throws, the list is not changed
+		template <class BinaryPred = std::less<value_type>>
+		void sort(BinaryPred pred = BinaryPred{})
+		{
+			if (size_ < 2) return;
+
+			std::vector<index_type> order;
+			order.reserve(size_);
+			for (auto index = node(head_index).next_; index != head_index; index = node(index).next_) {
+				order.push_back(index);
+			}
+			std::stable_sort(order.begin(), order.end(), [this, &pred](index_type lhs, index_type rhs) {
+				return pred(value_of(lhs), value_of(rhs));
+			});
+
+			auto prev = head_index;
+			for (auto index : order) {
+				node(prev).next_ = index;
+				node(index).prev_ = prev;
+				prev = index;
+			}
+			node(prev).next_ = head_index;
+			node(head_index).prev_ = prev;
+		}
+	};
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator==(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator!=(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<=(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>=(const index_list<T, Alloc>& lhs, const index_list<T, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+}
+
+namespace std {
+	template <class T, class Alloc>
+	void swap(my_lib::index_list<T, Alloc>& lhs, my_lib::index_list<T, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
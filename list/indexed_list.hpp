@@ -0,0 +1,1507 @@
+#pragma once
+#ifndef MY_LIB_INDEXED_LIST
+#define MY_LIB_INDEXED_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <initializer_list>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cassert>
+#include "my_utilities.hpp" // my custom library
+#include "link_algorithms.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * indexed_list_const_iterator
+	 * indexed_list_iterator
+	 * indexed_list_node
+	 * indexed_list
+	 *
+	 * indexed_list is a doubly linked list with an order-statistic index: an indexable skip list over the
+	 * same chain. Level 0 is the usual circular chain through the head, so iteration is the one of list.
+	 * About every 4th node has a tower with links to the next node of the higher levels, every link knows
+	 * how many nodes it jumps over (its span). With it nth(k), index_of(it), insert and erase are O(log n),
+	 * and a range of any length is cut or pasted by relinking its towers only, so ranged erase / splice
+	 * keep the size in O(log n) (erase still destroys the elements).
+	 * push_back and pop_front only touch the towers of their node, so they stay O(1) on average:
+	 * the links into the head are never read and the spans of the head store a shift (front_shift_)
+	 * that push_front / pop_front move instead of every level.
+	 * sort, merge, reverse, remove and unique work on level 0 and rebuild the index in O(n).
+	 */
+
+	template <class MyList>
+	class indexed_list_const_iterator
+	{
+		// type aliases
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		using nodeptr = typename MyList::nodeptr;
+		using value_type = typename MyList::value_type;
+		using pointer = typename MyList::const_pointer;
+		using reference = typename MyList::const_reference;
+		using difference_type = typename MyList::difference_type;
+
+	private:
+		nodeptr ptr_; // end() is the head
+
+		// Ctors
+	public:
+		explicit indexed_list_const_iterator(const nodeptr ptr) noexcept : ptr_{ ptr } {}
+
+		indexed_list_const_iterator() noexcept = default;
+
+		// Access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			return MyList::indexed_list_node_type::value_of(ptr_);
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return std::addressof(**this);
+		}
+
+		// Increment / decrement
+	public:
+		indexed_list_const_iterator& operator++() noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			ptr_ = ptr_->next_;
+			return *this;
+		}
+
+		indexed_list_const_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+		indexed_list_const_iterator& operator--() noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			ptr_ = ptr_->prev_;
+			return *this;
+		}
+
+		indexed_list_const_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] bool operator ==(const indexed_list_const_iterator& rhs) const noexcept
+		{
+			return ptr_ == rhs.ptr_;
+		}
+
+		[[nodiscard]] bool operator !=(const indexed_list_const_iterator& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+	public:
+		const nodeptr& get_pointer() const noexcept
+		{
+			return ptr_;
+		}
+	};
+
+	template <class MyList>
+	class indexed_list_iterator : public indexed_list_const_iterator<MyList>
+	{
+	// type aliases
+	public:
+		using mybase			= indexed_list_const_iterator<MyList>;
+		using mybase::mybase; // ctors
+
+		using nodeptr			= typename MyList::nodeptr;
+		using value_type		= typename MyList::value_type;
+		using pointer			= typename MyList::pointer;
+		using reference			= typename MyList::reference;
+		using difference_type	= typename MyList::difference_type;
+
+	// public access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return const_cast<reference>(mybase::operator*());
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return const_cast<pointer>(mybase::operator->());
+		}
+
+	// increment / decrement
+	public:
+		indexed_list_iterator& operator++() noexcept
+		{
+			mybase::operator++();
+			return *this;
+		}
+
+		indexed_list_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+		indexed_list_iterator& operator--() noexcept
+		{
+			mybase::operator--();
+			return *this;
+		}
+
+		indexed_list_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+	// compare
+	public:
+		using mybase::operator==;
+		using mybase::operator!=;
+	};
+
+	// Level 0 links, the head of an indexed_list is a bare indexed_list_node_base
+	template <class Pointer>
+	struct indexed_list_node_base
+	{
+		// type aliases
+		using nodeptr = typename std::pointer_traits<Pointer>::template rebind<indexed_list_node_base>;
+
+		// data
+		nodeptr		next_; // next node
+		nodeptr		prev_; // previous node
+
+		indexed_list_node_base() noexcept : next_{}, prev_{} {}
+
+		indexed_list_node_base(nodeptr next, nodeptr prev) noexcept : next_{ next }, prev_{ prev } {}
+
+		// copying
+		indexed_list_node_base(const indexed_list_node_base&)				= delete;
+		indexed_list_node_base& operator=(const indexed_list_node_base&)	= delete;
+	};
+
+	// A link of the levels above 0: the next node of that level and how many positions it is ahead
+	template <class Pointer>
+	struct indexed_list_link
+	{
+		using nodeptr = typename indexed_list_node_base<Pointer>::nodeptr;
+
+		nodeptr		next_{};
+		std::size_t	span_{};
+	};
+
+	template <class T, class Pointer>
+	struct indexed_list_node : indexed_list_node_base<Pointer>
+	{
+		// type aliases
+		using value_type = T;
+		using node_base = indexed_list_node_base<Pointer>;
+		using nodeptr = typename node_base::nodeptr;
+		using node_pointer = typename std::pointer_traits<Pointer>::template rebind<indexed_list_node>;
+		using link_type = indexed_list_link<Pointer>;
+		using link_pointer = typename std::pointer_traits<Pointer>::template rebind<link_type>;
+
+		// data
+		link_pointer	tower_; // links of the levels 1 .. height_ - 1, null for height_ 1
+		unsigned char	height_;
+		value_type		value_;
+
+		template <class...Args>
+		indexed_list_node(link_pointer tower, unsigned char height, Args&&... args) : node_base{},
+																					   tower_{ tower },
+																					   height_{ height },
+																					   value_{ std::forward<Args>(args)... }{}
+
+		// copying
+		indexed_list_node(const indexed_list_node&)				= delete;
+		indexed_list_node& operator=(const indexed_list_node&)	= delete;
+
+	// Casts, ptr must not be a head
+	public:
+		[[nodiscard]] static value_type& value_of(const nodeptr& ptr) noexcept
+		{
+			return static_cast<indexed_list_node&>(*ptr).value_;
+		}
+
+		[[nodiscard]] static node_pointer as_node(const nodeptr& ptr) noexcept
+		{
+			return std::pointer_traits<node_pointer>::pointer_to(static_cast<indexed_list_node&>(*ptr));
+		}
+
+		[[nodiscard]] static nodeptr as_base(const node_pointer& ptr) noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(static_cast<node_base&>(*ptr));
+		}
+
+		[[nodiscard]] static unsigned height_of(const nodeptr& ptr) noexcept
+		{
+			return static_cast<indexed_list_node&>(*ptr).height_;
+		}
+
+		// link of level (>= 1), it has to be below the height of the node
+		[[nodiscard]] static link_type& link_of(const nodeptr& ptr, std::size_t level) noexcept
+		{
+			return std::addressof(*static_cast<indexed_list_node&>(*ptr).tower_)[level - 1];
+		}
+
+	// Destroy functions
+	public:
+		template <class NodeAlloc>
+		static void free_node(NodeAlloc& allocator, nodeptr ptr) noexcept
+		{
+			using link_allocator = typename std::allocator_traits<NodeAlloc>::template rebind_alloc<link_type>;
+			using link_traits = std::allocator_traits<link_allocator>;
+
+			auto node = as_node(ptr);
+			std::allocator_traits<NodeAlloc>::destroy(allocator, std::addressof(node->value_));
+			if (node->height_ > 1) {
+				link_allocator links{ allocator };
+				auto first = std::addressof(*node->tower_);
+				for (unsigned i{}; i + 1 < node->height_; ++i) {
+					link_traits::destroy(links, first + i);
+				}
+				link_traits::deallocate(links, node->tower_, node->height_ - 1u);
+			}
+			node->node_base::~node_base();
+			std::allocator_traits<NodeAlloc>::deallocate(allocator, node, 1);
+		}
+
+		// frees [first, last) of level 0
+		template <class NodeAlloc>
+		static void free_chain(NodeAlloc& allocator, nodeptr first, const nodeptr last) noexcept
+		{
+			for (nodeptr next; first != last; first = next) {
+				next = first->next_;
+				free_node(allocator, first);
+			}
+		}
+	};
+
+	template <class T, class Alloc = std::allocator<T>>
+	class indexed_list
+	{
+		// type aliases
+	public:
+		// value type aliases
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		// allocator types aliases and node pointer aliases
+		using allocator_type = Alloc;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<indexed_list_node<T, typename std::allocator_traits<Alloc>::void_pointer>>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using indexed_list_node_type = indexed_list_node<T, typename node_allocator_traits::void_pointer>;
+		using node_base = typename indexed_list_node_type::node_base;
+		using nodeptr = typename indexed_list_node_type::nodeptr;
+		using node_pointer = typename node_allocator_traits::pointer;
+		using link_type = typename indexed_list_node_type::link_type;
+		using link_allocator_type = typename node_allocator_traits::template rebind_alloc<link_type>;
+		using link_allocator_traits = std::allocator_traits<link_allocator_type>;
+
+		// iterator aliases
+		using iterator = indexed_list_iterator<indexed_list<T, Alloc>>;
+		using const_iterator = indexed_list_const_iterator<indexed_list<T, Alloc>>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		// 1 in 4 nodes goes up a level, so 16 levels keep the searches short up to 4^16 elements
+		static constexpr size_type max_height{ 16 };
+
+		// list data
+	private:
+		node_allocator_type allocator_;
+		node_base head_; // level 0 sentinel, end()
+		size_type size_{};
+		size_type levels_{ 1 }; // levels in use, at least 1
+
+		// The head as a node of the levels 1 .. levels_ - 1. Its spans are stored plus front_shift_,
+		// so moving every element one position is a change of front_shift_ (unsigned, it wraps)
+		link_type head_links_[max_height - 1]{};
+		nodeptr tails_[max_height - 1]{}; // last node of each level, the head if the level is empty
+		size_type tail_pos_[max_height - 1]{}; // positions of the tails, plus front_shift_ too
+		size_type front_shift_{};
+
+		std::uint64_t seed_{ 0x9E3779B97F4A7C15u }; // xorshift state for the heights
+
+		// position of the head, the positions are unsigned so head + span is the position of its next
+		static constexpr size_type head_pos{ static_cast<size_type>(-1) };
+
+		// the predecessors of a position on every level and their positions
+		struct path
+		{
+			nodeptr pred_[max_height];
+			size_type pos_[max_height];
+		};
+
+		// helpers
+	private:
+		[[nodiscard]] nodeptr head() const noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(const_cast<node_base&>(head_));
+		}
+
+		[[nodiscard]] static reference value_of(const nodeptr& ptr) noexcept
+		{
+			return indexed_list_node_type::value_of(ptr);
+		}
+
+		[[nodiscard]] link_type& link(const nodeptr& node, size_type level) const noexcept
+		{
+			if (node == head()) return const_cast<link_type&>(head_links_[level - 1]);
+			return indexed_list_node_type::link_of(node, level);
+		}
+
+		// span of the link of node on level, the link must not go to the head
+		[[nodiscard]] size_type span(const nodeptr& node, size_type level) const noexcept
+		{
+			auto& lnk = link(node, level);
+			return node == head() ? lnk.span_ - front_shift_ : lnk.span_;
+		}
+
+		void set_link(const nodeptr& node, size_type level, const nodeptr& next, size_type span) noexcept
+		{
+			auto& lnk = link(node, level);
+			lnk.next_ = next;
+			lnk.span_ = node == head() ? span + front_shift_ : span;
+		}
+
+		[[nodiscard]] size_type tail_position(size_type level) const noexcept
+		{
+			auto tail = tails_[level - 1];
+			return tail == head() ? head_pos : tail_pos_[level - 1] - front_shift_;
+		}
+
+		void set_tail(size_type level, const nodeptr& tail, size_type pos) noexcept
+		{
+			tails_[level - 1] = tail;
+			tail_pos_[level - 1] = pos + front_shift_;
+		}
+
+		// moves the tail of level by delta positions if it is a node at or after pos
+		void shift_tail(size_type level, size_type pos, size_type delta) noexcept
+		{
+			if (tails_[level - 1] != head() && tail_position(level) >= pos) {
+				tail_pos_[level - 1] += delta;
+			}
+		}
+
+		void raise_levels(size_type height) noexcept
+		{
+			for (; levels_ < height; ++levels_) {
+				head_links_[levels_ - 1] = { head(), 0 };
+				tails_[levels_ - 1] = head();
+			}
+		}
+
+		// 1 + the number of times a 1 in 4 chance came up
+		[[nodiscard]] unsigned random_height() noexcept
+		{
+			seed_ ^= seed_ << 13;
+			seed_ ^= seed_ >> 7;
+			seed_ ^= seed_ << 17;
+
+			unsigned height{ 1 };
+			for (auto bits = seed_; height < max_height && (bits & 3) == 0; bits >>= 2) {
+				++height;
+			}
+			return height;
+		}
+
+		// Last node of every level before pos
+		[[nodiscard]] path find_path(size_type pos) const noexcept
+		{
+			path result;
+			auto node = head();
+			auto node_pos = head_pos;
+			for (auto level = levels_; level-- > 1; ) {
+				for (;;) {
+					auto& lnk = link(node, level);
+					if (lnk.next_ == head()) break;
+					auto next_pos = node_pos + span(node, level);
+					if (next_pos >= pos) break;
+					node = lnk.next_;
+					node_pos = next_pos;
+				}
+				result.pred_[level] = node;
+				result.pos_[level] = node_pos;
+			}
+
+			for (; node_pos + 1 != pos; ++node_pos) {
+				node = node->next_;
+			}
+			result.pred_[0] = node;
+			result.pos_[0] = node_pos;
+			return result;
+		}
+
+		// the path of size_, no search needed
+		[[nodiscard]] path tail_path() const noexcept
+		{
+			path result;
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				result.pred_[level] = tails_[level - 1];
+				result.pos_[level] = tail_position(level);
+			}
+			result.pred_[0] = head_.prev_;
+			result.pos_[0] = size_ - 1;
+			return result;
+		}
+
+		[[nodiscard]] nodeptr node_at(size_type pos) const noexcept
+		{
+			auto node = head();
+			auto node_pos = head_pos;
+			for (auto level = levels_; level-- > 1; ) {
+				for (;;) {
+					auto& lnk = link(node, level);
+					if (lnk.next_ == head()) break;
+					auto next_pos = node_pos + span(node, level);
+					if (next_pos > pos) break;
+					node = lnk.next_;
+					node_pos = next_pos;
+				}
+			}
+
+			for (; node_pos != pos; ++node_pos) {
+				node = node->next_;
+			}
+			return node;
+		}
+
+		// Walks forward and up to a tail, its position is known
+		[[nodiscard]] size_type position_of(nodeptr node) const noexcept
+		{
+			if (node == head()) return size_;
+
+			size_type distance{};
+			size_type level{};
+			for (;;) {
+				if (level == 0) {
+					if (node == head_.prev_) return size_ - 1 - distance;
+					if (indexed_list_node_type::height_of(node) > 1) {
+						level = 1;
+						continue;
+					}
+					node = node->next_;
+					++distance;
+				}
+				else {
+					if (node == tails_[level - 1]) return tail_position(level) - distance;
+					if (indexed_list_node_type::height_of(node) > level + 1) {
+						++level;
+						continue;
+					}
+					distance += span(node, level);
+					node = link(node, level).next_;
+				}
+			}
+		}
+
+		// allocate and construct the node with a random height, nothing points to it yet
+		template <class... Args>
+		[[nodiscard]] nodeptr create_node(Args&&... args)
+		{
+			auto height = random_height();
+			typename indexed_list_node_type::link_pointer tower{};
+			link_allocator_type links{ allocator_ };
+			if (height > 1) {
+				tower = link_allocator_traits::allocate(links, height - 1);
+				auto first = std::addressof(*tower);
+				for (unsigned i{}; i + 1 < height; ++i) {
+					link_allocator_traits::construct(links, first + i);
+				}
+			}
+
+			node_pointer node{};
+			try {
+				node = allocator_.allocate(1);
+				node_allocator_traits::construct(allocator_, std::addressof(*node), tower, static_cast<unsigned char>(height), std::forward<Args>(args)...);
+			}
+			catch (...) {
+				if (node) {
+					allocator_.deallocate(node, 1);
+				}
+				if (tower) {
+					link_allocator_traits::deallocate(links, tower, height - 1);
+				}
+				throw;
+			}
+			return indexed_list_node_type::as_base(node);
+		}
+
+		void link_level0(const nodeptr prev, const nodeptr node) noexcept
+		{
+			node->prev_ = prev;
+			node->next_ = prev->next_;
+			prev->next_->prev_ = node;
+			prev->next_ = node;
+		}
+
+		void unlink_level0(const nodeptr node) noexcept
+		{
+			node->prev_->next_ = node->next_;
+			node->next_->prev_ = node->prev_;
+		}
+
+		// The only towers touched are the ones of node
+		void link_back(const nodeptr& node) noexcept
+		{
+			auto height = indexed_list_node_type::height_of(node);
+			raise_levels(height);
+			for (size_type level{ 1 }; level < height; ++level) {
+				auto tail = tails_[level - 1];
+				set_link(tail, level, node, size_ - tail_position(level));
+				set_link(node, level, head(), 0);
+				set_tail(level, node, size_);
+			}
+			link_level0(head_.prev_, node);
+			++size_;
+		}
+
+		void link_front(const nodeptr& node) noexcept
+		{
+			auto height = indexed_list_node_type::height_of(node);
+			raise_levels(height);
+			--front_shift_; // every node is one position further now, node takes position 0
+			for (size_type level{ 1 }; level < height; ++level) {
+				auto next = head_links_[level - 1].next_;
+				if (next != head()) {
+					set_link(node, level, next, span(head(), level) - 1);
+				}
+				else {
+					set_link(node, level, head(), 0);
+					set_tail(level, node, 0);
+				}
+				set_link(head(), level, node, 1);
+			}
+			link_level0(head(), node);
+			++size_;
+		}
+
+		void link_at(const nodeptr& node, size_type pos) noexcept
+		{
+			if (pos == size_) return link_back(node);
+			if (pos == 0) return link_front(node);
+
+			auto height = indexed_list_node_type::height_of(node);
+			raise_levels(height);
+			auto preds = find_path(pos);
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				shift_tail(level, pos, 1);
+				auto prev = preds.pred_[level];
+				auto prev_pos = preds.pos_[level];
+				auto next = link(prev, level).next_;
+				if (level < height) {
+					if (next != head()) {
+						set_link(node, level, next, prev_pos + span(prev, level) + 1 - pos);
+					}
+					else {
+						set_link(node, level, head(), 0);
+						set_tail(level, node, pos);
+					}
+					set_link(prev, level, node, pos - prev_pos);
+				}
+				else if (next != head()) {
+					link(prev, level).span_ += 1;
+				}
+			}
+			link_level0(preds.pred_[0], node);
+			++size_;
+		}
+
+		// unlinks the first node and returns it
+		nodeptr unlink_front() noexcept
+		{
+			auto node = head_.next_;
+			auto height = indexed_list_node_type::height_of(node);
+			++front_shift_; // every node is one position closer now
+			for (size_type level{ 1 }; level < height; ++level) {
+				auto& lnk = indexed_list_node_type::link_of(node, level);
+				if (lnk.next_ != head()) {
+					set_link(head(), level, lnk.next_, lnk.span_);
+				}
+				else {
+					set_link(head(), level, head(), 0);
+					tails_[level - 1] = head();
+				}
+			}
+			unlink_level0(node);
+			--size_;
+			return node;
+		}
+
+		// unlinks the node at pos and returns it
+		nodeptr unlink_at(size_type pos) noexcept
+		{
+			if (pos == 0) return unlink_front();
+
+			auto preds = find_path(pos);
+			auto node = preds.pred_[0]->next_;
+			auto height = indexed_list_node_type::height_of(node);
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				shift_tail(level, pos + 1, static_cast<size_type>(-1));
+				auto prev = preds.pred_[level];
+				if (level < height) {
+					auto& lnk = indexed_list_node_type::link_of(node, level);
+					if (lnk.next_ != head()) {
+						set_link(prev, level, lnk.next_, span(prev, level) + lnk.span_ - 1);
+					}
+					else {
+						set_link(prev, level, head(), 0);
+						set_tail(level, prev, preds.pos_[level]);
+					}
+				}
+				else if (link(prev, level).next_ != head()) {
+					link(prev, level).span_ -= 1;
+				}
+			}
+			unlink_level0(node);
+			--size_;
+			return node;
+		}
+
+		// Moves [first, last) (positions, not empty) to the empty list out with the same allocator.
+		// Only the towers at the ends of the range are relinked
+		void cut(size_type first, size_type last, indexed_list& out) noexcept
+		{
+			assert(out.empty() && first < last && last <= size_);
+			auto count = last - first;
+			auto before = find_path(first);
+			auto back = last == size_ ? tail_path() : find_path(last);
+
+			out.raise_levels(levels_);
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				shift_tail(level, last, 0 - count);
+				auto prev = before.pred_[level];
+				auto prev_pos = before.pos_[level];
+				auto last_tower = back.pred_[level];
+				if (prev != last_tower) { // the range has towers on this level
+					auto first_tower = link(prev, level).next_;
+					auto first_pos = prev_pos + span(prev, level);
+					auto last_pos = back.pos_[level];
+					auto next = link(last_tower, level).next_;
+					if (next != head()) {
+						set_link(prev, level, next, last_pos + span(last_tower, level) - count - prev_pos);
+					}
+					else {
+						set_link(prev, level, head(), 0);
+						set_tail(level, prev, prev_pos);
+					}
+
+					out.set_link(out.head(), level, first_tower, first_pos - first + 1);
+					out.set_link(last_tower, level, out.head(), 0);
+					out.set_tail(level, last_tower, last_pos - first);
+				}
+				else if (link(prev, level).next_ != head()) {
+					link(prev, level).span_ -= count;
+				}
+			}
+
+			auto first_node = before.pred_[0]->next_;
+			auto last_node = back.pred_[0];
+			first_node->prev_->next_ = last_node->next_;
+			last_node->next_->prev_ = first_node->prev_;
+			first_node->prev_ = out.head();
+			last_node->next_ = out.head();
+			out.head_.next_ = first_node;
+			out.head_.prev_ = last_node;
+			out.size_ = count;
+			size_ -= count;
+		}
+
+		// Moves every node of rhs (same allocator, not empty) to pos
+		void paste(size_type pos, indexed_list& rhs) noexcept
+		{
+			auto count = rhs.size_;
+			raise_levels(rhs.levels_);
+			auto preds = pos == size_ ? tail_path() : find_path(pos);
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				shift_tail(level, pos, count);
+				auto prev = preds.pred_[level];
+				auto prev_pos = preds.pos_[level];
+				auto next = link(prev, level).next_;
+				if (level < rhs.levels_ && rhs.head_links_[level - 1].next_ != rhs.head()) {
+					auto first_tower = rhs.head_links_[level - 1].next_;
+					auto first_pos = pos + rhs.span(rhs.head(), level) - 1;
+					auto last_tower = rhs.tails_[level - 1];
+					auto last_pos = pos + rhs.tail_position(level);
+					if (next != head()) {
+						set_link(last_tower, level, next, prev_pos + span(prev, level) + count - last_pos);
+					}
+					else {
+						set_link(last_tower, level, head(), 0);
+						set_tail(level, last_tower, last_pos);
+					}
+					set_link(prev, level, first_tower, first_pos - prev_pos);
+				}
+				else if (next != head()) {
+					link(prev, level).span_ += count;
+				}
+			}
+
+			auto prev = preds.pred_[0];
+			rhs.head_.next_->prev_ = prev;
+			rhs.head_.prev_->next_ = prev->next_;
+			prev->next_->prev_ = rhs.head_.prev_;
+			prev->next_ = rhs.head_.next_;
+			size_ += count;
+			rhs.reset();
+		}
+
+		// forgets every node
+		void reset() noexcept
+		{
+			head_.next_ = head();
+			head_.prev_ = head();
+			size_ = 0;
+			levels_ = 1;
+			front_shift_ = 0;
+		}
+
+		// Links the towers again after level 0 was changed, O(n)
+		void rebuild_index() noexcept
+		{
+			front_shift_ = 0;
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				head_links_[level - 1] = { head(), 0 };
+				tails_[level - 1] = head();
+			}
+
+			size_type pos{};
+			for (auto node = head_.next_; node != head(); node = node->next_, ++pos) {
+				auto height = indexed_list_node_type::height_of(node);
+				raise_levels(height); // merged nodes may be higher
+				for (size_type level{ 1 }; level < height; ++level) {
+					set_link(tails_[level - 1], level, node, pos - tail_position(level));
+					set_link(node, level, head(), 0);
+					set_tail(level, node, pos);
+				}
+			}
+			size_ = pos;
+		}
+
+		// Takes the nodes of rhs, this list owns nothing. The links to the old head are moved to head()
+		void take(indexed_list& rhs) noexcept
+		{
+			if (rhs.size_ == 0) return reset();
+
+			head_.next_ = rhs.head_.next_;
+			head_.prev_ = rhs.head_.prev_;
+			head_.next_->prev_ = head();
+			head_.prev_->next_ = head();
+			size_ = rhs.size_;
+			levels_ = rhs.levels_;
+			front_shift_ = rhs.front_shift_;
+			for (size_type level{ 1 }; level < levels_; ++level) {
+				auto& lnk = rhs.head_links_[level - 1];
+				head_links_[level - 1] = { lnk.next_ == rhs.head() ? head() : lnk.next_, lnk.span_ };
+				auto tail = rhs.tails_[level - 1];
+				if (tail != rhs.head()) {
+					tails_[level - 1] = tail;
+					tail_pos_[level - 1] = rhs.tail_pos_[level - 1];
+					indexed_list_node_type::link_of(tail, level).next_ = head();
+				}
+				else {
+					tails_[level - 1] = head();
+				}
+			}
+			rhs.reset();
+		}
+
+		// Ctors and dtor
+	public:
+		indexed_list() noexcept(noexcept(allocator_type{})) : indexed_list(allocator_type{}) {}
+
+		explicit indexed_list(const allocator_type& allocator) noexcept : allocator_{ allocator }
+		{
+			reset();
+		}
+
+		explicit indexed_list(size_type count, const allocator_type& allocator = allocator_type{}) : indexed_list(allocator)
+		{
+			try {
+				for (; count != 0; --count) {
+					emplace_back();
+				}
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		indexed_list(size_type count, const_reference value, const allocator_type& allocator = allocator_type{}) : indexed_list(allocator)
+		{
+			try {
+				for (; count != 0; --count) {
+					push_back(value);
+				}
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		indexed_list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : indexed_list(allocator)
+		{
+			try {
+				for (; first != last; ++first) {
+					emplace_back(*first);
+				}
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		indexed_list(const indexed_list& rhs) : indexed_list(rhs.begin(), rhs.end(), std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.get_allocator())) {}
+
+		indexed_list(const indexed_list& rhs, const allocator_type& allocator) : indexed_list(rhs.begin(), rhs.end(), allocator) {}
+
+		indexed_list(indexed_list&& rhs) noexcept : allocator_{ rhs.allocator_ }
+		{
+			take(rhs);
+		}
+
+		indexed_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type{}) : indexed_list(ilist.begin(), ilist.end(), allocator) {}
+
+		~indexed_list() noexcept
+		{
+			clear();
+		}
+
+		// Member functions (operator=, assign, get_allocator)
+	public:
+		indexed_list& operator=(const indexed_list& rhs)
+		{
+			if (this != std::addressof(rhs)) {
+				assign(rhs.begin(), rhs.end());
+			}
+			return *this;
+		}
+
+		indexed_list& operator=(indexed_list&& rhs) noexcept(node_allocator_traits::propagate_on_container_move_assignment::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this == std::addressof(rhs)) return *this;
+
+			if (allocator_ == rhs.allocator_) {
+				clear();
+				take(rhs);
+			}
+			else if constexpr (node_allocator_traits::propagate_on_container_move_assignment::value) {
+				clear(); // use old allocator to free the storage
+				allocator_ = rhs.allocator_;
+				take(rhs);
+			}
+			else {
+				assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+				rhs.clear();
+			}
+			return *this;
+		}
+
+		indexed_list& operator=(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		// The existing elements are assigned, the rest is erased or appended
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		void assign(Iter first, const Iter last)
+		{
+			auto it = begin();
+			for (; it != end() && first != last; ++it, ++first) {
+				*it = *first;
+			}
+
+			if (first != last) {
+				insert(end(), first, last);
+			}
+			else {
+				erase(it, end());
+			}
+		}
+
+		void assign(size_type count, const_reference value)
+		{
+			auto it = begin();
+			for (; it != end() && count != 0; ++it, --count) {
+				*it = value;
+			}
+
+			if (count != 0) {
+				insert(end(), count, value);
+			}
+			else {
+				erase(it, end());
+			}
+		}
+
+		void assign(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+
+		// Element access
+	public:
+		[[nodiscard]] reference front() noexcept
+		{
+			assert(size_ && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		[[nodiscard]] const_reference front() const noexcept
+		{
+			assert(size_ && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		[[nodiscard]] reference back() noexcept
+		{
+			assert(size_ && "back() on empty container");
+			return value_of(head_.prev_);
+		}
+
+		[[nodiscard]] const_reference back() const noexcept
+		{
+			assert(size_ && "back() on empty container");
+			return value_of(head_.prev_);
+		}
+
+		// O(log n)
+		[[nodiscard]] reference operator[](size_type pos) noexcept
+		{
+			assert(pos < size_ && "index out of range");
+			return value_of(node_at(pos));
+		}
+
+		[[nodiscard]] const_reference operator[](size_type pos) const noexcept
+		{
+			assert(pos < size_ && "index out of range");
+			return value_of(node_at(pos));
+		}
+
+		// Iterator to the element at pos (end() for size()), O(log n)
+		[[nodiscard]] iterator nth(size_type pos) noexcept
+		{
+			assert(pos <= size_ && "index out of range");
+			return iterator{ pos == size_ ? head() : node_at(pos) };
+		}
+
+		[[nodiscard]] const_iterator nth(size_type pos) const noexcept
+		{
+			assert(pos <= size_ && "index out of range");
+			return const_iterator{ pos == size_ ? head() : node_at(pos) };
+		}
+
+		// Position of it (size() for end()), O(log n)
+		[[nodiscard]] size_type index_of(const_iterator it) const noexcept
+		{
+			return position_of(it.get_pointer());
+		}
+
+		// Iterators
+	public:
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator{ head() };
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator{ head() };
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator{ end() };
+		}
+
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator{ end() };
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator{ begin() };
+		}
+
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator{ begin() };
+		}
+
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return rbegin();
+		}
+
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return rend();
+		}
+
+		// Capacity
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size_ == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			auto diff_max = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+			auto alnode_max = static_cast<size_type>(node_allocator_traits::max_size(allocator_));
+			if (diff_max < alnode_max) return diff_max;
+			return alnode_max;
+		}
+
+		// Modifiers
+	public:
+		void clear() noexcept
+		{
+			indexed_list_node_type::free_chain(allocator_, head_.next_, head());
+			reset();
+		}
+
+		iterator insert(const_iterator pos, const_reference value)
+		{
+			return emplace(pos, value);
+		}
+
+		iterator insert(const_iterator pos, value_type&& value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		// The new elements are built aside and pasted at once, if one throws the list is not changed
+		iterator insert(const_iterator pos, size_type count, const_reference value)
+		{
+			if (count == 0) return iterator{ pos.get_pointer() };
+			indexed_list nodes(count, value, get_allocator());
+			auto first = nodes.head_.next_;
+			paste(index_of(pos), nodes);
+			return iterator{ first };
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		iterator insert(const_iterator pos, Iter first, Iter last)
+		{
+			if (first == last) return iterator{ pos.get_pointer() };
+			indexed_list nodes(first, last, get_allocator());
+			auto node = nodes.head_.next_;
+			paste(index_of(pos), nodes);
+			return iterator{ node };
+		}
+
+		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+		{
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+
+		// O(log n)
+		template <class... Args>
+		iterator emplace(const_iterator pos, Args&&... what)
+		{
+			auto where = index_of(pos);
+			auto node = create_node(std::forward<Args>(what)...);
+			link_at(node, where);
+			return iterator{ node };
+		}
+
+		// O(log n)
+		iterator erase(const_iterator pos) noexcept
+		{
+			assert(pos != end() && "cannot erase end iterator");
+			auto next = pos.get_pointer()->next_;
+			indexed_list_node_type::free_node(allocator_, unlink_at(index_of(pos)));
+			return iterator{ next };
+		}
+
+		// The range is cut off in O(log n), then its elements are destroyed
+		iterator erase(const_iterator first, const_iterator last) noexcept
+		{
+			if (first != last) {
+				indexed_list erased{ get_allocator() };
+				cut(index_of(first), index_of(last), erased);
+			}
+			return iterator{ last.get_pointer() };
+		}
+
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// O(1) on average
+		template <class... Args>
+		reference emplace_back(Args&&... what)
+		{
+			auto node = create_node(std::forward<Args>(what)...);
+			link_back(node);
+			return value_of(node);
+		}
+
+		// O(log n), the predecessors on the tower levels are searched
+		void pop_back() noexcept
+		{
+			assert(size_ && "cannot pop on empty container");
+			indexed_list_node_type::free_node(allocator_, unlink_at(size_ - 1));
+		}
+
+		void push_front(const_reference value)
+		{
+			emplace_front(value);
+		}
+
+		void push_front(value_type&& value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		// O(1) on average
+		template <class... Args>
+		reference emplace_front(Args&&... what)
+		{
+			auto node = create_node(std::forward<Args>(what)...);
+			link_front(node);
+			return value_of(node);
+		}
+
+		// O(1) on average
+		void pop_front() noexcept
+		{
+			assert(size_ && "cannot pop on empty container");
+			indexed_list_node_type::free_node(allocator_, unlink_front());
+		}
+
+		void resize(size_type new_size)
+		{
+			if (new_size < size_) {
+				erase(nth(new_size), end());
+			}
+			else {
+				indexed_list nodes(new_size - size_, get_allocator());
+				if (!nodes.empty()) {
+					paste(size_, nodes);
+				}
+			}
+		}
+
+		void resize(size_type new_size, const_reference value)
+		{
+			if (new_size < size_) {
+				erase(nth(new_size), end());
+			}
+			else {
+				insert(end(), new_size - size_, value);
+			}
+		}
+
+		void swap(indexed_list& rhs) noexcept(node_allocator_traits::propagate_on_container_swap::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this != std::addressof(rhs)) {
+				if constexpr (node_allocator_traits::propagate_on_container_swap::value) {
+					std::swap(allocator_, rhs.allocator_);
+				}
+				else {
+					assert(allocator_ == rhs.allocator_ && "list allocators incompatible for swap");
+				}
+
+				indexed_list tmp{ get_allocator() };
+				tmp.take(*this);
+				take(rhs);
+				rhs.take(tmp);
+			}
+		}
+
+		// Operations
+	public:
+		template <class Cmp = std::less<value_type>>
+		void merge(indexed_list& rhs, Cmp cmp = Cmp{})
+		{
+			merge(std::move(rhs), cmp);
+		}
+
+		// O(n + m), the index is built again
+		template <class Cmp = std::less<value_type>>
+		void merge(indexed_list&& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs) || rhs.empty()) return;
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for merge");
+			assert(std::is_sorted(begin(), end(), cmp) && std::is_sorted(rhs.begin(), rhs.end(), cmp) && "sequence not ordered");
+
+			if (empty()) {
+				take(rhs);
+				return;
+			}
+
+			auto node_cmp = [&cmp](const nodeptr& lhs, const nodeptr& rhs) { return cmp(value_of(lhs), value_of(rhs)); };
+			auto node = detail::unchecked_merge(head_.next_, head_.prev_, rhs.head_.next_, rhs.head_.prev_, node_cmp);
+			head_.prev_ = node;
+			node->next_ = head();
+			rhs.reset();
+			rebuild_index();
+		}
+
+
+		void splice(const_iterator pos, indexed_list& rhs) noexcept
+		{
+			splice(pos, std::move(rhs));
+		}
+
+		// O(log n)
+		void splice(const_iterator pos, indexed_list&& rhs) noexcept
+		{
+			if (this == std::addressof(rhs) || rhs.empty()) return;
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+			paste(index_of(pos), rhs);
+		}
+
+		void splice(const_iterator pos, indexed_list& rhs, const_iterator it) noexcept
+		{
+			splice(pos, std::move(rhs), it);
+		}
+
+		void splice(const_iterator pos, indexed_list&& rhs, const_iterator it) noexcept
+		{
+			assert(it != rhs.end() && "cannot splice end iterator");
+			splice(pos, std::move(rhs), it, std::next(it));
+		}
+
+		void splice(const_iterator pos, indexed_list& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			splice(pos, std::move(rhs), first, last);
+		}
+
+		// O(log n) for any length: the range is cut off and pasted by its towers
+		void splice(const_iterator pos, indexed_list&& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			if (first == last) return;
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+
+			auto range_first = rhs.index_of(first);
+			auto range_last = rhs.index_of(last);
+			indexed_list range{ get_allocator() };
+			if (this == std::addressof(rhs)) {
+				auto where = index_of(pos);
+				assert((where <= range_first || where >= range_last) && "splice position inside the range");
+				if (where == range_first || where == range_last) return;
+
+				cut(range_first, range_last, range);
+				paste(where < range_first ? where : where - (range_last - range_first), range);
+			}
+			else {
+				rhs.cut(range_first, range_last, range);
+				paste(index_of(pos), range);
+			}
+		}
+
+
+		void remove(const_reference value)
+		{
+			remove_if([&value](const_reference current) { return current == value; });
+		}
+
+		// The removed nodes are freed after the last call of pred, so value may be one of them
+		template <class Predicate>
+		void remove_if(Predicate pred)
+		{
+			node_base removed{ nodeptr{}, nodeptr{} };
+			auto removed_back = std::pointer_traits<nodeptr>::pointer_to(removed);
+			try {
+				for (auto node = head_.next_; node != head(); ) {
+					auto next = node->next_;
+					if (pred(value_of(node))) {
+						unlink_level0(node);
+						removed_back->next_ = node;
+						removed_back = node;
+					}
+					node = next;
+				}
+			}
+			catch (...) {
+				removed_back->next_ = nodeptr{};
+				rebuild_index();
+				indexed_list_node_type::free_chain(allocator_, removed.next_, nodeptr{});
+				throw;
+			}
+			removed_back->next_ = nodeptr{};
+			if (removed.next_) {
+				rebuild_index();
+				indexed_list_node_type::free_chain(allocator_, removed.next_, nodeptr{});
+			}
+		}
+
+
+		void reverse() noexcept
+		{
+			if (size_ < 2) return;
+			detail::reverse_chain(head());
+			rebuild_index();
+		}
+
+		void unique()
+		{
+			unique(std::equal_to<value_type>{});
+		}
+
+		template <class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			if (size_ < 2) return;
+
+			node_base removed{ nodeptr{}, nodeptr{} };
+			auto removed_back = std::pointer_traits<nodeptr>::pointer_to(removed);
+			try {
+				for (auto node = head_.next_; node->next_ != head(); ) {
+					auto next = node->next_;
+					if (pred(value_of(node), value_of(next))) {
+						unlink_level0(next);
+						removed_back->next_ = next;
+						removed_back = next;
+					}
+					else {
+						node = next;
+					}
+				}
+			}
+			catch (...) {
+				removed_back->next_ = nodeptr{};
+				rebuild_index();
+				indexed_list_node_type::free_chain(allocator_, removed.next_, nodeptr{});
+				throw;
+			}
+			removed_back->next_ = nodeptr{};
+			if (removed.next_) {
+				rebuild_index();
+				indexed_list_node_type::free_chain(allocator_, removed.next_, nodeptr{});
+			}
+		}
+
+		// Bottom-up merge sort (detail::sort_chain) of level 0, then the index is built again
+		template <class BinaryPred = std::less<value_type>>
+		void sort(BinaryPred pred = BinaryPred{})
+		{
+			if (size_ < 2) return;
+
+			auto node_pred = [&pred](const nodeptr& lhs, const nodeptr& rhs) { return pred(value_of(lhs), value_of(rhs)); };
+			detail::sort_chain(head(), node_pred);
+			rebuild_index();
+		}
+	};
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator==(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator!=(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator<=(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class T, class Alloc>
+	[[nodiscard]] bool operator>=(const indexed_list<T, Alloc>& lhs, const indexed_list<T, Alloc>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+}
+
+namespace std {
+	template <class T, class Alloc>
+	void swap(my_lib::indexed_list<T, Alloc>& lhs, my_lib::indexed_list<T, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,661 @@
+#pragma once
+#ifndef MY_LIB_INTRUSIVE_LIST
+#define MY_LIB_INTRUSIVE_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <functional>
+#include <cassert>
+#include "link_algorithms.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * list_hook
+	 * intrusive_list_const_iterator
+	 * intrusive_list_iterator
+	 * intrusive_list
+	 *
+	 * intrusive_list<T, &T::hook> links objects through a list_hook member embedded in them: no allocation,
+	 * no copies, and an object can sit in several lists at once (one hook per list).
+	 * The list never owns its elements. They must outlive their membership, clear() and the dtor only unlink them.
+	 */
+
+	// next_ / prev_ of an object in an intrusive_list, nullptr when not linked.
+	// Copying an object does not copy its membership: a copied hook is unlinked, assignment keeps the links
+	struct list_hook
+	{
+		list_hook* next_{};
+		list_hook* prev_{};
+
+		list_hook() noexcept = default;
+		list_hook(const list_hook&) noexcept {}
+
+		list_hook& operator=(const list_hook&) noexcept
+		{
+			return *this;
+		}
+
+		~list_hook() noexcept
+		{
+			assert(!is_linked() && "object destroyed while linked in an intrusive_list");
+		}
+
+		[[nodiscard]] bool is_linked() const noexcept
+		{
+			return next_ != nullptr;
+		}
+	};
+
+	template <class MyList>
+	class intrusive_list_const_iterator
+	{
+		// type aliases
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		using nodeptr = typename MyList::nodeptr;
+		using value_type = typename MyList::value_type;
+		using pointer = typename MyList::const_pointer;
+		using reference = typename MyList::const_reference;
+		using difference_type = typename MyList::difference_type;
+
+	private:
+		nodeptr ptr_;
+
+		// Ctors
+	public:
+		explicit intrusive_list_const_iterator(const nodeptr ptr) noexcept : ptr_{ ptr } {}
+
+		intrusive_list_const_iterator() noexcept = default;
+
+		// Access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			return MyList::value_of(ptr_);
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return std::addressof(**this);
+		}
+
+		// Increment / decrement
+	public:
+		intrusive_list_const_iterator& operator++() noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			ptr_ = ptr_->next_;
+			return *this;
+		}
+
+		intrusive_list_const_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		intrusive_list_const_iterator& operator--() noexcept
+		{
+			assert(ptr_ && "value-initialized iterator");
+			ptr_ = ptr_->prev_;
+			return *this;
+		}
+
+		intrusive_list_const_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] bool operator ==(const intrusive_list_const_iterator& rhs) const noexcept
+		{
+			return ptr_ == rhs.ptr_;
+		}
+
+		[[nodiscard]] bool operator !=(const intrusive_list_const_iterator& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+	public:
+		const nodeptr& get_pointer() const noexcept
+		{
+			return ptr_;
+		}
+	};
+
+	template <class MyList>
+	class intrusive_list_iterator : public intrusive_list_const_iterator<MyList>
+	{
+	// type aliases
+	public:
+		using mybase			= intrusive_list_const_iterator<MyList>;
+		using mybase::mybase; // ctors
+
+		using nodeptr			= typename MyList::nodeptr;
+		using value_type		= typename MyList::value_type;
+		using pointer			= typename MyList::pointer;
+		using reference			= typename MyList::reference;
+		using difference_type	= typename MyList::difference_type;
+
+	// public access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return const_cast<reference>(mybase::operator*());
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return const_cast<pointer>(mybase::operator->());
+		}
+
+	// increment / decrement
+	public:
+		intrusive_list_iterator& operator++() noexcept
+		{
+			mybase::operator++();
+			return *this;
+		}
+
+		intrusive_list_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		intrusive_list_iterator& operator--() noexcept
+		{
+			mybase::operator--();
+			return *this;
+		}
+
+		intrusive_list_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+	// compare
+	public:
+		using mybase::operator==;
+		using mybase::operator!=;
+	};
+
+	template <class T, list_hook T::* Hook>
+	class intrusive_list
+	{
+		friend class intrusive_list_const_iterator<intrusive_list>;
+
+		// type aliases
+	public:
+		using value_type = T;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		using nodeptr = list_hook*;
+
+		using iterator = intrusive_list_iterator<intrusive_list>;
+		using const_iterator = intrusive_list_const_iterator<intrusive_list>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	private:
+		list_hook head_; // sentinel, points to itself when empty
+		size_type size_{};
+
+		// Ctors
+	public:
+		intrusive_list() noexcept
+		{
+			head_.next_ = &head_;
+			head_.prev_ = &head_;
+		}
+
+		// copying would link one object into two lists through the same hook
+		intrusive_list(const intrusive_list&)				= delete;
+		intrusive_list& operator=(const intrusive_list&)	= delete;
+
+		// the elements are taken over, their first and last hooks are pointed at the new head
+		intrusive_list(intrusive_list&& rhs) noexcept : intrusive_list()
+		{
+			take(rhs);
+		}
+
+		intrusive_list& operator=(intrusive_list&& rhs) noexcept
+		{
+			if (this != std::addressof(rhs)) {
+				clear();
+				take(rhs);
+			}
+			return *this;
+		}
+
+		~intrusive_list() noexcept
+		{
+			clear();
+			head_.next_ = nullptr;
+			head_.prev_ = nullptr;
+		}
+
+		// helpers
+	private:
+		// the hook sits at the same offset in every T, T is never constructed here
+		[[nodiscard]] static std::ptrdiff_t hook_offset() noexcept
+		{
+			alignas(T) unsigned char object[sizeof(T)];
+			auto ptr = reinterpret_cast<T*>(object);
+			return reinterpret_cast<unsigned char*>(std::addressof(ptr->*Hook)) - object;
+		}
+
+		[[nodiscard]] static reference value_of(nodeptr node) noexcept
+		{
+			return *reinterpret_cast<pointer>(reinterpret_cast<unsigned char*>(node) - hook_offset());
+		}
+
+		[[nodiscard]] static nodeptr hook_of(const_reference value) noexcept
+		{
+			return const_cast<nodeptr>(std::addressof(value.*Hook));
+		}
+
+		void take(intrusive_list& rhs) noexcept
+		{
+			if (rhs.size_ == 0) return;
+
+			head_.next_ = rhs.head_.next_;
+			head_.prev_ = rhs.head_.prev_;
+			head_.next_->prev_ = &head_;
+			head_.prev_->next_ = &head_;
+			size_ = rhs.size_;
+
+			rhs.head_.next_ = &rhs.head_;
+			rhs.head_.prev_ = &rhs.head_;
+			rhs.size_ = 0;
+		}
+
+		void link_before(nodeptr where, reference value) noexcept
+		{
+			auto node = hook_of(value);
+			assert(!node->is_linked() && "object already linked, use another hook for a second list");
+
+			node->next_ = where;
+			node->prev_ = where->prev_;
+			where->prev_->next_ = node;
+			where->prev_ = node;
+			++size_;
+		}
+
+		nodeptr unlink(nodeptr node) noexcept
+		{
+			assert(node != &head_ && "cannot erase end iterator");
+			assert(node->is_linked() && "object not linked");
+
+			auto next = node->next_;
+			node->prev_->next_ = next;
+			next->prev_ = node->prev_;
+			node->next_ = nullptr;
+			node->prev_ = nullptr;
+			--size_;
+			return next;
+		}
+
+		// Element access
+	public:
+		[[nodiscard]] reference front() noexcept
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		[[nodiscard]] const_reference front() const noexcept
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return value_of(head_.next_);
+		}
+
+		[[nodiscard]] reference back() noexcept
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return value_of(head_.prev_);
+		}
+
+		[[nodiscard]] const_reference back() const noexcept
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return value_of(head_.prev_);
+		}
+
+		// Iterators
+	public:
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator{ head_.next_ };
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator{ &head_ };
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator{ const_cast<nodeptr>(&head_) };
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator{ end() };
+		}
+
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator{ end() };
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator{ begin() };
+		}
+
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator{ begin() };
+		}
+
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return rbegin();
+		}
+
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return rend();
+		}
+
+		// Iterator to an object that is linked in this list, O(1)
+		[[nodiscard]] iterator iterator_to(reference value) noexcept
+		{
+			assert(hook_of(value)->is_linked() && "object not linked");
+			return iterator{ hook_of(value) };
+		}
+
+		[[nodiscard]] const_iterator iterator_to(const_reference value) const noexcept
+		{
+			assert(hook_of(value)->is_linked() && "object not linked");
+			return const_iterator{ hook_of(value) };
+		}
+
+		// Capacity
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size_ == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			return static_cast<size_type>(std::numeric_limits<difference_type>::max());
+		}
+
+		// Modifiers
+	public:
+		// unlinks every element, nothing is destroyed
+		void clear() noexcept
+		{
+			auto node = head_.next_;
+			while (node != &head_) {
+				auto next = node->next_;
+				node->next_ = nullptr;
+				node->prev_ = nullptr;
+				node = next;
+			}
+
+			head_.next_ = &head_;
+			head_.prev_ = &head_;
+			size_ = 0;
+		}
+
+		iterator insert(const_iterator pos, reference value) noexcept
+		{
+			link_before(pos.get_pointer(), value);
+			return iterator{ hook_of(value) };
+		}
+
+		template <class Iter>
+		iterator insert(const_iterator pos, Iter first, Iter last) noexcept
+		{
+			auto where = pos.get_pointer();
+			auto prev = where->prev_;
+			for (; first != last; ++first) {
+				link_before(where, *first);
+			}
+			return iterator{ prev->next_ };
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			return iterator{ unlink(pos.get_pointer()) };
+		}
+
+		iterator erase(const_iterator first, const_iterator last) noexcept
+		{
+			auto node = first.get_pointer();
+			auto end = last.get_pointer();
+			while (node != end) {
+				node = unlink(node);
+			}
+			return iterator{ end };
+		}
+
+		void push_back(reference value) noexcept
+		{
+			link_before(&head_, value);
+		}
+
+		void push_front(reference value) noexcept
+		{
+			link_before(head_.next_, value);
+		}
+
+		void pop_back() noexcept
+		{
+			assert(size_ != 0 && "pop_back() on empty container");
+			unlink(head_.prev_);
+		}
+
+		void pop_front() noexcept
+		{
+			assert(size_ != 0 && "pop_front() on empty container");
+			unlink(head_.next_);
+		}
+
+		void swap(intrusive_list& rhs) noexcept
+		{
+			if (this == std::addressof(rhs)) return;
+
+			intrusive_list tmp{ std::move(rhs) };
+			rhs.take(*this);
+			take(tmp);
+		}
+
+		// Operations
+	public:
+		// Unlinks value from this list in O(1), no search
+		void remove(reference value) noexcept
+		{
+			unlink(hook_of(value));
+		}
+
+		template <class Predicate>
+		void remove_if(Predicate pred)
+		{
+			auto node = head_.next_;
+			while (node != &head_) {
+				if (pred(value_of(node))) {
+					node = unlink(node);
+				}
+				else {
+					node = node->next_;
+				}
+			}
+		}
+
+		void unique()
+		{
+			unique(std::equal_to<value_type>{});
+		}
+
+		template <class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			if (size_ < 2) return;
+
+			auto node = head_.next_;
+			while (node->next_ != &head_) {
+				if (pred(value_of(node), value_of(node->next_))) {
+					unlink(node->next_);
+				}
+				else {
+					node = node->next_;
+				}
+			}
+		}
+
+		void splice(const_iterator pos, intrusive_list& rhs) noexcept
+		{
+			splice(pos, rhs, rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, intrusive_list&& rhs) noexcept
+		{
+			splice(pos, rhs);
+		}
+
+		void splice(const_iterator pos, intrusive_list& rhs, const_iterator it) noexcept
+		{
+			auto where = pos.get_pointer();
+			auto what = it.get_pointer();
+			assert(what != &rhs.head_ && "cannot splice end iterator");
+			if (where == what || where == what->next_) return;
+
+			detail::unchecked_splice(what, what->next_, where);
+			--rhs.size_;
+			++size_;
+		}
+
+		void splice(const_iterator pos, intrusive_list&& rhs, const_iterator it) noexcept
+		{
+			splice(pos, rhs, it);
+		}
+
+		void splice(const_iterator pos, intrusive_list& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			auto begin = first.get_pointer();
+			auto end = last.get_pointer();
+			if (begin == end) return;
+
+			if (this != std::addressof(rhs)) {
+				auto count = static_cast<size_type>(std::distance(first, last));
+				rhs.size_ -= count;
+				size_ += count;
+			}
+			detail::unchecked_splice(begin, end, pos.get_pointer());
+		}
+
+		void splice(const_iterator pos, intrusive_list&& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			splice(pos, rhs, first, last);
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(intrusive_list& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs) || rhs.size_ == 0) return;
+
+			if (size_ == 0) {
+				take(rhs);
+				return;
+			}
+
+			auto node_cmp = [&cmp](nodeptr lhs, nodeptr rhs) { return cmp(value_of(lhs), value_of(rhs)); };
+			auto node = detail::unchecked_merge(head_.next_, head_.prev_, rhs.head_.next_, rhs.head_.prev_, node_cmp);
+
+			head_.prev_ = node;
+			node->next_ = &head_;
+			size_ += rhs.size_;
+
+			rhs.head_.next_ = &rhs.head_;
+			rhs.head_.prev_ = &rhs.head_;
+			rhs.size_ = 0;
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(intrusive_list&& rhs, Cmp cmp = Cmp{})
+		{
+			merge(rhs, cmp);
+		}
+
+		// Stable bottom-up merge sort, only hooks are relinked
+		template <class BinaryPred = std::less<value_type>>
+		void sort(BinaryPred pred = BinaryPred{})
+		{
+			if (size_ < 2) return;
+
+			auto node_pred = [&pred](nodeptr lhs, nodeptr rhs) { return pred(value_of(lhs), value_of(rhs)); };
+			detail::sort_chain(&head_, node_pred);
+		}
+
+		void reverse() noexcept
+		{
+			if (size_ < 2) return;
+			detail::reverse_chain(&head_);
+		}
+	};
+
+	template <class T, list_hook T::* Hook>
+	void swap(intrusive_list<T, Hook>& lhs, intrusive_list<T, Hook>& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,281 @@
+#pragma once
+#ifndef MY_LIB_LINK_ALGORITHMS
+#define MY_LIB_LINK_ALGORITHMS
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h> // _mm_prefetch
+#endif
+
+namespace my_lib
+{
+	/*
+	 * Algorithms on circular doubly linked chains, shared by the list containers.
+	 * A node is anything with next_ and prev_ members; the chain is closed by a head node.
+	 * The forward_ ones work on null terminated singly linked chains (only next_), for forward_list.
+	 * Comparators take two node pointers.
+	 * The walk_ kernels visit the nodes of a chain with software prefetch (see walk_from_both_ends).
+	 */
+	namespace detail
+	{
+		// Moves [first, last) before where (it may be another chain), last is not moved.
+		// An empty range or where == first / last (the range is already there) is a no-op, the relinking would break the chain
+		template <class Nodeptr>
+		void unchecked_splice(Nodeptr first, Nodeptr last, Nodeptr where) noexcept
+		{
+			if (first == last || where == first || where == last) return;
+
+			first->prev_->next_ = last;
+			auto tmp = first->prev_;
+
+			where->prev_->next_ = first;
+			first->prev_ = where->prev_;
+			where->prev_ = last->prev_;
+			last->prev_->next_ = where;
+
+			last->prev_ = tmp;
+		}
+
+		// Merges sorted chains [lhsfirst, lhsback] and [rhsfirst, rhsback] (both not empty) after lhsfirst->prev_.
+		// The rest of the chain that is left is linked at once. Returns the last node, its next_ is not set
+		template <class Nodeptr, class NodeCmp>
+		Nodeptr unchecked_merge(Nodeptr lhsfirst, const Nodeptr lhsback, Nodeptr rhsfirst, const Nodeptr rhsback, NodeCmp& cmp)
+		{
+			auto node = lhsfirst->prev_;
+			for (;;) {
+				if (cmp(rhsfirst, lhsfirst)) { // lhs goes first on equal, so merge is stable
+					node->next_ = rhsfirst;
+					rhsfirst->prev_ = node;
+					node = rhsfirst;
+					if (rhsfirst == rhsback) {
+						node->next_ = lhsfirst;
+						lhsfirst->prev_ = node;
+						return lhsback;
+					}
+					rhsfirst = rhsfirst->next_;
+				}
+				else {
+					node->next_ = lhsfirst;
+					lhsfirst->prev_ = node;
+					node = lhsfirst;
+					if (lhsfirst == lhsback) {
+						node->next_ = rhsfirst;
+						rhsfirst->prev_ = node;
+						return rhsback;
+					}
+					lhsfirst = lhsfirst->next_;
+				}
+			}
+		}
+
+		// sorted chain [first_, back_], next_ of back_ is not used
+		template <class Nodeptr>
+		struct sort_run
+		{
+			Nodeptr first_;
+			Nodeptr back_;
+		};
+
+		template <class Nodeptr, class NodeCmp>
+		sort_run<Nodeptr> merge_runs(Nodeptr head, const sort_run<Nodeptr>& lhs, const sort_run<Nodeptr>& rhs, NodeCmp& cmp)
+		{
+			lhs.first_->prev_ = head; // head is free during the sort, it is used as the anchor of the merge
+			auto back = unchecked_merge(lhs.first_, lhs.back_, rhs.first_, rhs.back_, cmp);
+			return { head->next_, back };
+		}
+
+		// Bottom-up merge sort of the chain closed by head: bins[i] is either empty or holds a sorted run
+		// of 2^i nodes. Nodes are taken one by one and carried through the bins like a binary counter.
+		// Stable, no recursion, only links are changed
+		template <class Nodeptr, class NodeCmp>
+		void sort_chain(Nodeptr head, NodeCmp& cmp)
+		{
+			if (head->next_ == head->prev_) return; // 0 or 1 node
+
+			constexpr auto max_bins = static_cast<std::size_t>(std::numeric_limits<std::size_t>::digits);
+			sort_run<Nodeptr> bins[max_bins]{};
+			std::size_t used{}; // bins in use
+
+			for (auto node = head->next_; node != head; ) {
+				sort_run<Nodeptr> carry{ node, node };
+				node = node->next_;
+
+				std::size_t i{};
+				for (; i < used && bins[i].first_; ++i) {
+					carry = merge_runs(head, bins[i], carry, cmp); // bins[i] holds the earlier nodes
+					bins[i].first_ = nullptr;
+				}
+
+				bins[i] = carry;
+				if (i == used) {
+					++used;
+				}
+			}
+
+			sort_run<Nodeptr> result{};
+			for (std::size_t i{}; i < used; ++i) {
+				if (bins[i].first_) {
+					result = result.first_ ? merge_runs(head, bins[i], result, cmp) : bins[i];
+				}
+			}
+
+			head->next_ = result.first_;
+			result.first_->prev_ = head;
+			head->prev_ = result.back_;
+			result.back_->next_ = head;
+		}
+
+		// Merges two sorted null terminated chains and returns the first node. Stable: on ties lhs goes first
+		template <class Nodeptr, class NodeCmp>
+		[[nodiscard]] Nodeptr forward_merge(Nodeptr lhs, Nodeptr rhs, NodeCmp& cmp)
+		{
+			Nodeptr first{};
+			Nodeptr tail{};
+			while (lhs && rhs) {
+				Nodeptr node;
+				if (cmp(rhs, lhs)) {
+					node = rhs;
+					rhs = rhs->next_;
+				}
+				else {
+					node = lhs;
+					lhs = lhs->next_;
+				}
+
+				if (tail) {
+					tail->next_ = node;
+				}
+				else {
+					first = node;
+				}
+				tail = node;
+			}
+
+			auto rest = lhs ? lhs : rhs;
+			if (tail) {
+				tail->next_ = rest;
+				return first;
+			}
+			return rest;
+		}
+
+		// Bottom-up merge sort of a null terminated chain, same bins as sort_chain. Returns the new first node
+		template <class Nodeptr, class NodeCmp>
+		[[nodiscard]] Nodeptr forward_sort_chain(Nodeptr first, NodeCmp& cmp)
+		{
+			constexpr auto max_bins = static_cast<std::size_t>(std::numeric_limits<std::size_t>::digits);
+			Nodeptr bins[max_bins]{};
+			std::size_t used{};
+
+			while (first) {
+				auto carry = first;
+				first = first->next_;
+				carry->next_ = Nodeptr{};
+
+				std::size_t i{};
+				for (; i < used && bins[i]; ++i) {
+					carry = forward_merge(bins[i], carry, cmp); // bins[i] holds the earlier nodes
+					bins[i] = Nodeptr{};
+				}
+
+				bins[i] = carry;
+				if (i == used) {
+					++used;
+				}
+			}
+
+			Nodeptr result{};
+			for (std::size_t i{}; i < used; ++i) {
+				if (bins[i]) {
+					result = result ? forward_merge(bins[i], result, cmp) : bins[i];
+				}
+			}
+			return result;
+		}
+
+		// Asks the cache for the node, only a hint
+		template <class Nodeptr>
+		void prefetch_node(const Nodeptr& ptr) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(static_cast<const void*>(std::addressof(*ptr)));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_prefetch(reinterpret_cast<const char*>(std::addressof(*ptr)), _MM_HINT_T0);
+#endif
+		}
+
+		// Visits [first, last) in order until visit(node) returns true, returns that node (last if none).
+		// The next node is read and prefetched before the visit, so visit may unlink or free its node.
+		// On scattered nodes the chase is still serial: a prefetch cannot know a node before its
+		// predecessor is loaded, it only starts the load before the visit works
+		template <class Nodeptr, class Visit>
+		Nodeptr walk_forward(Nodeptr first, const Nodeptr last, Visit visit)
+		{
+			while (first != last) {
+				auto next = first->next_;
+				prefetch_node(next);
+				if (visit(first)) return first;
+				first = next;
+			}
+			return last;
+		}
+
+		// Visits the nodes of [first, last) with two cursors, one from each end (the back one starts at last->prev_),
+		// until they meet or a visit returns true. The two chases do not depend on each other, so on scattered nodes
+		// their cache misses overlap: about twice the speed of walk_forward. For work where the order does not
+		// matter. front_visit gets the nodes of the first half in order (and the middle one), back_visit the
+		// rest from the back. Like walk_forward the neighbours are read first, a visit may free its node.
+		// Returns the number of nodes visited
+		template <class Nodeptr, class FrontVisit, class BackVisit>
+		std::size_t walk_from_both_ends(const Nodeptr first, const Nodeptr last, FrontVisit front_visit, BackVisit back_visit)
+		{
+			auto front = first;
+			auto back = last->prev_;
+			if (front == last) return 0;
+
+			std::size_t visited{};
+			for (;;) {
+				if (front == back) {
+					front_visit(front);
+					return visited + 1;
+				}
+
+				auto next = front->next_;
+				auto prev = back->prev_;
+				prefetch_node(next);
+				prefetch_node(prev);
+				auto last_pair = next == back;
+				if (front_visit(front)) return visited + 1;
+				if (back_visit(back) || last_pair) return visited + 2;
+				visited += 2;
+				front = next;
+				back = prev;
+			}
+		}
+
+		// The whole chain closed by head
+		template <class Nodeptr, class FrontVisit, class BackVisit>
+		std::size_t walk_from_both_ends(const Nodeptr head, FrontVisit front_visit, BackVisit back_visit)
+		{
+			return walk_from_both_ends(head->next_, head, std::move(front_visit), std::move(back_visit));
+		}
+
+		// Reverses the chain closed by head
+		template <class Nodeptr>
+		void reverse_chain(Nodeptr head) noexcept
+		{
+			auto node = head;
+			do {
+				auto next = node->next_;
+				node->next_ = node->prev_;
+				node->prev_ = next;
+				node = next;
+			} while (node != head);
+		}
+	}
+}
+
+#endif
@@ -10,7 +10,11 @@
 #include <initializer_list>
 #include <limits>
 #include <cassert>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include "my_utilities.hpp" // my custom library
+#include "link_algorithms.hpp"
 
 // Check for C++17
 #ifdef _HAS_CXX17
@@ -30,17 +34,105 @@ namespace my_lib
 {
 	/* 
 	 * Structure of this file: 
+	 * checked_iterators / unchecked_iterators
+	 * eager_size / lazy_size
+	 * no_stats / collect_stats
+	 * list_owner_tag
 	 * list_const_iterator
 	 * list_iterator 
 	 * list_node
+	 * list_node_handle
 	 * list 
 	 */
-	
-	 // Probably there are also will be a unchecked iterators 
+
+	// Iterator checking policies (the third template argument of my_lib::list).
+	// Checked: every node and iterator carries the head of its list, so the validity checks are O(1).
+	// Unchecked: iterator is a bare node pointer and the node has no tag.
+	struct checked_iterators
+	{
+		constexpr static bool enabled{ true };
+	};
+
+	struct unchecked_iterators
+	{
+		constexpr static bool enabled{ false };
+	};
+
+	// Fixed, not picked by NDEBUG: my_lib::list<int> must be the same type in debug and release translation units
+	// (else linking them together is an ODR violation). Ask for checked_iterators to get the checks
+	using default_iterator_checking = unchecked_iterators;
+
+	// Size policies (the fourth template argument of my_lib::list).
+	// Eager: size_ is always right, splice of a range from another list counts it in O(n).
+	// Lazy: that splice only marks both sizes stale, size() counts the nodes again when it is asked (O(n) once).
+	// A stale size() writes the list, so it must not be called from two threads at once
+	struct eager_size
+	{
+		constexpr static bool lazy{ false };
+	};
+
+	struct lazy_size
+	{
+		constexpr static bool lazy{ true };
+	};
+
+	// Instrumentation policies (the fifth template argument of my_lib::list).
+	// No stats: nothing is counted and the list does not get bigger.
+	// Collect stats: operation counters per list (list::stats()), needs list_stats.hpp included
+	struct no_stats
+	{
+		constexpr static bool enabled{ false };
+	};
+
+	struct collect_stats
+	{
+		constexpr static bool enabled{ true };
+	};
+
+	namespace detail
+	{
+		struct list_access; // for the parallel algorithms (parallel.hpp)
+
+		// Base of my_lib::list. The list calls the on_ functions unconditionally, for no_stats they are empty
+		// and the base takes no space (sort_start() reads no clock). The counting one is in list_stats.hpp
+		template <bool Enabled>
+		class list_stats_base;
+
+		template <>
+		class list_stats_base<false>
+		{
+		protected:
+			void on_allocate(std::size_t) const noexcept {}
+			void on_batch_allocate(std::size_t) const noexcept {}
+			void on_free(std::size_t) const noexcept {}
+			void on_recycle() const noexcept {}
+			void on_traversal(std::size_t) const noexcept {}
+			void on_splice(std::size_t) const noexcept {}
+			void on_unsized_splice() const noexcept {}
+			void on_merge(std::size_t) const noexcept {}
+
+			[[nodiscard]] static int sort_start() noexcept
+			{
+				return 0; // no clock read
+			}
+
+			void on_sort(std::size_t, int) const noexcept {}
+		};
+	}
+
+	// owner_ is the head of the list that owns a node (or that an iterator points into)
+	template <class Nodeptr, bool Enabled>
+	struct list_owner_tag
+	{
+		Nodeptr owner_{};
+	};
+
+	template <class Nodeptr>
+	struct list_owner_tag<Nodeptr, false> {}; // empty base, no space taken
 
 	// CHECKME
 	template <class MyList>
-	class list_const_iterator
+	class list_const_iterator : private list_owner_tag<typename MyList::nodeptr, MyList::checking::enabled>
 	{
 		// type aliases
 	public:
@@ -53,12 +145,18 @@ namespace my_lib
 		using difference_type = typename MyList::difference_type;
 
 	private:
-		const MyList* mylist_;
+		constexpr static bool checked{ MyList::checking::enabled };
+
 		nodeptr ptr_;
 
 		// Ctors
 	public:
-		list_const_iterator(const MyList* list, const nodeptr ptr) noexcept : mylist_{ list }, ptr_{ ptr }{}
+		list_const_iterator([[maybe_unused]] const MyList* list, const nodeptr ptr) noexcept : ptr_{ ptr }
+		{
+			if constexpr (checked) {
+				this->owner_ = list->head();
+			}
+		}
 
 		list_const_iterator() noexcept = default;
 
@@ -66,46 +164,33 @@ namespace my_lib
 	private:
 		void range_verify() const noexcept
 		{
-			assert(ptr_ != mylist_->head_ && "past the end iterator");
-
-			bool flag{};
-			for (auto node = const_cast<nodeptr>(mylist_->head_->next_); node != mylist_->head_; node = node->next_) {
-				if (ptr_ == node) {
-					flag = true;
-					break;
-				}
+			if constexpr (checked) {
+				assert(ptr_ && "value-initialized iterator");
+				assert(ptr_ != this->owner_ && "past the end iterator");
+				assert(ptr_->owner_ == this->owner_ && "out of range iterator");
 			}
-			assert(flag && "out of range iterator");
 		}
 
-		void offset_verify(difference_type offset) const noexcept
+		void offset_verify([[maybe_unused]] difference_type offset) const noexcept
 		{
-			if (ptr_ != mylist_->head_) {
-				bool flag{};
-				for (auto node = const_cast<nodeptr>(mylist_->head_->next_); node != mylist_->head_; node = node->next_) {
-					if (ptr_ == node) {
-						flag = true;
-						break;
-					}
-				}
-				assert(flag && "out of range iterator");
-			}
+			if constexpr (checked) {
+				assert(ptr_ && "value-initialized iterator");
+				assert(ptr_->owner_ == this->owner_ && "out of range iterator");
 
-			if (offset > 0) {
-				if (mylist_->size_ == 0) {
-					assert(false && "cannot increment iterator on empty container");
+				if (offset > 0) {
+					assert(this->owner_->next_ != this->owner_ && "cannot increment iterator on empty container");
 				}
-			}
-			else {
-				if (mylist_->size_ == 0) {
-					assert(false && "cannot decrement iterator on empty container");
+				else {
+					assert(this->owner_->next_ != this->owner_ && "cannot decrement iterator on empty container");
 				}
 			}
 		}
 
-		void is_comparable(const list_const_iterator& rhs) const noexcept
+		void is_comparable([[maybe_unused]] const list_const_iterator& rhs) const noexcept
 		{
-			assert(mylist_ == rhs.mylist_ && "iterators incomparable");
+			if constexpr (checked) {
+				assert(this->owner_ == rhs.owner_ && "iterators incomparable");
+			}
 		}
 
 		// Access 
@@ -113,7 +198,7 @@ namespace my_lib
 		[[nodiscard]] reference operator*() const noexcept
 		{
 			range_verify();
-			return ptr_->value_;
+			return MyList::list_node_type::value_of(ptr_);
 		}
 
 		[[nodiscard]] pointer operator->() const noexcept
@@ -240,74 +325,219 @@ namespace my_lib
 		using mybase::operator!=;
 	};
 
-	template <class T, class Pointer>
-	struct list_node
+	// Links of a node. The head of a list is a bare list_node_base embedded in the list object,
+	// so an empty list owns no memory and moves / swaps do not allocate
+	template <class Pointer, bool Checked = false>
+	struct list_node_base : list_owner_tag<typename std::pointer_traits<Pointer>::template rebind<list_node_base<Pointer, Checked>>, Checked>
 	{
 		// type aliases
-		using value_type = T;
-		using nodeptr = typename std::pointer_traits<Pointer>::template rebind<list_node>; // I am using the rebind because I cannot know what will be used as pointer
-		// for example, if smone will use unique_ptrs
+		using nodeptr = typename std::pointer_traits<Pointer>::template rebind<list_node_base>;
 
 		// data
 		nodeptr		next_; // next node, or first if head
 		nodeptr		prev_; // previous node, or last if head
-		value_type	value_; // the stored value, unused if head
 
-		// This is dummy realization, but I don't know how to fix it (there are should be singleton)
+		list_node_base() noexcept : next_{}, prev_{} {}
+
+		list_node_base(nodeptr next, nodeptr prev) noexcept : next_{ next }, prev_{ prev } {}
+
+		// copying
+		list_node_base(const list_node_base&)				= delete;
+		list_node_base& operator=(const list_node_base&)	= delete;
+	};
+
+	template <class T, class Pointer, bool Checked = false>
+	struct list_node : list_node_base<Pointer, Checked>
+	{
+		// type aliases
+		using value_type = T;
+		using node_base = list_node_base<Pointer, Checked>;
+		using nodeptr = typename node_base::nodeptr; // links point to the base, the head is not a list_node
+		using node_pointer = typename std::pointer_traits<Pointer>::template rebind<list_node>; // I am using the rebind because I cannot know what will be used as pointer
+		// for example, if smone will use unique_ptrs
+
+		// data
+		value_type	value_; // the stored value
+
 		template <class...Args>
-		list_node(nodeptr next, nodeptr prev, Args&&... args) : next_{ next },
-																prev_{ prev },
+		list_node(nodeptr next, nodeptr prev, Args&&... args) : node_base{ next, prev },
 																value_{ std::forward<Args>(args)... }{}
 
 		// copying
 		list_node(const list_node&)				= delete;
 		list_node& operator=(const list_node&)	= delete;
-		
-	// Create and destroy functions
+
+	// Casts, ptr must not be a head
 	public:
-		template <class NodeAlloc>
-		[[nodiscard]] static nodeptr create_head(NodeAlloc& allocator)
+		[[nodiscard]] static value_type& value_of(const nodeptr& ptr) noexcept
+		{
+			return static_cast<list_node&>(*ptr).value_;
+		}
+
+		[[nodiscard]] static node_pointer as_node(const nodeptr& ptr) noexcept
 		{
-			nodeptr head = allocator.allocate(1);
-			::new (std::addressof(head->next_)) nodeptr(head);
-			::new (std::addressof(head->prev_)) nodeptr(head);
-			
-			return head;
+			return std::pointer_traits<node_pointer>::pointer_to(static_cast<list_node&>(*ptr));
 		}
 
+		[[nodiscard]] static nodeptr as_base(const node_pointer& ptr) noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(static_cast<node_base&>(*ptr));
+		}
+
+	// Create and destroy functions
+	public:
 		template <class NodeAlloc>
 		static void free_without_value(NodeAlloc& allocator, nodeptr ptr) noexcept
 		{
-			ptr->next_.~nodeptr();
-			ptr->prev_.~nodeptr();
-			std::allocator_traits<NodeAlloc>::deallocate(allocator, ptr, 1);
+			if constexpr (Checked) {
+				ptr->owner_ = nullptr; // a dangling iterator will not pass the owner check while the memory is not reused
+			}
+			auto node = as_node(ptr);
+			node->node_base::~node_base();
+			std::allocator_traits<NodeAlloc>::deallocate(allocator, node, 1);
 		}
 
 		template <class NodeAlloc>
 		static void free_node(NodeAlloc& allocator, nodeptr ptr) noexcept
 		{
-			std::allocator_traits<NodeAlloc>::destroy(allocator, std::addressof(ptr->value_));
+			std::allocator_traits<NodeAlloc>::destroy(allocator, std::addressof(value_of(ptr)));
 			free_without_value(allocator, ptr);
 		}
 
 		template <class NodeAlloc>
 		static void free_all_nonhead(NodeAlloc& allocator, nodeptr head) noexcept
 		{
-			head->prev_->next_ = nullptr; // deleting from first to nullptr
+			// the order does not matter, two cursors overlap the cache misses
+			auto free = [&allocator](const nodeptr& node) { free_node(allocator, node); return false; };
+			detail::walk_from_both_ends(head, free, free);
+		}
+	};
+
+	// Owns one element taken out of a list with extract(). insert / push_back / push_front link it
+	// into a list with an equal allocator: no allocation and the value is not moved. Modeled on the std::map node handle
+	template <class MyList>
+	class list_node_handle
+	{
+		friend MyList;
+
+		using nodeptr				= typename MyList::nodeptr;
+		using node_allocator_type	= typename MyList::node_allocator_type;
+
+		// type aliases
+	public:
+		using value_type		= typename MyList::value_type;
+		using allocator_type	= typename MyList::allocator_type;
+
+	private:
+		nodeptr ptr_{};
+		union
+		{
+			node_allocator_type allocator_; // alive only with a node
+		};
 
-			auto node = head->next_;
-			for (nodeptr next; node; node = next) {
-				next = node->next_;
-				free_node(allocator, node);
+		list_node_handle(nodeptr ptr, const node_allocator_type& allocator) noexcept : ptr_{ ptr }
+		{
+			::new (static_cast<void*>(std::addressof(allocator_))) node_allocator_type(allocator);
+		}
+
+		// Ctors and dtor
+	public:
+		list_node_handle() noexcept {}
+
+		list_node_handle(list_node_handle&& rhs) noexcept
+		{
+			take(rhs);
+		}
+
+		// the old element is destroyed
+		list_node_handle& operator=(list_node_handle&& rhs) noexcept
+		{
+			if (this != std::addressof(rhs)) {
+				tidy();
+				take(rhs);
+			}
+			return *this;
+		}
+
+		list_node_handle(const list_node_handle&)				= delete;
+		list_node_handle& operator=(const list_node_handle&)	= delete;
+
+		~list_node_handle() noexcept
+		{
+			tidy();
+		}
+
+	private:
+		// this is empty
+		void take(list_node_handle& rhs) noexcept
+		{
+			if (rhs.ptr_) {
+				::new (static_cast<void*>(std::addressof(allocator_))) node_allocator_type(std::move(rhs.allocator_));
+				ptr_ = std::exchange(rhs.ptr_, nodeptr{});
+				rhs.allocator_.~node_allocator_type();
 			}
 		}
+
+		// gives up the node (there is one)
+		[[nodiscard]] nodeptr release() noexcept
+		{
+			allocator_.~node_allocator_type();
+			return std::exchange(ptr_, nodeptr{});
+		}
+
+		void tidy() noexcept
+		{
+			if (ptr_) {
+				MyList::list_node_type::free_node(allocator_, ptr_);
+				ptr_ = nodeptr{};
+				allocator_.~node_allocator_type();
+			}
+		}
+
+		// Observers
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return !ptr_;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return !empty();
+		}
+
+		[[nodiscard]] value_type& value() const noexcept
+		{
+			assert(!empty() && "value() on empty node handle");
+			return MyList::list_node_type::value_of(ptr_);
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const
+		{
+			assert(!empty() && "get_allocator() on empty node handle");
+			return static_cast<allocator_type>(allocator_);
+		}
+
+		void swap(list_node_handle& rhs) noexcept
+		{
+			list_node_handle tmp{ std::move(rhs) };
+			rhs = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		friend void swap(list_node_handle& lhs, list_node_handle& rhs) noexcept
+		{
+			lhs.swap(rhs);
+		}
 	};
 
 	// list_node head will store first element(next_) and last element(prev_) 
-	template <class T, class Alloc = std::allocator<T>>
-	class list
+	template <class T, class Alloc = std::allocator<T>, class Checking = default_iterator_checking, class Sizing = eager_size, class Stats = no_stats>
+	class list : private detail::list_stats_base<Stats::enabled>
 	{
-		friend list_const_iterator<list<T, Alloc>>;
+		friend list_const_iterator<list<T, Alloc, Checking, Sizing, Stats>>;
+		friend list_node_handle<list<T, Alloc, Checking, Sizing, Stats>>;
+		friend detail::list_access;
 		// type aliases
 	public:
 		// value type aliases
@@ -323,14 +553,20 @@ namespace my_lib
 		using allocator_type = Alloc;
 		using list_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
 		using list_allocator_traits = std::allocator_traits<list_allocator>;
-		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<list_node<T, typename std::allocator_traits<Alloc>::void_pointer>>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<list_node<T, typename std::allocator_traits<Alloc>::void_pointer, Checking::enabled>>;
 		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
-		using node_type = list_node<T, typename node_allocator_traits::void_pointer>;
-		using nodeptr = typename node_allocator_traits::pointer;
+		using list_node_type = list_node<T, typename node_allocator_traits::void_pointer, Checking::enabled>;
+		using node_type = list_node_handle<list<T, Alloc, Checking, Sizing, Stats>>; // extract / insert
+		using node_base = typename list_node_type::node_base;
+		using nodeptr = typename list_node_type::nodeptr; // links, the head is only a node_base
+		using node_pointer = typename node_allocator_traits::pointer; // what the allocator gives
 
 		// iterator aliases
-		using iterator = list_iterator<list<T, Alloc>>;
-		using const_iterator = list_const_iterator<list<T, Alloc>>;
+		using checking = Checking;
+		using sizing = Sizing;
+		using instrumentation = Stats;
+		using iterator = list_iterator<list<T, Alloc, Checking, Sizing, Stats>>;
+		using const_iterator = list_const_iterator<list<T, Alloc, Checking, Sizing, Stats>>;
 
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
@@ -338,87 +574,316 @@ namespace my_lib
 		// list data
 	private:
 		node_allocator_type allocator_;
-		nodeptr head_;
-		size_type size_;
+		mutable bool size_stale_{}; // lazy_size only: size_ has to be counted again (sits in the padding after allocator_)
+		bool recycling_{}; // removed elements leave their nodes on spare_ (see reserve)
+		node_base head_; // sentinel, points to itself when empty
+		mutable size_type size_;
+		nodeptr spare_{}; // nodes without values kept for reuse, linked by next_
 
 		// Ctors and dtor
 	public:
-		list() noexcept : list(allocator_type{}, 0) {}
+		list() noexcept(noexcept(allocator_type{})) : list(allocator_type{}, 0) {}
 
-		explicit list(const allocator_type& allocator) : list(allocator, 0){}
+		explicit list(const allocator_type& allocator) noexcept : list(allocator, 0){}
 
 	private:
-		// helper initialize ctor
+		// helper initialize ctor, no allocation
 		list(const allocator_type& alloc,
-			size_type size) : allocator_{ alloc },
-			head_{ node_type::create_head(allocator_) },
-			size_{ size }	{ }
+			size_type size) noexcept : allocator_{ alloc },
+			size_{ size }
+		{
+			head_.next_ = head();
+			head_.prev_ = head();
+			if constexpr (checking::enabled) {
+				head_.owner_ = head(); // end() passes the owner check
+			}
+		}
 
-	public:
-		explicit list(size_type count, const allocator_type& allocator = allocator_type{}) : list(allocator, 0)
+		[[nodiscard]] nodeptr head() const noexcept
+		{
+			return std::pointer_traits<nodeptr>::pointer_to(const_cast<node_base&>(head_));
+		}
+
+		[[nodiscard]] static reference value_of(const nodeptr& ptr) noexcept
 		{
-			for (size_type i{}; i < count; ++i) {
-				emplace_back();
+			return list_node_type::value_of(ptr);
+		}
+
+		// a spare node if there is one, the allocator otherwise
+		[[nodiscard]] node_pointer allocate_node()
+		{
+			if (spare_) {
+				auto node = list_node_type::as_node(spare_);
+				spare_ = spare_->next_;
+				node->node_base::~node_base(); // the node is constructed again as a whole
+				this->on_recycle();
+				return node;
 			}
+			this->on_allocate(1);
+			return allocator_.allocate(1);
 		}
 
-	private:
-		template <class Iter>
-		void construct_range(Iter first, const Iter last, nodeptr where)
+		// Destroys the value. The node goes to the spare chain when the list recycles, else it is freed
+		void release_node(nodeptr node) noexcept
 		{
-			if (first == last) return;
+			if (!recycling_) {
+				list_node_type::free_node(allocator_, node);
+				this->on_free(1);
+				return;
+			}
 
-			while (first != last) {
-				auto node = allocator_.allocate(1);
-				node_allocator_traits::construct(allocator_, node, where->next_, where, *first);
-				where->next_->prev_= node;
-				where->next_ = node;
-				where = node;
-				++first;
+			node_allocator_traits::destroy(allocator_, std::addressof(value_of(node)));
+			if constexpr (checking::enabled) {
+				node->owner_ = nullptr;
 			}
+			node->next_ = spare_;
+			spare_ = node;
 		}
 
-		void construct_range(const_iterator first, const_iterator last, nodeptr where)
+		// A node from allocate_node whose value was not made: back to the spares when the list recycles
+		// (it may have come from there), else freed
+		void release_raw_node(node_pointer node) noexcept
 		{
-			construct_range(first.get_pointer(), last.get_pointer(), where);
+			if (!recycling_) {
+				allocator_.deallocate(node, 1);
+				this->on_free(1);
+				return;
+			}
+
+			auto ptr = list_node_type::as_base(node);
+			::new (static_cast<void*>(std::addressof(*ptr))) node_base{ spare_, nodeptr{} };
+			spare_ = ptr;
 		}
 
-		void construct_range(iterator first, iterator last, nodeptr where)
+		// releases the null terminated chain starting from first
+		void release_chain(nodeptr first) noexcept
 		{
-			construct_range(static_cast<const_iterator>(first), last, where);
+			for (nodeptr next; first; first = next) {
+				next = first->next_;
+				release_node(first);
+			}
 		}
 
-		void construct_range(nodeptr first, const nodeptr last, nodeptr where)
+		void free_spares() noexcept
 		{
-			if (first == last) return;
-			
-			auto node = allocator_.allocate(1);
-			node_allocator_traits::construct(allocator_, node, nullptr, where, first->value_);
-			auto copy = node;
-			first = first->next_;
-
-			while (first != last) {
-				auto newnode = allocator_.allocate(1);
-				node_allocator_traits::construct(allocator_, newnode, nullptr, node, first->value_);
-				first = first->next_;
-				node->next_ = newnode;
-				node = node->next_;
+			for (nodeptr next; spare_; spare_ = next) {
+				next = spare_->next_;
+				list_node_type::free_without_value(allocator_, spare_);
+				this->on_free(1);
+			}
+		}
+
+		// allocate and construct the node, neighbours are not linked to it
+		template <class... Args>
+		[[nodiscard]] nodeptr create_node(nodeptr next, nodeptr prev, Args&&... args)
+		{
+			auto node = allocate_node();
+			try {
+				node_allocator_traits::construct(allocator_, std::addressof(*node), next, prev, std::forward<Args>(args)...); // node may be a fancy pointer
+			}
+			catch (...) {
+				release_raw_node(node);
+				throw;
+			}
+
+			if constexpr (checking::enabled) {
+				node->owner_ = head();
 			}
+			return list_node_type::as_base(node);
+		}
+
+		// Takes the nodes of rhs (the allocators are equal), only the first and the last node are relinked.
+		// This list must be empty
+		void take(list& rhs) noexcept
+		{
+			if (rhs.empty()) return;
 
-			node->next_ = where->next_;
-			where->next_->prev_ = node;
-			where->next_ = copy;
+			head_.next_ = rhs.head_.next_;
+			head_.prev_ = rhs.head_.prev_;
+			take_size(rhs);
+			relink_head(rhs.head());
+
+			rhs.head_.next_ = rhs.head();
+			rhs.head_.prev_ = rhs.head();
 		}
 
-		void construct_n_copies(size_type count, const_reference value, nodeptr where)
+		// adds the size of rhs, whose nodes all came here. A stale size stays stale
+		void take_size(list& rhs) noexcept
 		{
-			for (size_type i{}; i < count; ++i) {
-				auto node = allocator_.allocate(1);
-				node_allocator_traits::construct(allocator_, node, where->next_, where, value);
-				where->next_->prev_= node;
-				where->next_ = node;
-				where = node;
+			size_ += rhs.size_;
+			size_stale_ = size_stale_ || rhs.size_stale_;
+			rhs.size_ = 0;
+			rhs.size_stale_ = false;
+		}
+
+		// head_.next_ / prev_ came from old_head, point the first and the last node back to this one
+		void relink_head(const nodeptr old_head) noexcept
+		{
+			if (head_.next_ == old_head) {
+				head_.next_ = head();
+				head_.prev_ = head();
+				return;
 			}
+
+			head_.next_->prev_ = head();
+			head_.prev_->next_ = head();
+			adopt(head_.next_, head());
+		}
+
+		// retag the nodes [first, last) moved from another list
+		void adopt([[maybe_unused]] nodeptr first, [[maybe_unused]] const nodeptr last) noexcept
+		{
+			if constexpr (checking::enabled) {
+				for (; first != last; first = first->next_) {
+					first->owner_ = head();
+				}
+			}
+		}
+
+	private:
+		// raw memory for count nodes in a row if the allocator can give it (node_pool::allocate_batch), nullptr otherwise
+		[[nodiscard]] node_pointer allocate_batch([[maybe_unused]] size_type count)
+		{
+			if constexpr (has_allocate_batch<node_allocator_type>::value) {
+				auto batch = allocator_.allocate_batch(count);
+				if (batch) {
+					this->on_batch_allocate(count);
+				}
+				return batch;
+			}
+			else {
+				return nullptr;
+			}
+		}
+
+		// Builds count nodes, construct(node) makes the value in the raw node. The nodes form a detached chain
+		// that is linked before where only when all of them are made, so if one throws the list is not changed.
+		// Returns the first new node (where if count is 0)
+		template <class Construct>
+		nodeptr insert_nodes(nodeptr where, size_type count, Construct construct)
+		{
+			if (count == 0) return where;
+
+			auto batch = spare_ ? nullptr : allocate_batch(count);
+			nodeptr first{};
+			nodeptr last{};
+			size_type made{};
+			try {
+				for (; made < count; ++made) {
+					node_pointer node = batch ? batch + made : allocate_node();
+					try {
+						construct(node);
+					}
+					catch (...) {
+						if (!batch) {
+							release_raw_node(node);
+						}
+						throw;
+					}
+
+					auto ptr = list_node_type::as_base(node);
+					if constexpr (checking::enabled) {
+						ptr->owner_ = head();
+					}
+					ptr->prev_ = last;
+					if (last) {
+						last->next_ = ptr;
+					}
+					else {
+						first = ptr;
+					}
+					last = ptr;
+				}
+			}
+			catch (...) {
+				release_chain(first); // the chain ends with nullptr
+				for (; batch && made < count; ++made) { // the rest of the batch was never constructed
+					allocator_.deallocate(batch + made, 1);
+					this->on_free(1);
+				}
+				throw;
+			}
+
+			first->prev_ = where->prev_;
+			last->next_ = where;
+			where->prev_->next_ = first;
+			where->prev_ = last;
+			size_ += count;
+			return first;
+		}
+
+		// Builds count new nodes before first with the values of [first, first + count) moved in, then frees
+		// the old nodes. The spares are not used and the old nodes do not become spares: the new nodes come
+		// from the allocator in list order. Returns the node after the old ones
+		nodeptr relocate(nodeptr first, size_type count)
+		{
+			auto spares = spare_;
+			spare_ = nodeptr{};
+			auto source = first;
+			try {
+				insert_nodes(first, count, [this, &source](node_pointer node) {
+					construct_node(node, std::move_if_noexcept(value_of(source)));
+					source = source->next_;
+					detail::prefetch_node(source);
+				});
+			}
+			catch (...) {
+				free_spares(); // a recycling list put the new nodes here
+				spare_ = spares;
+				throw;
+			}
+			spare_ = spares;
+
+			first->prev_->next_ = source;
+			source->prev_ = first->prev_;
+			for (nodeptr next; first != source; first = next) {
+				next = first->next_;
+				list_node_type::free_node(allocator_, first);
+			}
+			this->on_free(count);
+			size_ -= count;
+			return source;
+		}
+
+		template <class... Args>
+		void construct_node(node_pointer node, Args&&... args)
+		{
+			node_allocator_traits::construct(allocator_, std::addressof(*node), nodeptr{}, nodeptr{}, std::forward<Args>(args)...);
+		}
+
+		// copies count elements of the range before where
+		template <class Iter>
+		nodeptr construct_range(Iter first, size_type count, nodeptr where)
+		{
+			return insert_nodes(where, count, [this, &first](node_pointer node) {
+				construct_node(node, *first);
+				++first;
+			});
+		}
+
+		// copies count elements of another list's chain before where
+		nodeptr construct_range(nodeptr first, size_type count, nodeptr where)
+		{
+			return insert_nodes(where, count, [this, &first](node_pointer node) {
+				construct_node(node, value_of(first));
+				first = first->next_;
+				detail::prefetch_node(first); // loads while the next node is allocated
+			});
+		}
+
+		nodeptr construct_n_copies(size_type count, const_reference value, nodeptr where)
+		{
+			return insert_nodes(where, count, [this, &value](node_pointer node) {
+				construct_node(node, value);
+			});
+		}
+
+		// value initialized elements
+		nodeptr construct_n_default(size_type count, nodeptr where)
+		{
+			return insert_nodes(where, count, [this](node_pointer node) {
+				construct_node(node);
+			});
 		}
 
 		void erase_range(nodeptr first, nodeptr last)
@@ -426,58 +891,60 @@ namespace my_lib
 			first->prev_->next_ = last;
 			last->prev_ = first->prev_;
 			for (auto current = first->next_; first != last; first = current, current = current->next_) {
-				node_type::free_node(allocator_, first);
+				release_node(first);
 			}
 		}
 
+	// The bulk constructors build all nodes first (in one batch if the allocator can), nothing leaks if a value throws
 	public:
+		explicit list(size_type count, const allocator_type& allocator = allocator_type{}) : list(allocator, 0)
+		{
+			construct_n_default(count, head());
+		}
+
 		explicit list(size_type count,
 			const_reference value,
-			const allocator_type allocator = allocator_type{}) : list(allocator, count)
+			const allocator_type allocator = allocator_type{}) : list(allocator, 0)
 		{
-			construct_n_copies(count, value, head_);
+			construct_n_copies(count, value, head());
 		}
 
 
 		template <class Iter, std::enable_if_t<is_iterator<Iter>::value, int> = 0>
-		list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : list(allocator, std::distance(first, last))
+		list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : list(allocator, 0)
 		{
-			construct_range(first, last, head_);
+			construct_range(first, static_cast<size_type>(std::distance(first, last)), head());
 		}
 
-		list(const list& rhs) : list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.allocator_), rhs.size_)
+		list(const list& rhs) : list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.allocator_), 0)
 		{
-			construct_range(rhs.head_->next_, rhs.head_, head_);
+			construct_range(rhs.head()->next_, rhs.size(), head());
 		}
 
-		list(const list& rhs, const allocator_type& allocator) : list(allocator, rhs.size_)
+		list(const list& rhs, const allocator_type& allocator) : list(allocator, 0)
 		{
-			construct_range(rhs.head_->next_, rhs.head_, head_);
+			construct_range(rhs.head()->next_, rhs.size(), head());
 		}
 
-		list(list&& rhs) : allocator_{ std::move(rhs.allocator_) }, head_{node_type::create_head(allocator_)}, size_{rhs.size_}
+		// no allocation, the nodes are taken over (in checked mode they are retagged, that is O(n))
+		list(list&& rhs) noexcept : list(rhs.allocator_, 0)
 		{
-			this->operator=(std::move(rhs));
+			take(rhs);
 		}
 
-		list(std::initializer_list<value_type> list, 
-			 const allocator_type& allocator = allocator_type{}) : list(allocator, list.size())
+		list(std::initializer_list<value_type> ilist, 
+			 const allocator_type& allocator = allocator_type{}) : list(allocator, 0)
 		{
-			construct_range(list.begin(), list.end(), head_);
+			construct_range(ilist.begin(), ilist.size(), head());
 		}
 
 	private:
 		void tidy() noexcept
 		{
-			if (head_) {
-				if (size_ != 0) {
-					node_type::free_all_nonhead(allocator_, head_);
-					node_type::free_without_value(allocator_, head_);
-				}
-				else {
-					node_type::free_without_value(allocator_, head_);
-				}
+			if (!empty()) {
+				list_node_type::free_all_nonhead(allocator_, head());
 			}
+			free_spares();
 		}
 
 	public:
@@ -488,75 +955,55 @@ namespace my_lib
 
 	// Member functions (operator=, assign, get_allocator)
 	public:
+		// The existing nodes are reused, the missing ones are appended in one insert_nodes
 		list& operator=(const list& rhs)
 		{
 			if (this == std::addressof(rhs)) return *this;
-			auto rhs_size	= rhs.size_;
-			auto rhs_head	= rhs.head_;
-			auto rhs_node	= rhs_head->next_;
-			auto node		= head_->next_;
-			if (size_ == 0) {
-				construct_range(rhs_head->next_, rhs_head, head_);
-			}
-			else if (size_ <= rhs_size) {
-				for (; node != head_; rhs_node = rhs_node->next_, node = node->next_) {
-					node->value_ = rhs_node->value_;
-				}
 
-				// if size != list.size_ append remain elements
-				if (size_ < rhs_size) {
-					construct_range(rhs_node, rhs_head, head_);
+			auto node		= head()->next_;
+			auto rhs_node	= rhs.head()->next_;
+			auto count		= size();
+			auto rhs_count	= rhs.size();
+			if (count <= rhs_count) {
+				for (; node != head(); rhs_node = rhs_node->next_, node = node->next_) {
+					value_of(node) = value_of(rhs_node);
 				}
+				construct_range(rhs_node, rhs_count - count, head());
 			}
 			else {
-				for (; rhs_node != rhs_head; rhs_node = rhs_node->next_, node = node->next_) {
-					node->value_ = rhs_node->value_;
+				for (; rhs_node != rhs.head(); rhs_node = rhs_node->next_, node = node->next_) {
+					value_of(node) = value_of(rhs_node);
 				}
-				erase_range(node, head_);
+				erase_range(node, head());
+				size_ = rhs_count;
 			}
-			size_ = rhs.size_;
-			
-			return *this;
-		}
 
-	private:
-		void move_range_construct(nodeptr first, nodeptr last, nodeptr where)
-		{
-			while (first != last) {
-				auto node = allocator_.allocate(1);
-				node_allocator_traits::construct(allocator_, node, where->next_, where, std::move(first->value_));
-				where->next_->prev_ = node;
-				where->next_ = node;
-				where = node;
-				first = first->next_;
-			}
+			return *this;
 		}
 
 	public:
-		// FIXME: may cause problems
-		list& operator=(list&& rhs)
+		// The old elements are destroyed, the nodes of rhs are taken without allocation
+		// (or moved one by one if the allocators differ and do not propagate)
+		list& operator=(list&& rhs) noexcept(node_allocator_traits::propagate_on_container_move_assignment::value
+			|| node_allocator_traits::is_always_equal::value)
 		{
 			if (this == std::addressof(rhs)) return *this;
 
 			if (allocator_ == rhs.allocator_)	 {
-				if (head_) {
-					erase_range(head_->next_, head_);
-				}
-				std::swap(head_, rhs.head_);
-				size_		= rhs.size_;
+				clear();
+				take(rhs);
 			}
-			else if (list_allocator_traits::propagate_on_container_move_assignment::value) {
-				tidy(); // use old allocator to free the storage
-				allocator_	= std::move(rhs.allocator_);
-				head_		= node_type::create_head(allocator_);
-				size_		= rhs.size_;
-				move_range_construct(rhs.head_->next_, rhs.head_, head_); // move all elements from rhs
+			else if constexpr (node_allocator_traits::propagate_on_container_move_assignment::value) {
+				clear(); // use old allocator to free the storage
+				free_spares();
+				allocator_	= rhs.allocator_; // now both allocators are equal, so rhs nodes can be taken as is
+				take(rhs);
 			}
 			else {
-				assign(rhs.begin(), rhs.end());
+				assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+				rhs.clear();
 			}
-			rhs.size_ = 0;
-	
+
 			return *this;
 		}
 
@@ -567,56 +1014,45 @@ namespace my_lib
 			return *this;
 		}
 
+		// Same as operator=
 		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
 		void assign(Iter first, const Iter last)
 		{
 			size_type new_size = std::distance(first, last);
-			if (size_ == 0) {
-				construct_range(first, last, head_);
-			}
-			else if (auto node = head_->next_; size_ <= new_size) {
-				for (; node != head_; node = node->next_) {
-					node->value_ = *(first++);
-				}
-
-				if (size_ < new_size) {
-					construct_range(first, last, head_);
+			auto node = head()->next_;
+			auto old_size = size(); // counts again if an unsized splice left size_ stale
+			if (old_size <= new_size) {
+				for (; node != head(); node = node->next_, ++first) {
+					value_of(node) = *first;
 				}
+				construct_range(first, new_size - old_size, head());
 			}
 			else {
-				for (size_type i{}; i < new_size; ++i, node = node->next_) {
-					node->value_ = *(first++);
+				for (size_type i{}; i < new_size; ++i, node = node->next_, ++first) {
+					value_of(node) = *first;
 				}
-
-				erase_range(node, head_);
+				erase_range(node, head());
+				size_ = new_size;
 			}
-			size_ = new_size;
 		}
 
 		void assign(size_type count, const_reference value)
 		{
-			if (size_ == 0) {
-				construct_n_copies(count, value, head_);
-			}
-			else if (auto node = head_->next_; size_ <= count) {
-				for (; node != head_; node = node->next_) {
-					node->value_ = value;
-				}
-
-				if (size_ < count) {
-					for (size_type i{ size_ }; i < count; ++i, node = node->next_) {
-						node->value_ = value;
-					}
+			auto node = head()->next_;
+			auto old_count = size();
+			if (old_count <= count) {
+				for (; node != head(); node = node->next_) {
+					value_of(node) = value;
 				}
+				construct_n_copies(count - old_count, value, head());
 			}
 			else {
 				for (size_type i{}; i < count; ++i, node = node->next_) {
-					node->value_ = value;
+					value_of(node) = value;
 				}
-				erase_range(node, head_);
+				erase_range(node, head());
+				size_ = count;
 			}
-
-			size_ = count;
 		}
 
 		void assign(std::initializer_list<T> ilist)
@@ -633,59 +1069,59 @@ namespace my_lib
 	public:
 		[[nodiscard]] reference front()
 		{
-			assert(size_ != 0 && "front() on empty container");
-			return head_->next_->value_;
+			assert(!empty() && "front() on empty container");
+			return value_of(head()->next_);
 		}
 
 		[[nodiscard]] const_reference front() const
 		{
-			assert(size_ != 0 && "front() on empty container");
-			return head_->next_->value_;
+			assert(!empty() && "front() on empty container");
+			return value_of(head()->next_);
 		}
 
 		[[nodiscard]] reference back()
 		{
-			assert(size_ != 0 && "back() on empty container");
-			return head_->prev_->value_;
+			assert(!empty() && "back() on empty container");
+			return value_of(head()->prev_);
 		}
 
 		[[nodiscard]] const_reference back() const
 		{
-			assert(size_ != 0 && "back() on empty container");
-			return head_->prev_->value_;
+			assert(!empty() && "back() on empty container");
+			return value_of(head()->prev_);
 		}
 
 	// Iterators
 	public:
 		[[nodiscard]] iterator begin() noexcept
 		{
-			return iterator(this, head_->next_);
+			return iterator(this, head()->next_);
 		}
 
 		[[nodiscard]] const_iterator begin() const noexcept
 		{
-			return const_iterator(this, head_->next_);
+			return const_iterator(this, head()->next_);
 		}
 
 		[[nodiscard]] iterator end() noexcept
 		{
-			return iterator(this, head_);
+			return iterator(this, head());
 		}
 
 		[[nodiscard]] const_iterator end() const noexcept
 		{
-			return const_iterator(this, head_);
+			return const_iterator(this, head());
 		}
 
 
 		[[nodiscard]] const_iterator cbegin() const noexcept
 		{
-			return const_iterator(this, head_->next_);
+			return const_iterator(this, head()->next_);
 		}
 
 		[[nodiscard]] const_iterator cend() const noexcept
 		{
-			return const_iterator(this, head_);
+			return const_iterator(this, head());
 		}
 
 
@@ -724,11 +1160,21 @@ namespace my_lib
 	public:
 		[[nodiscard]] bool empty() const noexcept
 		{
-			return size_ == 0;
+			return head_.next_ == head();
 		}
 
+		// O(1), or O(n) once after a lazy_size splice
 		[[nodiscard]] size_type size() const noexcept
 		{
+			if constexpr (sizing::lazy) {
+				if (size_stale_) {
+					size_ = 0;
+					for (auto node = head_.next_; node != head(); node = node->next_) {
+						++size_;
+					}
+					size_stale_ = false;
+				}
+			}
 			return size_;
 		}
 
@@ -740,30 +1186,93 @@ namespace my_lib
 			return alnode_max;
 		}
 
+		// Makes sure count nodes exist (elements and spares), the missing ones are allocated as spares.
+		// From now on the list recycles: clear, erase, pop and remove keep the nodes of the removed elements,
+		// so refilling up to the reached size allocates nothing. The spares are not capped at count: they grow
+		// to the largest size the list reaches and stay until shrink_to_fit, which ends recycling
+		void reserve(size_type count)
+		{
+			if (count > max_size()) {
+				throw std::length_error{ "list::reserve() count exceeds max_size()" };
+			}
+
+			recycling_ = true;
+			auto nodes = size();
+			for (auto node = spare_; node && nodes < count; node = node->next_) {
+				++nodes;
+			}
+			for (; nodes < count; ++nodes) {
+				auto node = list_node_type::as_base(allocator_.allocate(1));
+				this->on_allocate(1);
+				::new (static_cast<void*>(std::addressof(*node))) node_base{ spare_, nodeptr{} };
+				spare_ = node;
+			}
+		}
+
+		// frees the spare nodes and stops recycling
+		void shrink_to_fit() noexcept
+		{
+			free_spares();
+			recycling_ = false;
+		}
+
+		// Moves the values into new nodes allocated in list order and frees the old nodes, so a list scattered
+		// by splice / sort / erase is walked in address order again (the hardware prefetcher follows it).
+		// With node_pool the new nodes are one block. Needs memory for a second copy of the nodes while it runs.
+		// Invalidates all iterators and references. If a move throws the list is not changed
+		void compact()
+		{
+			if (empty()) return;
+			relocate(head()->next_, size());
+		}
+
+		// Incremental compact(): relocates at most budget nodes from first on, returns the next node to do.
+		// Only iterators to the relocated nodes are invalidated. For big lists walked between the steps:
+		//     for (auto it = list.begin(); it != list.end(); ) it = list.compact(it, 4096);
+		// Needs an allocator with allocate_batch (node_pool): malloc gives the nodes freed by one step
+		// back to the next one, so with std::allocator the steps end up as scattered as before
+		iterator compact(const_iterator first, size_type budget)
+		{
+			auto node = first.get_pointer();
+			range_verify(node);
+
+			size_type count{};
+			for (auto last = node; last != head() && count < budget; last = last->next_) {
+				++count;
+			}
+			if (count == 0) return iterator{ this, node };
+			return iterator{ this, relocate(node, count) };
+		}
+
 	// Modifiers
 	public:
 		void clear() noexcept
 		{
-			node_type::free_all_nonhead(allocator_, head_);
-			head_->next_ = head_;
-			head_->prev_ = head_;
+			auto release = [this](const nodeptr& node) { release_node(node); return false; };
+			detail::walk_from_both_ends(head(), release, release);
+			head()->next_ = head();
+			head()->prev_ = head();
 			size_ = 0;
+			size_stale_ = false;
 		}
 
 	private:
-		void range_verify(const nodeptr& ptr) const noexcept
+		void range_verify([[maybe_unused]] const nodeptr& ptr) const noexcept
 		{
-			if (ptr == head_) return;
+			if constexpr (checking::enabled) {
+				assert(ptr->owner_ == head() && "out of range iterator");
+			}
+		}
 
-			auto node = head_->next_;
-			bool flag{};
-			for (; node != head_; node = node->next_) {
-				if (ptr == node) {
-					flag = true;
-					break;
-				}
+		// size() for the counters (the nodes a full walk visits), 0 without stats: a stale lazy_size is not counted for nothing
+		[[nodiscard]] size_type counted_size() const noexcept
+		{
+			if constexpr (instrumentation::enabled) {
+				return size();
+			}
+			else {
+				return 0;
 			}
-			assert(flag && "out of range iterator");
 		}
 
 	public:
@@ -782,10 +1291,7 @@ namespace my_lib
 			auto where = pos.get_pointer();
 			range_verify(where);
 
-			auto node = where->prev_;
-			construct_n_copies(count, value, node);
-			size_ += count;
-			return iterator{ this, node->next_ };
+			return iterator{ this, construct_n_copies(count, value, where) };
 		}
 
 		template <class Iter, std::enable_if_t <is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
@@ -794,10 +1300,7 @@ namespace my_lib
 			auto where = pos.get_pointer();
 			range_verify(where);
 
-			size_ += std::distance(first, last);
-			auto node = where->prev_;
-			construct_range(first, last, node);
-			return iterator{ this, node->next_ };
+			return iterator{ this, construct_range(first, static_cast<size_type>(std::distance(first, last)), where) };
 		}
 
 		template <class... Args>
@@ -806,8 +1309,7 @@ namespace my_lib
 			auto where = pos.get_pointer();
 			range_verify(where);
 
-			auto node = allocator_.allocate(1);
-			node_allocator_traits::construct(allocator_, node, where, where->prev_, std::forward<Args>(what)...);
+			auto node = create_node(where, where->prev_, std::forward<Args>(what)...);
 			where->prev_->next_ = node;
 			where->prev_ = node;
 			++size_;
@@ -824,7 +1326,7 @@ namespace my_lib
 		iterator erase(const_iterator pos)
 		{
 			auto where = pos.get_pointer();
-			assert(where != head_ && "cannot erase out of range iterator");
+			assert(where != head() && "cannot erase out of range iterator");
 			range_verify(where);
 
 			auto result = where->next_;
@@ -836,17 +1338,56 @@ namespace my_lib
 		iterator erase(const_iterator first, const_iterator last)
 		{
 			auto begin = first.get_pointer();
-			assert(begin != head_ && "cannot erase out of range iterator");
-			range_verify(begin);
-
 			auto end = last.get_pointer();
 			range_verify(end);
+			if (begin == end) return iterator{ this, end }; // erase(end(), end()) too
+
+			assert(begin != head() && "cannot erase out of range iterator");
+			range_verify(begin);
 
 			size_ -= std::distance(first, last);
 			erase_range(begin, end);
 			return iterator{ this, end };
 		}
 
+		// Unlinks the element without destroying it, the handle owns the node now
+		[[nodiscard]] node_type extract(const_iterator pos)
+		{
+			auto where = pos.get_pointer();
+			assert(where != head() && "cannot extract out of range iterator");
+			range_verify(where);
+
+			where->prev_->next_ = where->next_;
+			where->next_->prev_ = where->prev_;
+			--size_;
+			if constexpr (checking::enabled) {
+				where->owner_ = nullptr; // iterators to the element are invalid from now
+			}
+			return node_type{ where, allocator_ };
+		}
+
+		// Links the node of handle before pos, returns end() if the handle is empty.
+		// The handle must come from a list with an equal allocator
+		iterator insert(const_iterator pos, node_type&& handle)
+		{
+			auto where = pos.get_pointer();
+			range_verify(where);
+			if (handle.empty()) return end();
+
+			assert(handle.allocator_ == allocator_ && "node handle with unequal allocator");
+			auto node = handle.release();
+
+			node->next_ = where;
+			node->prev_ = where->prev_;
+			where->prev_->next_ = node;
+			where->prev_ = node;
+			if constexpr (checking::enabled) {
+				node->owner_ = head();
+			}
+			++size_;
+			return iterator{ this, node };
+		}
+
 
 		void push_back(const_reference value)
 		{
@@ -858,26 +1399,30 @@ namespace my_lib
 			emplace_back(std::move(value));
 		}
 
+		void push_back(node_type&& handle)
+		{
+			insert(end(), std::move(handle));
+		}
+
 		template<class...Args>
 		reference emplace_back(Args&&... what)
 		{
+			auto node = create_node(head(), head()->prev_, std::forward<Args>(what)...);
+			head()->prev_->next_ = node;
+			head()->prev_ = node;
 			++size_;
-			auto node = allocator_.allocate(1);
-			node_allocator_traits::construct(allocator_, node, head_, head_->prev_, std::forward<Args>(what)...);
-			head_->prev_->next_ = node;
-			head_->prev_ = node;
 
-			return node->value_;
+			return value_of(node);
 		}
 		
 		void pop_back() noexcept
 		{
-			assert(size_ != 0 && "cannot pop from empty container");
+			assert(!empty() && "cannot pop from empty container");
 
-			auto node = head_->prev_->prev_;
-			node_type::free_node(allocator_, head_->prev_);
-			head_->prev_ = node;
-			node->next_ = head_;
+			auto node = head()->prev_->prev_;
+			release_node(head()->prev_);
+			head()->prev_ = node;
+			node->next_ = head();
 			--size_;
 		}
 
@@ -892,39 +1437,41 @@ namespace my_lib
 			emplace_front(std::move(value));
 		}
 
+		void push_front(node_type&& handle)
+		{
+			insert(begin(), std::move(handle));
+		}
+
 		template <class... Args>
 		reference emplace_front(Args&&...what)
 		{
+			auto node = create_node(head()->next_, head(), std::forward<Args>(what)...);
+			head()->next_->prev_ = node;
+			head()->next_ = node;
 			++size_;
-			
-			auto node = allocator_.allocate(1);
-			node_allocator_traits::construct(allocator_, node, head_->next_, head_, std::forward<Args>(what)...);
-			head_->next_->prev_ = node;
-			head_->next_ = node;
 
-			return node->value_;
+			return value_of(node);
 		}
 
 		void pop_front() noexcept
 		{
-			assert(size_ != 0 && "cannot pop on empty container");
+			assert(!empty() && "cannot pop on empty container");
 			--size_;
-			auto node = head_->next_->next_;
-			node_type::free_node(allocator_, head_->next_);
-			head_->next_ = node;
-			node->prev_ = head_;
+			auto node = head()->next_->next_;
+			release_node(head()->next_);
+			head()->next_ = node;
+			node->prev_ = head();
 		}
 
 
 		void resize(size_type new_size)
 		{
-			if (size_ < new_size) {
-				for (size_type i{ size_ }; i < new_size; ++i) {
-					emplace_back();
-				}
+			auto count = size();
+			if (count < new_size) {
+				construct_n_default(new_size - count, head());
 			}
 			else {
-				while (new_size < size_) {
+				for (; new_size < count; --count) {
 					pop_back();
 				}
 			}
@@ -932,44 +1479,42 @@ namespace my_lib
 
 		void resize(size_type new_size, const_reference value) 
 		{
-			if (size_ < new_size) {
-				construct_n_copies(new_size - size_, value, head_->prev_);
+			auto count = size();
+			if (count < new_size) {
+				construct_n_copies(new_size - count, value, head());
 			}
 			else {
-				while (new_size < size_) {
+				for (; new_size < count; --count) {
 					pop_back();
 				}
 			}
 		}
 
 
-		void swap(list& rhs) noexcept(std::allocator_traits<node_allocator_type>::is_always_equal::value)
+		void swap(list& rhs) noexcept(node_allocator_traits::propagate_on_container_swap::value 
+			|| node_allocator_traits::is_always_equal::value)
 		{
 			if (this != std::addressof(rhs)) {
-				if (std::allocator_traits<node_allocator_type>::is_always_equal::value) {
+				if constexpr (node_allocator_traits::propagate_on_container_swap::value) {
 					std::swap(allocator_, rhs.allocator_);
 				}
+				else {
+					assert(allocator_ == rhs.allocator_ && "list allocators incompatible for swap");
+				}
 
-				std::swap(head_, rhs.head_);
+				// the heads stay where they are, only the links to them are swapped
+				std::swap(head_.next_, rhs.head_.next_);
+				std::swap(head_.prev_, rhs.head_.prev_);
 				std::swap(size_, rhs.size_);
+				std::swap(spare_, rhs.spare_); // they belong to the allocator
+				std::swap(recycling_, rhs.recycling_);
+				std::swap(size_stale_, rhs.size_stale_);
+				relink_head(rhs.head());
+				rhs.relink_head(head());
 			}
 		}
 
 	// Operations
-	private:
-		void unchecked_splice(nodeptr first, nodeptr last, nodeptr where)
-		{
-			first->prev_->next_ = last;
-			auto tmp = first->prev_;
-
-			where->prev_->next_ = first;
-			first->prev_ = where->prev_;
-			where->prev_ = last->prev_;
-			last->prev_->next_ = where;
-
-			last->prev_ = tmp;
-		}
-
 	public:
 		template <class Cmp = std::less<value_type>>
 		void merge(list& rhs, Cmp cmp = Cmp{})
@@ -979,55 +1524,21 @@ namespace my_lib
 		}
 
 	private:
-		// handmade sorted because std::sorted uses iterators (I have no unchecked iterators for now)
+		// handmade sorted because std::sorted uses iterators (I have no unchecked iterators for now).
+		// The front half checks every node with its next, the back half with its prev
 		template<class Cmp>
 		bool is_sorted(const list& list, Cmp cmp)
 		{
-			auto node = list.head_->next_;
-			auto end = list.head_->prev_;
-			for (; node != end; node = node->next_) {
-				if (cmp(node->next_->value_, node->value_)) {
-					return false;
-				}
-			}
-			return true;
-		}
-
-		//FIXME: unchecked
-		template <class Cmp>
-		nodeptr unchecked_merge(nodeptr lhsfirst, nodeptr lhslast, nodeptr rhsfirst, nodeptr rhslast, Cmp cmp) noexcept
-		{
-			auto node = lhsfirst->prev_;
-			while (lhsfirst != lhslast && rhsfirst != rhslast) {
-				if (!cmp(rhsfirst->value_, lhsfirst->value_)) {
-					node->next_ = lhsfirst;
-					node->next_->prev_ = node;
-					node = node->next_;
-					lhsfirst = lhsfirst->next_;
-				}
-				else {
-					node->next_ = rhsfirst;
-					node->next_->prev_ = node;
-					node = node->next_;
-					rhsfirst = rhsfirst->next_;
-				}
-			}
-
-			while (lhsfirst != lhslast) {
-				node->next_ = lhsfirst;
-				node->next_->prev_ = node;
-				node = node->next_;
-				lhsfirst = lhsfirst->next_;
-			}
-
-			while (rhsfirst != rhslast) {
-				node->next_ = rhsfirst;
-				node->next_->prev_ = node;
-				node = node->next_;
-				rhsfirst = rhsfirst->next_;
-			}
-
-			return node;
+			auto list_head = list.head();
+			auto sorted = true;
+			detail::walk_from_both_ends(list_head, [&](const nodeptr& node) {
+				sorted = node->next_ == list_head || !cmp(value_of(node->next_), value_of(node));
+				return !sorted;
+			}, [&](const nodeptr& node) {
+				sorted = node->prev_ == list_head || !cmp(value_of(node), value_of(node->prev_));
+				return !sorted;
+			});
+			return sorted;
 		}
 
 	public:
@@ -1038,45 +1549,56 @@ namespace my_lib
 
 			assert(get_allocator() == rhs.get_allocator() && "list allocator incompatible for merge");
 
-			if (rhs.size_ == 0) return;
+			if (rhs.empty()) return;
+			this->on_merge(rhs.counted_size());
 
-			if (size_ == 0) {
+			if (empty()) {
 				assert(is_sorted(rhs, cmp) && "sequence not ordered");
 				
-				if (!head_) {
-					head_ = node_type::create_head(allocator_);
-				}
-
-				unchecked_splice(rhs.begin().get_pointer(), rhs.end().get_pointer(), head_);
-				size_ = rhs.size_;
-				rhs.size_ = 0;
+				adopt(rhs.head()->next_, rhs.head());
+				detail::unchecked_splice(rhs.begin().get_pointer(), rhs.end().get_pointer(), head());
+				take_size(rhs);
 				return;
 			}
 
 			assert(is_sorted(*this, cmp) && is_sorted(rhs, cmp) && "sequence not ordered");
 	
-			auto lhsnode = head_->next_;
-			auto rhsnode = rhs.head_->next_;
-			auto node = unchecked_merge(lhsnode, head_, rhsnode, rhs.head_, cmp);
+			adopt(rhs.head()->next_, rhs.head());
+			auto node_cmp = [&cmp](const nodeptr& lhs, const nodeptr& rhs) { return cmp(value_of(lhs), value_of(rhs)); };
+			auto node = detail::unchecked_merge(head()->next_, head()->prev_, rhs.head()->next_, rhs.head()->prev_, node_cmp);
 
-			head_->prev_ = node;
-			node->next_ = head_;
-			size_ = size_ + rhs.size_;
+			head()->prev_ = node;
+			node->next_ = head();
+			take_size(rhs);
 
-			rhs.head_->next_ = rhs.head_;
-			rhs.head_->prev_ = rhs.head_;
-			rhs.size_ = 0;
+			rhs.head()->next_ = rhs.head();
+			rhs.head()->prev_ = rhs.head();
 		}
 
 
 		void splice(const_iterator pos, list& rhs) noexcept
 		{
-			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+			splice(pos, std::move(rhs));
 		}
 
+		// O(1) (the size of rhs is known, or stays stale), retagging makes it O(n) in checked mode
 		void splice(const_iterator pos, list&& rhs) noexcept
 		{
-			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+			auto where = pos.get_pointer();
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+			range_verify(where);
+			if (this == std::addressof(rhs) || rhs.empty()) return;
+
+			if (rhs.size_stale_) {
+				this->on_unsized_splice();
+			}
+			else {
+				this->on_splice(rhs.size_);
+			}
+			auto begin = rhs.head()->next_;
+			adopt(begin, rhs.head());
+			detail::unchecked_splice(begin, rhs.head(), where);
+			take_size(rhs);
 		}
 
 		void splice(const_iterator pos, list& rhs, const_iterator what)
@@ -1088,10 +1610,12 @@ namespace my_lib
 		{
 			auto where = pos.get_pointer();
 			auto what = it.get_pointer();
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
 			range_verify(where);
-			assert(what != rhs.head_ && "cannot move rhs head");
-			if (rhs.size_ == 0) return;
+			assert(what != rhs.head() && "cannot move rhs head");
+			if (rhs.empty() || what == where) return;
 			rhs.range_verify(what);
+			this->on_splice(1);
 
 			++size_;
 			--rhs.size_;
@@ -1100,9 +1624,10 @@ namespace my_lib
 			what->next_->prev_ = what->prev_;
 
 			where->prev_->next_ = what;
-			what->prev_ = where->prev_->prev_;
+			what->prev_ = where->prev_;
 			where->prev_ = what;
 			what->next_ = where;
+			adopt(what, where);
 		}
 
 		void splice(const_iterator pos, list& rhs, const_iterator first, const_iterator last) noexcept
@@ -1110,236 +1635,397 @@ namespace my_lib
 			splice(pos, std::move(rhs), first, last);
 		}
 
+		// Inside one list and with lazy_size O(1), else the range is counted
 		void splice(const_iterator pos, list&& rhs, const_iterator first, const_iterator last) noexcept
+		{
+			if (first == last) return;
+
+			if (this == std::addressof(rhs)) {
+				splice_range(pos, rhs, first, last, 0); // the size does not change
+				this->on_unsized_splice();
+			}
+			else if constexpr (sizing::lazy) {
+				splice_range(pos, rhs, first, last, 0);
+				size_stale_ = true;
+				rhs.size_stale_ = true;
+				this->on_unsized_splice();
+			}
+			else {
+				auto count = static_cast<size_type>(std::distance(first, last));
+				splice_range(pos, rhs, first, last, count);
+				this->on_splice(count);
+			}
+		}
+
+		void splice(const_iterator pos, list& rhs, const_iterator first, const_iterator last, size_type count) noexcept
+		{
+			splice(pos, std::move(rhs), first, last, count);
+		}
+
+		// count is std::distance(first, last), known by the caller: O(1) for any policy (checked mode retags in O(count))
+		void splice(const_iterator pos, list&& rhs, const_iterator first, const_iterator last, size_type count) noexcept
+		{
+			if constexpr (checking::enabled) {
+				assert(static_cast<size_type>(std::distance(first, last)) == count && "count is not the length of the range");
+			}
+			if (first == last) return;
+			splice_range(pos, rhs, first, last, this == std::addressof(rhs) ? 0 : count);
+			this->on_splice(count);
+		}
+
+	private:
+		// Relinks [first, last) of rhs before pos, count elements change the list
+		void splice_range(const_iterator pos, list& rhs, const_iterator first, const_iterator last, size_type count) noexcept
 		{
 			auto begin = first.get_pointer();
 			auto end = last.get_pointer();
 			auto where = pos.get_pointer();
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
 			range_verify(where);
-			if (rhs.size_ == 0) return;
-			assert(begin != end && "trying to splice empty range");
 			rhs.range_verify(begin);
 			rhs.range_verify(end);
+			assert(begin != rhs.head() && "cannot move rhs head");
 
-			size_type range_size = std::distance(first, last);
-			rhs.size_ -= range_size;
-			size_ += range_size;
+			rhs.size_ -= count;
+			size_ += count;
 
-			unchecked_splice(begin, end, where);
+			adopt(begin, end);
+			detail::unchecked_splice(begin, end, where);
 		}
 
+	public:
+
 
 		void remove(const_reference value) noexcept
 		{
-			auto node = head_->next_;
-			while (node != head_)
-			{
-				auto tmp = node->next_;
-				if (node->value_ == value) {
-					node->prev_->next_ = node->next_;
-					node->next_->prev_ = node->prev_;
-					
-					node_type::free_node(allocator_, node);
-					--size_;
-				}
-				node = tmp;
-			} 
+			remove_if([&value](const_reference elem) { return elem == value; });
 		}
 
 		template <class Predicate>
 		void remove_if(Predicate pred)
 		{
-			auto node = head_->next_;
-			while (node != head_)
-			{
-				auto tmp = node->next_;
-				if (pred(node->value_)) {
+			auto visited = counted_size();
+			detail::walk_forward(head()->next_, head(), [this, &pred](const nodeptr& node) {
+				if (pred(value_of(node))) {
 					node->prev_->next_ = node->next_;
 					node->next_->prev_ = node->prev_;
 
-					node_type::free_node(allocator_, node);
+					release_node(node);
 					--size_;
 				}
-				node = tmp;
-			}
+				return false;
+			});
+			this->on_traversal(visited);
 		}
 
 
 		void reverse() noexcept
 		{
-			if (!head_ || size_ == 0) return;
-			auto begin = head_->next_;
-			auto end = head_->prev_;
-
-			size_type i{};
-			auto half_size = size_ / 2;
-			while (i < half_size) {
-				auto first = begin;
-				auto last = end;
-				begin = begin->next_;
-				end = end->prev_;
-
-				last->prev_->next_ = first;
-				last->next_->prev_ = first;
-
-				first->prev_->next_ = last;
-				first->next_->prev_ = last;
-
-				std::swap(first->next_, last->next_);
-				std::swap(last->prev_, first->prev_);
-
-				++i;
-			}
+			if (head()->next_ == head()->prev_) return; // 0 or 1 element
+			detail::reverse_chain(head());
 		}
 
 		void unique() noexcept
 		{
-			auto node = head_->next_;
-			while (node != head_->prev_) {
-				if (node->next_->value_ == node->value_) {
-					auto tmp = node->next_;
-					node->next_ = node->next_->next_;
-					node->next_->prev_ = node;
-					node_type::free_node(allocator_, tmp);
-					--size_;
-				}
-				else {
-					node = node->next_;
-				}
-			}
+			unique(std::equal_to<>{});
 		}
 
+		// every node is compared with the last kept one
 		template <class BinaryPredicate>
 		void unique(BinaryPredicate pred)
 		{
-			auto node = head_->next_;
-			while (node != head_->prev_) {
-				if (pred(node->value_, node->next_->value_)) {
-					auto tmp = node->next_;
-					node->next_ = node->next_->next_;
-					node->next_->prev_ = node;
-					node_type::free_node(allocator_, tmp);
+			auto kept = head()->next_;
+			if (kept == head()) return;
+
+			auto visited = counted_size();
+			detail::walk_forward(kept->next_, head(), [this, &pred, &kept](const nodeptr& node) {
+				if (pred(value_of(kept), value_of(node))) {
+					kept->next_ = node->next_;
+					node->next_->prev_ = kept;
+					release_node(node);
 					--size_;
 				}
 				else {
-					node = node->next_;
+					kept = node;
 				}
-			}
+				return false;
+			});
+			this->on_traversal(visited);
 		}
 
-	private:
-		template <class BinaryPred>
-		nodeptr Sort(nodeptr begin, size_type size, BinaryPred pred)
+	// Traversal
+	public:
+		// Calls f on every element in order and returns it, like std::for_each. Walks the nodes without
+		// iterators and prefetches the next one (detail::walk_forward)
+		template <class Function>
+		Function for_each(Function f)
 		{
-			if (size <= 1) return begin;
+			auto visited = counted_size();
+			detail::walk_forward(head()->next_, head(), [&f](const nodeptr& node) { f(value_of(node)); return false; });
+			this->on_traversal(visited);
+			return f;
+		}
 
-			auto mid = size / 2;
-			auto left = begin;
-			auto right = begin;
-			for (size_type j{}; j < mid; ++j) {
-				right = right->next_;
-			}
+		template <class Function>
+		Function for_each(Function f) const
+		{
+			auto visited = counted_size();
+			detail::walk_forward(head()->next_, head(), [&f](const nodeptr& node) { f(std::as_const(value_of(node))); return false; });
+			this->on_traversal(visited);
+			return f;
+		}
 
-			left = Sort(left, mid, pred);
-			right = Sort(right, size - mid, pred);
+		// Left fold in order, like std::accumulate
+		template <class U, class BinaryOp = std::plus<>>
+		[[nodiscard]] U accumulate(U init, BinaryOp op = BinaryOp{}) const
+		{
+			auto visited = counted_size();
+			detail::walk_forward(head()->next_, head(), [&init, &op](const nodeptr& node) {
+				init = op(std::move(init), std::as_const(value_of(node)));
+				return false;
+			});
+			this->on_traversal(visited);
+			return init;
+		}
 
-			auto end = right;
-			for (size_type j{}; j < size - mid; ++j) {
-				end = end->next_;
-			}
+		// First element equal to value, end() if none. Searches from both ends at once (detail::walk_from_both_ends),
+		// so on a scattered list a miss costs about half of std::find
+		[[nodiscard]] iterator find(const_reference value)
+		{
+			return iterator{ this, find_node([&value](const_reference elem) { return elem == value; }) };
+		}
 
-			auto node = unchecked_merge(left, right, right, end, pred);
-			end->prev_ = node;
-			node->next_ = end;
+		[[nodiscard]] const_iterator find(const_reference value) const
+		{
+			return const_iterator{ this, find_node([&value](const_reference elem) { return elem == value; }) };
+		}
 
-			// FIXME: That's stupid, but works-_-
-			for (size_type i{}; i < size; ++i) {
-				end = end->prev_;
-			}
+		// Like find(value). pred must not have side effects: it is called in no particular order and
+		// maybe on elements after the first match
+		template <class Predicate>
+		[[nodiscard]] iterator find_if(Predicate pred)
+		{
+			return iterator{ this, find_node(pred) };
+		}
+
+		template <class Predicate>
+		[[nodiscard]] const_iterator find_if(Predicate pred) const
+		{
+			return const_iterator{ this, find_node(pred) };
+		}
+
+		[[nodiscard]] bool contains(const_reference value) const
+		{
+			return find(value) != end();
+		}
+
+		// Number of elements equal to value. Both ends at once like find, every match is added
+		// without a branch, so for arithmetic T a mix of matches costs no mispredictions
+		[[nodiscard]] size_type count(const_reference value) const
+		{
+			return count_if([&value](const_reference elem) { return elem == value; });
+		}
+
+		template <class Predicate>
+		[[nodiscard]] size_type count_if(Predicate pred) const
+		{
+			size_type front_count{};
+			size_type back_count{};
+			auto visited = detail::walk_from_both_ends(head(), [&](const nodeptr& node) {
+				front_count += static_cast<size_type>(static_cast<bool>(pred(std::as_const(value_of(node)))));
+				return false;
+			}, [&](const nodeptr& node) {
+				back_count += static_cast<size_type>(static_cast<bool>(pred(std::as_const(value_of(node)))));
+				return false;
+			});
+			this->on_traversal(visited);
+			return front_count + back_count;
+		}
+
+		// First smallest / largest element, end() if empty. Like std::min_element / max_element, from both ends
+		template <class Cmp = std::less<value_type>>
+		[[nodiscard]] iterator min_element(Cmp cmp = Cmp{})
+		{
+			return iterator{ this, extreme_node([&cmp](const_reference lhs, const_reference rhs) { return cmp(lhs, rhs); }) };
+		}
 
-			return end; // new begin
+		template <class Cmp = std::less<value_type>>
+		[[nodiscard]] const_iterator min_element(Cmp cmp = Cmp{}) const
+		{
+			return const_iterator{ this, extreme_node([&cmp](const_reference lhs, const_reference rhs) { return cmp(lhs, rhs); }) };
+		}
+
+		template <class Cmp = std::less<value_type>>
+		[[nodiscard]] iterator max_element(Cmp cmp = Cmp{})
+		{
+			return iterator{ this, extreme_node([&cmp](const_reference lhs, const_reference rhs) { return cmp(rhs, lhs); }) };
 		}
+
+		template <class Cmp = std::less<value_type>>
+		[[nodiscard]] const_iterator max_element(Cmp cmp = Cmp{}) const
+		{
+			return const_iterator{ this, extreme_node([&cmp](const_reference lhs, const_reference rhs) { return cmp(rhs, lhs); }) };
+		}
+
+	private:
+		// better(lhs, rhs): lhs strictly better. The front cursor keeps its first best, the back cursor
+		// takes ties, so it ends with the first best of the back half
+		template <class Better>
+		nodeptr extreme_node(Better better) const
+		{
+			auto front_best = head()->next_;
+			auto back_best = head();
+			auto visited = detail::walk_from_both_ends(head(), [&](const nodeptr& node) {
+				if (better(value_of(node), value_of(front_best))) {
+					front_best = node;
+				}
+				return false;
+			}, [&](const nodeptr& node) {
+				if (back_best == head() || !better(value_of(back_best), value_of(node))) {
+					back_best = node;
+				}
+				return false;
+			});
+			this->on_traversal(visited);
+			return back_best != head() && better(value_of(back_best), value_of(front_best)) ? back_best : front_best;
+		}
+
+		// The front cursor stops at its first match. The back cursor goes on until they meet,
+		// its last match is the first one of the back half
+		template <class Predicate>
+		nodeptr find_node(Predicate pred) const
+		{
+			auto front_match = head();
+			auto back_match = head();
+			auto visited = detail::walk_from_both_ends(head(), [&](const nodeptr& node) {
+				if (!pred(std::as_const(value_of(node)))) return false;
+				front_match = node;
+				return true;
+			}, [&](const nodeptr& node) {
+				if (pred(std::as_const(value_of(node)))) {
+					back_match = node;
+				}
+				return false;
+			});
+			this->on_traversal(visited);
+			return front_match != head() ? front_match : back_match;
+		}
+
+		// Both lists from both ends: four independent chases (operator==)
+		bool equal(const list& rhs) const
+		{
+			auto rhs_front = rhs.head()->next_;
+			auto rhs_back = rhs.head()->prev_;
+			auto same = true;
+			detail::walk_from_both_ends(head(), [&](const nodeptr& node) {
+				same = value_of(node) == value_of(rhs_front);
+				rhs_front = rhs_front->next_;
+				detail::prefetch_node(rhs_front);
+				return !same;
+			}, [&](const nodeptr& node) {
+				same = value_of(node) == value_of(rhs_back);
+				rhs_back = rhs_back->prev_;
+				detail::prefetch_node(rhs_back);
+				return !same;
+			});
+			return same;
+		}
+
+		// lexicographical compare, needs the order so one cursor per list (operator<)
+		bool less(const list& rhs) const
+		{
+			auto rhs_node = rhs.head()->next_;
+			auto result = false;
+			auto stop = detail::walk_forward(head()->next_, head(), [&](const nodeptr& node) {
+				if (rhs_node == rhs.head()) return true; // rhs is a prefix of lhs
+				if (value_of(node) < value_of(rhs_node)) {
+					result = true;
+					return true;
+				}
+				if (value_of(rhs_node) < value_of(node)) return true;
+				rhs_node = rhs_node->next_;
+				detail::prefetch_node(rhs_node);
+				return false;
+			});
+			return stop == head() ? rhs_node != rhs.head() : result;
+		}
+
+		template <class T2, class Alloc2, class Checking2, class Sizing2, class Stats2>
+		friend bool operator==(const list<T2, Alloc2, Checking2, Sizing2, Stats2>& lhs, const list<T2, Alloc2, Checking2, Sizing2, Stats2>& rhs) noexcept;
+
+		template <class T2, class Alloc2, class Checking2, class Sizing2, class Stats2>
+		friend bool operator<(const list<T2, Alloc2, Checking2, Sizing2, Stats2>& lhs, const list<T2, Alloc2, Checking2, Sizing2, Stats2>& rhs) noexcept;
+
 	public:
+		// Bottom-up merge sort (detail::sort_chain). Only links are changed, so all iterators stay valid
 		template <class BinaryPred = std::less<value_type>>
 		void sort(BinaryPred pred = BinaryPred{})
 		{
-			if (head_) {
-				Sort(head_->next_, size_, pred);
-			}
+			if (head()->next_ == head()->prev_) return; // 0 or 1 element
+
+			auto start = this->sort_start();
+			auto node_pred = [&pred](const nodeptr& lhs, const nodeptr& rhs) { return pred(value_of(lhs), value_of(rhs)); };
+			detail::sort_chain(head(), node_pred);
+			this->on_sort(counted_size(), start);
 		}
 
+	// Statistics (collect_stats only, see list_stats.hpp)
+	public:
+		// A snapshot of the counters, may be taken from another thread while the list is used
+		template <class S = Stats, std::enable_if_t<S::enabled, int> = 0>
+		[[nodiscard]] auto stats() const noexcept // list_statistics
+		{
+			return this->counters_.snapshot();
+		}
+
+		template <class S = Stats, std::enable_if_t<S::enabled, int> = 0>
+		void reset_stats() noexcept
+		{
+			this->counters_.reset();
+		}
 	};
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator==(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
 		if (std::addressof(rhs) == std::addressof(lhs)) return true;
-		auto lhssize = lhs.size();
-		auto rhssize = rhs.size();
-		if (lhssize != rhssize) return false;
-
-		auto lhsnode = lhs.begin().get_pointer();
-		auto rhsnode = rhs.begin().get_pointer();
-		for (std::size_t i{}; i < lhssize; ++i) {
-			if (!(lhsnode->value_ == rhsnode->value_))
-			{
-				return false;
-			}
-			rhsnode = rhsnode->next_;
-			lhsnode = lhsnode->next_;
-		}
-		return true;
+		return lhs.size() == rhs.size() && lhs.equal(rhs);
 	}
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator!=(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
 		return !(lhs == rhs);
 	}
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator<(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
-		if (std::addressof(rhs) == std::addressof(lhs)) return true;
-		auto lhssize = lhs.size();
-		auto rhssize = rhs.size();
-		if (lhssize != rhssize) return false;
-
-		auto lhsnode = lhs.begin().get_pointer();
-		auto rhsnode = rhs.begin().get_pointer();
-		for (std::size_t i{}; i < lhssize; ++i) {
-			if ( rhsnode->value_ < lhsnode->value_)
-			{
-				return false;
-			}
-			rhsnode = rhsnode->next_;
-			lhsnode = lhsnode->next_;
-		}
-		return true;
+		return lhs.less(rhs);
 	}
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator>(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
 		return rhs < lhs;
 	}
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator<=(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
 		return !(rhs < lhs);
 	}
 
-	template <class T, class Alloc>
-	[[nodiscard]] bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) noexcept
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	[[nodiscard]] bool operator>=(const list<T, Alloc, Checking, Sizing, Stats>& lhs, const list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept
 	{
 		return !(lhs < rhs);
 	}
 }
 
 namespace std {
-	template <class T, class Alloc>
-	void swap(my_lib::list<T, Alloc>& lhs, my_lib::list<T, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	template <class T, class Alloc, class Checking, class Sizing, class Stats>
+	void swap(my_lib::list<T, Alloc, Checking, Sizing, Stats>& lhs, my_lib::list<T, Alloc, Checking, Sizing, Stats>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,326 @@
+#pragma once
+#ifndef MY_LIB_LIST_STATS
+#define MY_LIB_LIST_STATS
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "list.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * log2_histogram
+	 * list_statistics
+	 * detail::list_counters
+	 * detail::list_stats_base
+	 *
+	 * Operation counters of my_lib::list, for finding the hot lists of a running program. list.hpp only has the
+	 * hooks, a list with collect_stats needs this header (else its base class is incomplete):
+	 *     #include "list_stats.hpp"
+	 *     my_lib::list<int, std::allocator<int>, my_lib::unchecked_iterators, my_lib::eager_size, my_lib::collect_stats> list;
+	 *     ...
+	 *     std::puts(list.stats().to_json().c_str());
+	 * With no_stats (the default) the counting calls are empty inline functions and the list does not get bigger,
+	 * collect_stats adds about 900 bytes of counters to it.
+	 * The counters are relaxed atomics: stats() may be called from another thread while the list is used,
+	 * and the const functions that count (find, count, for_each...) stay safe to call concurrently, but then
+	 * an increment may be lost (they are a load and a store, not a locked add). Counts, not an audit trail.
+	 * They belong to the list object: copies start at zero, swap and move do not exchange them.
+	 * A node freed by a node handle outside the list, and the nodes freed by the destructor, are not counted.
+	 */
+
+	// Bucket 0 counts the zeros, bucket k the values in [2^(k-1), 2^k), the last one everything above
+	struct log2_histogram
+	{
+		static constexpr std::size_t bucket_count{ 32 };
+
+		std::array<std::uint64_t, bucket_count> buckets_{};
+
+		[[nodiscard]] static std::size_t bucket_of(std::uint64_t value) noexcept
+		{
+			std::size_t bucket{};
+#if defined(__GNUC__) || defined(__clang__)
+			bucket = value == 0 ? 0 : static_cast<std::size_t>(64 - __builtin_clzll(value));
+#else
+			for (; value != 0 && bucket + 1 < bucket_count; value >>= 1) {
+				++bucket;
+			}
+#endif
+			return bucket < bucket_count ? bucket : bucket_count - 1;
+		}
+	};
+
+	// A snapshot of the counters of one list (list::stats())
+	struct list_statistics
+	{
+		std::uint64_t allocations_{}; // nodes from the allocator
+		std::uint64_t batch_allocations_{}; // allocate_batch calls (node_pool), their nodes are in allocations_
+		std::uint64_t frees_{}; // nodes given back to the allocator
+		std::uint64_t recycled_{}; // nodes taken from the spares instead of the allocator (reserve)
+
+		std::uint64_t traversals_{}; // remove, remove_if, unique, for_each, accumulate, find, count, min / max_element
+		std::uint64_t nodes_visited_{};
+		log2_histogram traversal_lengths_{};
+
+		std::uint64_t splices_{};
+		std::uint64_t unsized_splices_{}; // lazy_size range splices, the length is not known so not in splice_sizes_
+		log2_histogram splice_sizes_{};
+
+		std::uint64_t merges_{};
+		std::uint64_t merged_nodes_{}; // nodes that came from the other list
+
+		std::uint64_t sorts_{};
+		log2_histogram sort_sizes_{};
+		std::uint64_t sort_ns_{}; // total
+		std::uint64_t max_sort_ns_{};
+
+		// One JSON object. A histogram is an array of its buckets (see log2_histogram) without the trailing zeros
+		[[nodiscard]] std::string to_json() const
+		{
+			std::string json{ "{" };
+			auto add = [&json](const char* name, std::uint64_t value) {
+				json += '"';
+				json += name;
+				json += "\":";
+				json += std::to_string(value);
+				json += ',';
+			};
+			auto add_histogram = [&json](const char* name, const log2_histogram& histogram) {
+				json += '"';
+				json += name;
+				json += "\":[";
+				auto used = histogram.buckets_.size();
+				while (used != 0 && histogram.buckets_[used - 1] == 0) {
+					--used;
+				}
+				for (std::size_t i{}; i < used; ++i) {
+					if (i != 0) json += ',';
+					json += std::to_string(histogram.buckets_[i]);
+				}
+				json += "],";
+			};
+
+			add("allocations", allocations_);
+			add("batch_allocations", batch_allocations_);
+			add("frees", frees_);
+			add("recycled", recycled_);
+			add("traversals", traversals_);
+			add("nodes_visited", nodes_visited_);
+			add_histogram("traversal_lengths", traversal_lengths_);
+			add("splices", splices_);
+			add("unsized_splices", unsized_splices_);
+			add_histogram("splice_sizes", splice_sizes_);
+			add("merges", merges_);
+			add("merged_nodes", merged_nodes_);
+			add("sorts", sorts_);
+			add_histogram("sort_sizes", sort_sizes_);
+			add("sort_ns", sort_ns_);
+			add("max_sort_ns", max_sort_ns_);
+			json.back() = '}'; // the last comma
+			return json;
+		}
+	};
+
+	namespace detail
+	{
+		// The live counters of list_statistics. A copy starts at zero
+		class list_counters
+		{
+			using counter = std::atomic<std::uint64_t>;
+			using histogram = std::array<counter, log2_histogram::bucket_count>;
+
+			counter allocations_{};
+			counter batch_allocations_{};
+			counter frees_{};
+			counter recycled_{};
+			counter traversals_{};
+			counter nodes_visited_{};
+			histogram traversal_lengths_{};
+			counter splices_{};
+			counter unsized_splices_{};
+			histogram splice_sizes_{};
+			counter merges_{};
+			counter merged_nodes_{};
+			counter sorts_{};
+			histogram sort_sizes_{};
+			counter sort_ns_{};
+			counter max_sort_ns_{};
+
+			// not a fetch_add: a locked add per operation doubled the cost of a splice
+			static void add(counter& to, std::uint64_t value) noexcept
+			{
+				to.store(to.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			}
+
+			static void add(histogram& to, std::uint64_t value) noexcept
+			{
+				add(to[log2_histogram::bucket_of(value)], 1);
+			}
+
+			[[nodiscard]] static std::uint64_t load(const counter& from) noexcept
+			{
+				return from.load(std::memory_order_relaxed);
+			}
+
+			static void load(const histogram& from, log2_histogram& to) noexcept
+			{
+				for (std::size_t i{}; i < from.size(); ++i) {
+					to.buckets_[i] = load(from[i]);
+				}
+			}
+
+			static void clear(counter& what) noexcept
+			{
+				what.store(0, std::memory_order_relaxed);
+			}
+
+			static void clear(histogram& what) noexcept
+			{
+				for (auto& bucket : what) {
+					clear(bucket);
+				}
+			}
+
+			// Ctors
+		public:
+			list_counters() noexcept = default;
+
+			list_counters(const list_counters&) noexcept {}
+
+			list_counters& operator=(const list_counters&) noexcept
+			{
+				return *this;
+			}
+
+			// Counting
+		public:
+			void allocated(std::uint64_t count) noexcept
+			{
+				add(allocations_, count);
+			}
+
+			void batch_allocated(std::uint64_t count) noexcept
+			{
+				add(batch_allocations_, 1);
+				add(allocations_, count);
+			}
+
+			void freed(std::uint64_t count) noexcept
+			{
+				add(frees_, count);
+			}
+
+			void recycled() noexcept
+			{
+				add(recycled_, 1);
+			}
+
+			void traversed(std::uint64_t nodes) noexcept
+			{
+				add(traversals_, 1);
+				add(nodes_visited_, nodes);
+				add(traversal_lengths_, nodes);
+			}
+
+			void spliced(std::uint64_t nodes) noexcept
+			{
+				add(splices_, 1);
+				add(splice_sizes_, nodes);
+			}
+
+			void spliced_unsized() noexcept
+			{
+				add(splices_, 1);
+				add(unsized_splices_, 1);
+			}
+
+			void merged(std::uint64_t nodes) noexcept
+			{
+				add(merges_, 1);
+				add(merged_nodes_, nodes);
+			}
+
+			void sorted(std::uint64_t nodes, std::uint64_t ns) noexcept
+			{
+				add(sorts_, 1);
+				add(sort_sizes_, nodes);
+				add(sort_ns_, ns);
+				if (load(max_sort_ns_) < ns) {
+					max_sort_ns_.store(ns, std::memory_order_relaxed);
+				}
+			}
+
+			// Reading
+		public:
+			[[nodiscard]] list_statistics snapshot() const noexcept
+			{
+				list_statistics result{};
+				result.allocations_ = load(allocations_);
+				result.batch_allocations_ = load(batch_allocations_);
+				result.frees_ = load(frees_);
+				result.recycled_ = load(recycled_);
+				result.traversals_ = load(traversals_);
+				result.nodes_visited_ = load(nodes_visited_);
+				load(traversal_lengths_, result.traversal_lengths_);
+				result.splices_ = load(splices_);
+				result.unsized_splices_ = load(unsized_splices_);
+				load(splice_sizes_, result.splice_sizes_);
+				result.merges_ = load(merges_);
+				result.merged_nodes_ = load(merged_nodes_);
+				result.sorts_ = load(sorts_);
+				load(sort_sizes_, result.sort_sizes_);
+				result.sort_ns_ = load(sort_ns_);
+				result.max_sort_ns_ = load(max_sort_ns_);
+				return result;
+			}
+
+			void reset() noexcept
+			{
+				for (auto* what : { &allocations_, &batch_allocations_, &frees_, &recycled_, &traversals_, &nodes_visited_,
+					&splices_, &unsized_splices_, &merges_, &merged_nodes_, &sorts_, &sort_ns_, &max_sort_ns_ }) {
+					clear(*what);
+				}
+				clear(traversal_lengths_);
+				clear(splice_sizes_);
+				clear(sort_sizes_);
+			}
+		};
+
+		// Base of a my_lib::list with collect_stats (list_stats_base<false> is in list.hpp)
+		template <bool Enabled>
+		class list_stats_base
+		{
+			using clock_type = std::chrono::steady_clock;
+
+		protected:
+			mutable list_counters counters_;
+
+			void on_allocate(std::size_t count) const noexcept { counters_.allocated(count); }
+			void on_batch_allocate(std::size_t count) const noexcept { counters_.batch_allocated(count); }
+			void on_free(std::size_t count) const noexcept { counters_.freed(count); }
+			void on_recycle() const noexcept { counters_.recycled(); }
+			void on_traversal(std::size_t nodes) const noexcept { counters_.traversed(nodes); }
+			void on_splice(std::size_t nodes) const noexcept { counters_.spliced(nodes); }
+			void on_unsized_splice() const noexcept { counters_.spliced_unsized(); }
+			void on_merge(std::size_t nodes) const noexcept { counters_.merged(nodes); }
+
+			[[nodiscard]] static clock_type::time_point sort_start() noexcept
+			{
+				return clock_type::now();
+			}
+
+			void on_sort(std::size_t nodes, clock_type::time_point start) const noexcept
+			{
+				auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start);
+				counters_.sorted(nodes, static_cast<std::uint64_t>(elapsed.count()));
+			}
+		};
+	}
+}
+
+#endif
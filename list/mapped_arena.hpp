@@ -0,0 +1,452 @@
+#pragma once
+#ifndef MY_LIB_MAPPED_ARENA
+#define MY_LIB_MAPPED_ARENA
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <limits>
+#include <new>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "offset_ptr.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * detail::arena_header
+	 * mapped_arena
+	 * mapped_arena_allocator
+	 *
+	 * mapped_arena maps a file and hands out blocks from it. Everything it keeps is an offset from the start
+	 * of the file, and mapped_arena_allocator uses offset_ptr, so a my_lib::list built in the arena is reopened
+	 * after a restart as it was: an mmap and a header check, no allocation or construction per element.
+	 *     my_lib::mapped_arena arena{ "values.arena", 1 << 30 }; // opened, or created with 1 GiB
+	 *     using list_type = my_lib::list<int, my_lib::mapped_arena_allocator<int>>;
+	 *     auto& values = arena.find_or_construct<list_type>(my_lib::mapped_arena_allocator<int>{ arena });
+	 * The values must not hold pointers out of the arena (int, double, structs of those).
+	 * Blocks of up to 512 bytes are recycled through one free list per size, bigger ones are not reused.
+	 * The file does not grow: allocate throws std::bad_alloc when it is full.
+	 * No crash consistency: a file left open by a process that died is refused when opened again.
+	 * One process and one thread at a time.
+	 */
+
+	namespace detail
+	{
+		// The start of the file. Blocks are found by their offset from here
+		struct arena_header
+		{
+			static constexpr std::uint64_t magic_value{ 0x3152'4142'494c'594d }; // "MYLIBAR1"
+			static constexpr std::uint32_t current_version{ 1 };
+			static constexpr std::size_t granule{ 8 }; // block sizes and alignment
+			static constexpr std::size_t class_count{ 64 }; // free lists for blocks of 8 .. 512 bytes
+			static constexpr std::size_t max_class_bytes{ granule * class_count };
+
+			std::uint64_t magic_;
+			std::uint32_t version_;
+			std::uint32_t pointer_size_; // offset_ptr and size_t of the program that made the file
+			std::uint64_t capacity_; // bytes of the file
+			std::uint64_t used_; // bump offset, everything after it was never handed out
+			std::uint64_t live_; // blocks handed out
+			std::uint64_t root_; // offset of the root object, 0 if there is none
+			std::uint64_t root_size_;
+			std::uint64_t root_align_;
+			std::uint64_t in_use_; // 1 while a mapped_arena has the file open
+			std::uint64_t free_[class_count]; // offset of the first free block of each size, 0 if none
+
+			explicit arena_header(std::uint64_t capacity) noexcept
+				: magic_{ magic_value }, version_{ current_version }, pointer_size_{ sizeof(void*) }, capacity_{ capacity },
+				used_{ round_up(sizeof(arena_header), alignof(std::max_align_t)) }, live_{}, root_{}, root_size_{}, root_align_{},
+				in_use_{}, free_{}
+			{
+			}
+
+			[[nodiscard]] static constexpr std::size_t round_up(std::size_t size, std::size_t align) noexcept
+			{
+				return (size + align - 1) / align * align;
+			}
+
+			[[nodiscard]] std::byte* base() noexcept
+			{
+				return reinterpret_cast<std::byte*>(this);
+			}
+
+			[[nodiscard]] std::uint64_t offset_of(const void* ptr) noexcept
+			{
+				return static_cast<std::uint64_t>(static_cast<const std::byte*>(ptr) - base());
+			}
+
+			// bump allocation, nullptr if the rest of the file is too short
+			[[nodiscard]] void* bump(std::size_t bytes, std::size_t align) noexcept
+			{
+				auto first = round_up(static_cast<std::size_t>(used_), align);
+				if (first > capacity_ || capacity_ - first < bytes) return nullptr;
+				used_ = first + bytes;
+				return base() + first;
+			}
+
+			[[nodiscard]] void* allocate(std::size_t bytes, std::size_t align)
+			{
+				bytes = round_up(bytes == 0 ? 1 : bytes, granule);
+				if (bytes <= max_class_bytes && align <= granule) {
+					auto& head = free_[bytes / granule - 1];
+					if (head != 0) {
+						auto block = base() + head;
+						head = *reinterpret_cast<std::uint64_t*>(block);
+						++live_;
+						return block;
+					}
+				}
+
+				auto block = bump(bytes, align < granule ? granule : align);
+				if (!block) {
+					throw std::bad_alloc{};
+				}
+				++live_;
+				return block;
+			}
+
+			// count blocks of block_bytes in a row, nullptr if the bump area is too short
+			[[nodiscard]] void* allocate_batch(std::size_t block_bytes, std::size_t count) noexcept
+			{
+				if (count == 0 || block_bytes > (capacity_ - used_) / count) return nullptr;
+				auto block = bump(block_bytes * count, granule);
+				if (block) {
+					live_ += count;
+				}
+				return block;
+			}
+
+			void deallocate(void* ptr, std::size_t bytes) noexcept
+			{
+				assert(live_ != 0 && "deallocate on empty mapped_arena");
+				--live_;
+				bytes = round_up(bytes == 0 ? 1 : bytes, granule);
+				if (bytes > max_class_bytes) return; // not reused
+
+				auto& head = free_[bytes / granule - 1];
+				*static_cast<std::uint64_t*>(ptr) = head;
+				head = offset_of(ptr);
+			}
+		};
+	}
+
+	class mapped_arena
+	{
+	private:
+		detail::arena_header* header_{};
+		std::size_t bytes_{};
+		bool created_{};
+#ifdef _WIN32
+		HANDLE file_{ INVALID_HANDLE_VALUE };
+		HANDLE mapping_{};
+#else
+		int file_{ -1 };
+#endif
+
+		// Ctors
+	public:
+		// Opens the arena in the file at path, or makes the file with capacity bytes if it does not exist or is empty.
+		// An existing file keeps its own capacity. Throws std::runtime_error if the file cannot be mapped or is not
+		// an arena of this build
+		mapped_arena(const std::string& path, std::size_t capacity)
+		{
+			try {
+				map(path, capacity);
+				if (created_) {
+					::new (static_cast<void*>(header_)) detail::arena_header{ bytes_ };
+				}
+				else {
+					check(path);
+				}
+				header_->in_use_ = 1;
+			}
+			catch (...) {
+				unmap();
+				throw;
+			}
+		}
+
+		mapped_arena(const mapped_arena&)				= delete;
+		mapped_arena& operator=(const mapped_arena&)	= delete;
+
+		// The objects in the arena are not destroyed, they are there when the file is opened again
+		~mapped_arena()
+		{
+			header_->in_use_ = 0;
+			sync();
+			unmap();
+		}
+
+	private:
+		[[noreturn]] static void fail(const std::string& what, const std::string& path)
+		{
+			throw std::runtime_error{ "mapped_arena: " + what + " (" + path + ")" };
+		}
+
+		void map(const std::string& path, std::size_t capacity)
+		{
+			void* memory{};
+#ifdef _WIN32
+			file_ = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file_ == INVALID_HANDLE_VALUE) {
+				fail("cannot open the file", path);
+			}
+
+			LARGE_INTEGER size{};
+			if (!::GetFileSizeEx(file_, &size)) {
+				fail("cannot read the file size", path);
+			}
+			created_ = size.QuadPart == 0;
+			if (created_ && capacity < sizeof(detail::arena_header)) {
+				fail("capacity smaller than the arena header", path);
+			}
+			auto bytes = created_ ? static_cast<std::uint64_t>(capacity) : static_cast<std::uint64_t>(size.QuadPart);
+
+			// a mapping bigger than the file grows it
+			mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes >> 32), static_cast<DWORD>(bytes), nullptr);
+			if (!mapping_) {
+				fail("cannot map the file", path);
+			}
+			memory = ::MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(bytes));
+			if (!memory) {
+				fail("cannot map the file", path);
+			}
+#else
+			file_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+			if (file_ < 0) {
+				fail("cannot open the file", path);
+			}
+
+			struct stat status{};
+			if (::fstat(file_, &status) != 0) {
+				fail("cannot read the file size", path);
+			}
+			created_ = status.st_size == 0;
+			if (created_ && capacity < sizeof(detail::arena_header)) {
+				fail("capacity smaller than the arena header", path);
+			}
+			auto bytes = created_ ? static_cast<std::uint64_t>(capacity) : static_cast<std::uint64_t>(status.st_size);
+			if (created_ && ::ftruncate(file_, static_cast<off_t>(bytes)) != 0) {
+				fail("cannot resize the file", path);
+			}
+
+			memory = ::mmap(nullptr, static_cast<std::size_t>(bytes), PROT_READ | PROT_WRITE, MAP_SHARED, file_, 0);
+			if (memory == MAP_FAILED) {
+				fail("cannot map the file", path);
+			}
+#endif
+			header_ = static_cast<detail::arena_header*>(memory);
+			bytes_ = static_cast<std::size_t>(bytes);
+		}
+
+		void check(const std::string& path) const
+		{
+			if (bytes_ < sizeof(detail::arena_header) || header_->magic_ != detail::arena_header::magic_value) {
+				fail("not an arena file", path);
+			}
+			if (header_->version_ != detail::arena_header::current_version || header_->pointer_size_ != sizeof(void*)) {
+				fail("arena made by another version or build", path);
+			}
+			if (header_->capacity_ != bytes_ || header_->used_ > bytes_) {
+				fail("arena file truncated or corrupt", path);
+			}
+			if (header_->in_use_ != 0) {
+				fail("arena open in another process or not closed (the owner died)", path);
+			}
+		}
+
+		void unmap() noexcept
+		{
+#ifdef _WIN32
+			if (header_) {
+				::UnmapViewOfFile(header_);
+			}
+			if (mapping_) {
+				::CloseHandle(mapping_);
+			}
+			if (file_ != INVALID_HANDLE_VALUE) {
+				::CloseHandle(file_);
+			}
+#else
+			if (header_) {
+				::munmap(header_, bytes_);
+			}
+			if (file_ >= 0) {
+				::close(file_);
+			}
+#endif
+			header_ = nullptr;
+		}
+
+		bool sync() noexcept
+		{
+#ifdef _WIN32
+			return ::FlushViewOfFile(header_, 0) && ::FlushFileBuffers(file_);
+#else
+			return ::msync(header_, bytes_, MS_SYNC) == 0;
+#endif
+		}
+
+		// Root object
+	public:
+		// The object the program finds the rest from (the list). Made with args in the arena the first time,
+		// the one in the file after that. Throws std::runtime_error if the file holds an object of another size
+		template <class T, class... Args>
+		[[nodiscard]] T& find_or_construct(Args&&... args)
+		{
+			if (header_->root_ == 0) {
+				auto memory = header_->allocate(sizeof(T), alignof(T));
+				try {
+					::new (memory) T(std::forward<Args>(args)...);
+				}
+				catch (...) {
+					header_->deallocate(memory, sizeof(T));
+					throw;
+				}
+				header_->root_ = header_->offset_of(memory);
+				header_->root_size_ = sizeof(T);
+				header_->root_align_ = alignof(T);
+			}
+			else if (header_->root_size_ != sizeof(T) || header_->root_align_ != alignof(T)) {
+				throw std::runtime_error{ "mapped_arena: the root object has another type" };
+			}
+			return *std::launder(reinterpret_cast<T*>(header_->base() + header_->root_));
+		}
+
+		// Writes the mapped pages to the file now (the destructor does it too)
+		void flush()
+		{
+			if (!sync()) {
+				throw std::runtime_error{ "mapped_arena: flush failed" };
+			}
+		}
+
+		// Statistics
+	public:
+		// true if the file was made by this object, false if an arena was opened
+		[[nodiscard]] bool created() const noexcept
+		{
+			return created_;
+		}
+
+		[[nodiscard]] std::size_t capacity() const noexcept
+		{
+			return bytes_;
+		}
+
+		// bytes ever handed out (freed blocks are not subtracted, they are reused)
+		[[nodiscard]] std::size_t used() const noexcept
+		{
+			return static_cast<std::size_t>(header_->used_);
+		}
+
+		[[nodiscard]] std::size_t live() const noexcept
+		{
+			return static_cast<std::size_t>(header_->live_);
+		}
+
+		[[nodiscard]] detail::arena_header* header() const noexcept
+		{
+			return header_;
+		}
+	};
+
+	// Allocator over a mapped_arena. It holds an offset_ptr to the arena header, so it can live in the
+	// arena itself (as the allocator of the root list) and still works after the file is mapped elsewhere
+	template <class T>
+	class mapped_arena_allocator
+	{
+		template <class U>
+		friend class mapped_arena_allocator;
+
+		// type aliases
+	public:
+		using value_type = T;
+		using pointer = offset_ptr<T>;
+		using const_pointer = offset_ptr<const T>;
+		using void_pointer = offset_ptr<void>;
+		using const_void_pointer = offset_ptr<const void>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+	private:
+		offset_ptr<detail::arena_header> header_;
+
+		// Ctors
+	public:
+		explicit mapped_arena_allocator(mapped_arena& arena) noexcept : header_{ arena.header() } {}
+
+		mapped_arena_allocator(const mapped_arena_allocator&) noexcept = default;
+		mapped_arena_allocator& operator=(const mapped_arena_allocator&) noexcept = default;
+
+		template <class U>
+		mapped_arena_allocator(const mapped_arena_allocator<U>& rhs) noexcept : header_{ rhs.header_ } {}
+
+		// Allocation
+	public:
+		[[nodiscard]] pointer allocate(size_type count)
+		{
+			static_assert(alignof(T) <= detail::arena_header::granule, "mapped_arena_allocator: over-aligned type");
+			if (count > std::numeric_limits<size_type>::max() / sizeof(T)) {
+				throw std::bad_array_new_length{};
+			}
+			return pointer{ static_cast<T*>(header_->allocate(count * sizeof(T), alignof(T))) };
+		}
+
+		void deallocate(pointer ptr, size_type count) noexcept
+		{
+			header_->deallocate(ptr.get(), count * sizeof(T));
+		}
+
+		// count objects in a row, freed one by one with deallocate(ptr, 1) (see node_pool::allocate_batch).
+		// nullptr if T is not a whole number of granules or the rest of the file is too short
+		[[nodiscard]] pointer allocate_batch(size_type count)
+		{
+			if (sizeof(T) % detail::arena_header::granule != 0 || sizeof(T) > detail::arena_header::max_class_bytes) {
+				return nullptr;
+			}
+			return pointer{ static_cast<T*>(header_->allocate_batch(sizeof(T), count)) };
+		}
+
+		// Compare
+	public:
+		template <class U>
+		[[nodiscard]] bool operator==(const mapped_arena_allocator<U>& rhs) const noexcept
+		{
+			return header_ == rhs.header_;
+		}
+
+		template <class U>
+		[[nodiscard]] bool operator!=(const mapped_arena_allocator<U>& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+	};
+}
+
+#endif
@@ -2,6 +2,10 @@
 #ifndef MY_UTILITIES_HPP
 #define MY_UTILITIES_HPP
 
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
 namespace my_lib {
 	template <class iter, class = void>
 	struct is_iterator
@@ -20,5 +24,20 @@ namespace my_lib {
 	{
 		constexpr static bool value{ true };
 	};
+
+	// allocator.allocate_batch(count) gives count nodes in a row, each one is freed alone (node_pool has it)
+	template <class Alloc, class = void>
+	struct has_allocate_batch
+	{
+		constexpr static bool value{ false };
+	};
+
+	template <class Alloc>
+	struct has_allocate_batch<Alloc,
+		std::void_t<decltype(std::declval<Alloc&>().allocate_batch(std::size_t{}))>
+	>
+	{
+		constexpr static bool value{ true };
+	};
 }
 #endif
\ No newline at end of file
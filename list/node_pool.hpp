@@ -0,0 +1,293 @@
+#pragma once
+#ifndef MY_LIB_NODE_POOL
+#define MY_LIB_NODE_POOL
+
+#include <memory>
+#include <type_traits>
+#include <cstddef>
+#include <new>
+#include <cassert>
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * detail::pool_storage
+	 * node_pool
+	 *
+	 * node_pool is an allocator for node based containers (my_lib::list): single objects are carved out of
+	 * large slabs and recycled through an intrusive free list, so push/pop churn costs no malloc/free.
+	 * Slabs are kept until the pool goes away with its last copy, so a list that runs empty and fills again
+	 * does not allocate. trim() returns them earlier when no block is in use.
+	 * allocate_batch gives many blocks in a row for the bulk inserts of my_lib::list.
+	 * Copies and rebinds share one pool, a copy constructed container gets a new one.
+	 * Not thread safe: one pool per container.
+	 */
+
+	namespace detail
+	{
+		class pool_storage
+		{
+			struct slab
+			{
+				slab* next_;
+				std::size_t bytes_;
+			};
+
+			struct free_block
+			{
+				free_block* next_;
+			};
+
+		public:
+			static constexpr std::size_t first_slab_blocks{ 32 };
+			static constexpr std::size_t max_slab_blocks{ 4096 };
+
+		private:
+			std::size_t block_size_{}; // 0 until the first allocate(1)
+			std::size_t block_align_{};
+			std::size_t slab_blocks_{ first_slab_blocks }; // capacity of the next slab
+			slab* slabs_{};
+			free_block* free_{};
+			std::byte* bump_{}; // unused tail of the newest slab
+			std::byte* bump_end_{};
+			std::size_t live_{};
+			std::size_t slab_count_{};
+
+		public:
+			pool_storage() noexcept = default;
+
+			pool_storage(const pool_storage&)				= delete;
+			pool_storage& operator=(const pool_storage&)	= delete;
+
+			~pool_storage() noexcept
+			{
+				assert(live_ == 0 && "node_pool destroyed with live blocks");
+				release();
+			}
+
+		private:
+			static constexpr std::size_t round_up(std::size_t value, std::size_t align) noexcept
+			{
+				return (value + align - 1) / align * align;
+			}
+
+			std::size_t header_size() const noexcept
+			{
+				return round_up(sizeof(slab), block_align_);
+			}
+
+			void add_slab(std::size_t min_blocks = 0)
+			{
+				auto blocks = slab_blocks_ < min_blocks ? min_blocks : slab_blocks_;
+				auto bytes = header_size() + blocks * block_size_;
+				auto memory = static_cast<std::byte*>(::operator new(bytes, std::align_val_t{ block_align_ }));
+				auto new_slab = ::new (memory) slab{ slabs_, bytes };
+
+				slabs_ = new_slab;
+				bump_ = memory + header_size();
+				bump_end_ = memory + bytes;
+				++slab_count_;
+
+				if (slab_blocks_ < max_slab_blocks) {
+					slab_blocks_ *= 2;
+				}
+			}
+
+			void release() noexcept
+			{
+				for (auto node = slabs_; node; ) {
+					auto next = node->next_;
+					::operator delete(static_cast<void*>(node), node->bytes_, std::align_val_t{ block_align_ });
+					node = next;
+				}
+
+				slabs_ = nullptr;
+				free_ = nullptr;
+				bump_ = nullptr;
+				bump_end_ = nullptr;
+				slab_count_ = 0;
+				slab_blocks_ = first_slab_blocks;
+			}
+
+		public:
+			// The first size asked for fixes the block size, every other size is not pooled
+			[[nodiscard]] bool accepts(std::size_t size, std::size_t align) noexcept
+			{
+				if (block_size_ == 0) {
+					block_align_ = align < alignof(free_block) ? alignof(free_block) : align;
+					block_size_ = round_up(size < sizeof(free_block) ? sizeof(free_block) : size, block_align_);
+					return true;
+				}
+				return round_up(size, block_align_) <= block_size_ && align <= block_align_;
+			}
+
+			[[nodiscard]] void* allocate()
+			{
+				void* result;
+				if (free_) {
+					result = free_;
+					free_ = free_->next_;
+				}
+				else {
+					if (bump_ == bump_end_) {
+						add_slab();
+					}
+					result = bump_;
+					bump_ += block_size_;
+				}
+
+				++live_;
+				return result;
+			}
+
+			// count blocks in a row, taken from the bump area (a big enough slab is made if the rest is too short)
+			[[nodiscard]] void* allocate_batch(std::size_t count)
+			{
+				if (static_cast<std::size_t>(bump_end_ - bump_) < count * block_size_) {
+					// the rest of the old slab goes to the free list, not lost
+					for (; bump_ != bump_end_; bump_ += block_size_) {
+						free_ = ::new (bump_) free_block{ free_ };
+					}
+					add_slab(count);
+				}
+
+				auto result = bump_;
+				bump_ += count * block_size_;
+				live_ += count;
+				return result;
+			}
+
+			void deallocate(void* ptr) noexcept
+			{
+				assert(live_ != 0 && "deallocate on empty node_pool");
+				--live_;
+				free_ = ::new (ptr) free_block{ free_ };
+			}
+
+			// Gives the slabs back to the system if no block is in use, returns whether it did
+			bool trim() noexcept
+			{
+				if (live_ != 0) return false;
+				release();
+				return true;
+			}
+
+			[[nodiscard]] std::size_t block_size() const noexcept
+			{
+				return block_size_;
+			}
+
+			[[nodiscard]] std::size_t slab_count() const noexcept
+			{
+				return slab_count_;
+			}
+
+			[[nodiscard]] std::size_t live() const noexcept
+			{
+				return live_;
+			}
+		};
+	}
+
+	template <class T>
+	class node_pool
+	{
+		template <class U>
+		friend class node_pool;
+
+		// type aliases
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::false_type;
+
+	private:
+		std::shared_ptr<detail::pool_storage> storage_;
+
+		// Ctors
+	public:
+		node_pool() : storage_{ std::make_shared<detail::pool_storage>() } {}
+
+		// no move ctor: moved from allocator must stay usable
+		node_pool(const node_pool&) noexcept = default;
+		node_pool& operator=(const node_pool&) noexcept = default;
+
+		template <class U>
+		node_pool(const node_pool<U>& rhs) noexcept : storage_{ rhs.storage_ } {}
+
+		// Allocation
+	public:
+		[[nodiscard]] T* allocate(size_type count)
+		{
+			if (count == 1 && storage_->accepts(sizeof(T), alignof(T))) {
+				return static_cast<T*>(storage_->allocate());
+			}
+			return std::allocator<T>{}.allocate(count);
+		}
+
+		void deallocate(T* ptr, size_type count) noexcept
+		{
+			if (count == 1 && storage_->accepts(sizeof(T), alignof(T))) {
+				storage_->deallocate(ptr);
+				return;
+			}
+			std::allocator<T>{}.deallocate(ptr, count);
+		}
+
+		// count objects in a row that are freed one by one with deallocate(ptr, 1), my_lib::list builds
+		// bulk inserts from it so the nodes lie in traversal order. nullptr if the pool has another block size
+		[[nodiscard]] T* allocate_batch(size_type count)
+		{
+			if (count != 0 && storage_->accepts(sizeof(T), alignof(T)) && storage_->block_size() == sizeof(T)) {
+				return static_cast<T*>(storage_->allocate_batch(count));
+			}
+			return nullptr;
+		}
+
+		// each container gets its own free list
+		[[nodiscard]] node_pool select_on_container_copy_construction() const
+		{
+			return node_pool{};
+		}
+
+		// Frees the slabs of the pool (shared with the copies) if none of its blocks is in use, returns whether it did
+		bool trim() noexcept
+		{
+			return storage_->trim();
+		}
+
+		// Statistics
+	public:
+		[[nodiscard]] size_type slab_count() const noexcept
+		{
+			return storage_->slab_count();
+		}
+
+		[[nodiscard]] size_type live() const noexcept
+		{
+			return storage_->live();
+		}
+
+		// Compare
+	public:
+		template <class U>
+		[[nodiscard]] bool operator==(const node_pool<U>& rhs) const noexcept
+		{
+			return storage_ == rhs.storage_;
+		}
+
+		template <class U>
+		[[nodiscard]] bool operator!=(const node_pool<U>& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+	};
+}
+
+#endif
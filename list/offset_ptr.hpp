@@ -0,0 +1,248 @@
+#pragma once
+#ifndef MY_LIB_OFFSET_PTR
+#define MY_LIB_OFFSET_PTR
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * offset_ptr
+	 *
+	 * offset_ptr holds the distance from itself to the object it points to, not an address. A structure
+	 * linked by offset_ptrs (the nodes and the head of my_lib::list with mapped_arena_allocator) stays valid
+	 * when the memory it lives in is mapped at another address, by another process or after a restart.
+	 * Copying an offset_ptr recomputes the distance, so temporaries on the stack are fine.
+	 * Null is stored as distance 1, so an offset_ptr<char> cannot point to the byte right after itself.
+	 * An offset_ptr may point to itself (distance 0): the empty list head does.
+	 */
+
+	template <class T>
+	class offset_ptr
+	{
+		template <class U>
+		friend class offset_ptr;
+
+		// type aliases
+	public:
+		using element_type = T;
+		using value_type = std::remove_cv_t<T>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T*;
+		using reference = std::add_lvalue_reference_t<T>; // void for offset_ptr<void>
+		using iterator_category = std::random_access_iterator_tag;
+
+		template <class U>
+		using rebind = offset_ptr<U>;
+
+	private:
+		static constexpr difference_type null_offset{ 1 };
+
+		difference_type offset_{ null_offset };
+
+		void set(T* ptr) noexcept
+		{
+			if (!ptr) {
+				offset_ = null_offset;
+				return;
+			}
+			offset_ = static_cast<difference_type>(reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(this));
+		}
+
+		// Ctors
+	public:
+		offset_ptr() noexcept = default;
+
+		offset_ptr(std::nullptr_t) noexcept {}
+
+		offset_ptr(T* ptr) noexcept
+		{
+			set(ptr);
+		}
+
+		offset_ptr(const offset_ptr& rhs) noexcept
+		{
+			set(rhs.get());
+		}
+
+		// offset_ptr<Derived> to offset_ptr<Base>, offset_ptr<T> to offset_ptr<const T> or offset_ptr<void>
+		template <class U, std::enable_if_t<std::is_convertible_v<U*, T*>, int> = 0>
+		offset_ptr(const offset_ptr<U>& rhs) noexcept
+		{
+			set(rhs.get());
+		}
+
+		// static_cast from offset_ptr<void> (std::allocator_traits needs it) or from a base
+		template <class U, std::enable_if_t<!std::is_convertible_v<U*, T*>, int> = 0,
+			class = decltype(static_cast<T*>(std::declval<U*>()))>
+		explicit offset_ptr(const offset_ptr<U>& rhs) noexcept
+		{
+			set(static_cast<T*>(rhs.get()));
+		}
+
+		offset_ptr& operator=(const offset_ptr& rhs) noexcept
+		{
+			set(rhs.get());
+			return *this;
+		}
+
+		offset_ptr& operator=(std::nullptr_t) noexcept
+		{
+			offset_ = null_offset;
+			return *this;
+		}
+
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		[[nodiscard]] static offset_ptr pointer_to(U& value) noexcept
+		{
+			return offset_ptr{ std::addressof(value) };
+		}
+
+		// Access
+	public:
+		[[nodiscard]] T* get() const noexcept
+		{
+			if (offset_ == null_offset) return nullptr;
+			return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + static_cast<std::uintptr_t>(offset_));
+		}
+
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		[[nodiscard]] U& operator*() const noexcept
+		{
+			return *get();
+		}
+
+		[[nodiscard]] T* operator->() const noexcept
+		{
+			return get();
+		}
+
+		template <class U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		[[nodiscard]] U& operator[](difference_type index) const noexcept
+		{
+			return get()[index];
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return offset_ != null_offset;
+		}
+
+		// Arithmetic
+	public:
+		offset_ptr& operator+=(difference_type count) noexcept
+		{
+			set(get() + count);
+			return *this;
+		}
+
+		offset_ptr& operator-=(difference_type count) noexcept
+		{
+			set(get() - count);
+			return *this;
+		}
+
+		offset_ptr& operator++() noexcept
+		{
+			return *this += 1;
+		}
+
+		offset_ptr operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++*this;
+			return tmp;
+		}
+
+		offset_ptr& operator--() noexcept
+		{
+			return *this -= 1;
+		}
+
+		offset_ptr operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--*this;
+			return tmp;
+		}
+
+		[[nodiscard]] friend offset_ptr operator+(const offset_ptr& ptr, difference_type count) noexcept
+		{
+			return offset_ptr{ ptr.get() + count };
+		}
+
+		[[nodiscard]] friend offset_ptr operator+(difference_type count, const offset_ptr& ptr) noexcept
+		{
+			return ptr + count;
+		}
+
+		[[nodiscard]] friend offset_ptr operator-(const offset_ptr& ptr, difference_type count) noexcept
+		{
+			return offset_ptr{ ptr.get() - count };
+		}
+
+		[[nodiscard]] friend difference_type operator-(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return lhs.get() - rhs.get();
+		}
+
+		// Compare, by address
+	public:
+		[[nodiscard]] friend bool operator==(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return lhs.get() == rhs.get();
+		}
+
+		[[nodiscard]] friend bool operator!=(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return !(lhs == rhs);
+		}
+
+		[[nodiscard]] friend bool operator<(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return std::less<T*>{}(lhs.get(), rhs.get());
+		}
+
+		[[nodiscard]] friend bool operator>(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return rhs < lhs;
+		}
+
+		[[nodiscard]] friend bool operator<=(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return !(rhs < lhs);
+		}
+
+		[[nodiscard]] friend bool operator>=(const offset_ptr& lhs, const offset_ptr& rhs) noexcept
+		{
+			return !(lhs < rhs);
+		}
+
+		[[nodiscard]] friend bool operator==(const offset_ptr& lhs, std::nullptr_t) noexcept
+		{
+			return !lhs;
+		}
+
+		[[nodiscard]] friend bool operator==(std::nullptr_t, const offset_ptr& rhs) noexcept
+		{
+			return !rhs;
+		}
+
+		[[nodiscard]] friend bool operator!=(const offset_ptr& lhs, std::nullptr_t) noexcept
+		{
+			return static_cast<bool>(lhs);
+		}
+
+		[[nodiscard]] friend bool operator!=(std::nullptr_t, const offset_ptr& rhs) noexcept
+		{
+			return static_cast<bool>(rhs);
+		}
+	};
+}
+
+#endif
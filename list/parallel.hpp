@@ -0,0 +1,591 @@
+#pragma once
+#ifndef MY_LIB_PARALLEL
+#define MY_LIB_PARALLEL
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "list.hpp"
+#include "link_algorithms.hpp"
+
+// The std policies (std::execution::par & co) are taken when the library has them (__cpp_lib_execution),
+// else only the my_lib ones work. With libstdc++ and TBB installed, <execution> needs -ltbb at link time
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * execution::parallel_policy / sequenced_policy
+	 * is_execution_policy
+	 * detail::run_parallel
+	 * detail::parallel_stable_sort
+	 * detail::list_access
+	 * sort
+	 * list_segments
+	 * for_each / count_if / transform_reduce / find_if
+	 *
+	 * Parallel algorithms on my_lib::list, with the list as the range:
+	 *     my_lib::sort(my_lib::execution::par, list);
+	 *     auto evens = my_lib::count_if(std::execution::par, list, [](int value) { return value % 2 == 0; });
+	 * They run on threads started for the call (detail::run_parallel), no pool.
+	 * list.hpp does not include this header, so a plain list does not pull in <thread> and <execution>
+	 */
+
+	namespace execution
+	{
+		// Like std::execution::par, but the number of threads can be given: my_lib::execution::par(4).
+		// 0 threads means std::thread::hardware_concurrency()
+		struct parallel_policy
+		{
+			std::size_t threads_{};
+
+			[[nodiscard]] constexpr parallel_policy operator()(std::size_t threads) const noexcept
+			{
+				return parallel_policy{ threads };
+			}
+		};
+
+		inline constexpr parallel_policy par{};
+
+		// Serial, like std::execution::seq but there without <execution>
+		struct sequenced_policy {};
+
+		inline constexpr sequenced_policy seq{};
+	}
+
+	// std execution policies and my_lib ones
+	template <class Policy>
+	struct is_execution_policy
+	{
+#ifdef __cpp_lib_execution
+		constexpr static bool value{ std::is_execution_policy_v<Policy> };
+#else
+		constexpr static bool value{ false };
+#endif
+	};
+
+	template <>
+	struct is_execution_policy<execution::parallel_policy>
+	{
+		constexpr static bool value{ true };
+	};
+
+	template <>
+	struct is_execution_policy<execution::sequenced_policy>
+	{
+		constexpr static bool value{ true };
+	};
+
+	template <class Policy>
+	constexpr bool is_execution_policy_v = is_execution_policy<std::remove_cv_t<std::remove_reference_t<Policy>>>::value;
+
+	namespace detail
+	{
+		[[nodiscard]] inline std::size_t hardware_threads() noexcept
+		{
+			auto count = std::thread::hardware_concurrency();
+			return count ? count : 1;
+		}
+
+		template <class Policy>
+		[[nodiscard]] std::size_t thread_count(const Policy&) noexcept
+		{
+#ifdef __cpp_lib_execution
+			if constexpr (std::is_same_v<Policy, std::execution::sequenced_policy>) {
+				return 1;
+			}
+#endif
+			return hardware_threads();
+		}
+
+		[[nodiscard]] inline std::size_t thread_count(const execution::sequenced_policy&) noexcept
+		{
+			return 1;
+		}
+
+		[[nodiscard]] inline std::size_t thread_count(const execution::parallel_policy& policy) noexcept
+		{
+			return policy.threads_ ? policy.threads_ : hardware_threads();
+		}
+
+		// Calls task(i) for every i in [0, count), each on its own thread (task(0) on the calling one).
+		// Returns when all of them are done; the first exception thrown by a task is rethrown
+		template <class Task>
+		void run_parallel(std::size_t count, Task&& task)
+		{
+			std::vector<std::exception_ptr> errors(count);
+			auto guarded = [&task, &errors](std::size_t i) noexcept {
+				try {
+					task(i);
+				}
+				catch (...) {
+					errors[i] = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve(count);
+			for (std::size_t i{ 1 }; i < count; ++i) {
+				try {
+					threads.emplace_back(guarded, i);
+				}
+				catch (const std::system_error&) {
+					guarded(i); // out of threads, do it here
+				}
+			}
+			guarded(0);
+
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			for (auto& error : errors) {
+				if (error) {
+					std::rethrow_exception(error);
+				}
+			}
+		}
+
+		// Stable sort of [first, last) on up to `threads` threads: every thread sorts its own part,
+		// then the parts are merged pairwise (in parallel too) through a buffer
+		template <class RandomIt, class Cmp>
+		void parallel_stable_sort(RandomIt first, RandomIt last, Cmp cmp, std::size_t threads)
+		{
+			using value_type = typename std::iterator_traits<RandomIt>::value_type;
+			constexpr std::size_t min_part{ 1 << 13 }; // smaller parts are not worth a thread
+
+			const auto size = static_cast<std::size_t>(last - first);
+			threads = std::min(threads, size / min_part);
+			if (threads < 2) {
+				std::stable_sort(first, last, cmp);
+				return;
+			}
+
+			std::vector<std::size_t> bounds(threads + 1);
+			for (std::size_t i{}; i <= threads; ++i) {
+				bounds[i] = size * i / threads;
+			}
+
+			run_parallel(threads, [&](std::size_t i) {
+				std::stable_sort(first + bounds[i], first + bounds[i + 1], cmp);
+			});
+
+			std::vector<value_type> buffer(size);
+			bool in_buffer{}; // where the sorted parts are now
+			for (std::size_t width{ 1 }; width < threads; width *= 2) {
+				auto pairs = (threads + 2 * width - 1) / (2 * width);
+				run_parallel(pairs, [&](std::size_t pair) {
+					auto low = bounds[pair * 2 * width];
+					auto mid = bounds[std::min(pair * 2 * width + width, threads)];
+					auto high = bounds[std::min(pair * 2 * width + 2 * width, threads)];
+					if (in_buffer) {
+						std::merge(buffer.begin() + low, buffer.begin() + mid, buffer.begin() + mid, buffer.begin() + high,
+							first + low, cmp);
+					}
+					else {
+						std::merge(first + low, first + mid, first + mid, first + high, buffer.begin() + low, cmp);
+					}
+				});
+				in_buffer = !in_buffer;
+			}
+
+			if (in_buffer) {
+				std::copy(buffer.begin(), buffer.end(), first);
+			}
+		}
+
+		// The internals of my_lib::list the algorithms below use (a friend of list)
+		struct list_access
+		{
+			template <class MyList>
+			[[nodiscard]] static typename MyList::nodeptr head(const MyList& list) noexcept
+			{
+				return list.head();
+			}
+
+			template <class MyList>
+			[[nodiscard]] static typename MyList::reference value_of(const MyList&, const typename MyList::nodeptr& node) noexcept
+			{
+				return MyList::value_of(node);
+			}
+
+			// size stale (lazy_size) or equal to size
+			template <class MyList>
+			[[nodiscard]] static bool may_have_size(const MyList& list, typename MyList::size_type size) noexcept
+			{
+				return list.size_stale_ || list.size_ == size;
+			}
+
+			template <class MyList>
+			[[nodiscard]] static auto sort_start(const MyList& list) noexcept
+			{
+				return list.sort_start();
+			}
+
+			template <class MyList, class Start>
+			static void on_sort(const MyList& list, Start start) noexcept
+			{
+				list.on_sort(list.counted_size(), start);
+			}
+
+			template <class MyList>
+			static void on_traversal(const MyList& list, std::size_t nodes) noexcept
+			{
+				list.on_traversal(nodes);
+			}
+
+			// Calls task(first, last, segment) for every segment [first, last), the threads of the policy take
+			// the next one in turn. Returns when all are done, rethrows the first exception of a task
+			template <class ExecutionPolicy, class Segments, class Task>
+			static void run_segments(const ExecutionPolicy& policy, const Segments& segments, Task task)
+			{
+				const auto count = segments.count();
+				std::atomic<std::size_t> next{};
+				run_parallel(std::max<std::size_t>(1, std::min(thread_count(policy), count)), [&](std::size_t) {
+					for (auto segment = next.fetch_add(1, std::memory_order_relaxed); segment < count;
+						segment = next.fetch_add(1, std::memory_order_relaxed)) {
+						task(segments.bounds_[segment], segments.bounds_[segment + 1], segment);
+					}
+				});
+			}
+		};
+
+		// Threads worth having for one scan of list with the policy, less than 2 means serial
+		template <class ExecutionPolicy, class MyList>
+		[[nodiscard]] std::size_t scan_threads(const ExecutionPolicy& policy, const MyList& list)
+		{
+			constexpr std::size_t min_segment{ 1 << 14 }; // a shorter one saves less than the thread start costs
+			return std::min(thread_count(policy), list.size() / min_segment);
+		}
+	}
+
+	// Parallel sort of a list: node pointers are gathered into an array, sorted on the threads of the policy
+	// and the chain is relinked in one pass. Values are not moved, so all iterators stay valid.
+	// pred is called concurrently. If it throws, the list is left unchanged
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class BinaryPred = std::less<T>,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	void sort(ExecutionPolicy&& policy, list<T, Alloc, Checking, Sizing, Stats>& list, BinaryPred pred = BinaryPred{})
+	{
+		using access = detail::list_access;
+		using nodeptr = typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::nodeptr;
+
+		auto threads = detail::thread_count(policy);
+		if (threads < 2 || list.size() < 2) {
+			list.sort(pred);
+			return;
+		}
+
+		auto start = access::sort_start(list);
+		auto head = access::head(list);
+		std::vector<nodeptr> nodes;
+		nodes.reserve(list.size());
+		for (auto node = head->next_; node != head; node = node->next_) {
+			nodes.push_back(node);
+		}
+
+		detail::parallel_stable_sort(nodes.begin(), nodes.end(), [&pred, &list](const nodeptr& lhs, const nodeptr& rhs) {
+			return pred(access::value_of(list, lhs), access::value_of(list, rhs));
+		}, threads);
+
+		auto prev = head;
+		for (auto& node : nodes) {
+			prev->next_ = node;
+			node->prev_ = prev;
+			prev = node;
+		}
+		prev->next_ = head;
+		head->prev_ = prev;
+		access::on_sort(list, start);
+	}
+
+	// The nodes of a list cut into segments of about equal length, for the parallel traversal algorithms:
+	// a thread takes a segment at a time. Cutting walks the list once, so to scan an unchanged list again
+	// keep the segments and give them to the algorithms. Adding, removing or relinking nodes makes them
+	// stale (changing values does not). Only the list that was cut takes them
+	template <class MyList>
+	class list_segments
+	{
+		friend detail::list_access;
+
+		using nodeptr = typename MyList::nodeptr;
+
+		// type aliases
+	public:
+		using size_type = typename MyList::size_type;
+
+	private:
+		const MyList* list_{};
+		std::vector<nodeptr> bounds_; // segment i is [bounds_[i], bounds_[i + 1]), the last bound is the head
+		size_type nodes_{}; // size of the list when it was cut
+
+		// Ctors
+	public:
+		list_segments() noexcept = default; // no segments, for assigning later
+
+		// Cuts list into count segments (fewer if the list is shorter) in one walk from both ends,
+		// no walk for one segment
+		list_segments(const MyList& list, size_type count) : list_{ std::addressof(list) }, nodes_{ list.size() }
+		{
+			using access = detail::list_access;
+
+			auto head = access::head(list);
+			count = std::max<size_type>(1, std::min(count, nodes_));
+			bounds_.assign(count + 1, head);
+			if (count == 1) {
+				bounds_[0] = head->next_;
+				return;
+			}
+
+			// bound i is the node at index nodes * i / count: the front cursor takes the ones it passes, the back cursor the others
+			const auto nodes = nodes_;
+			size_type front_index{};
+			size_type front_bound{};
+			size_type front_next{};
+			size_type back_index{ nodes };
+			size_type back_bound{ count - 1 };
+			size_type back_next{ nodes * back_bound / count };
+			auto visited = detail::walk_from_both_ends(head, [&](const nodeptr& node) {
+				if (front_index++ == front_next) {
+					bounds_[front_bound++] = node;
+					front_next = nodes * front_bound / count; // past the end after the last bound
+				}
+				return false;
+			}, [&](const nodeptr& node) {
+				if (--back_index == back_next) {
+					bounds_[back_bound] = node;
+					back_next = back_bound ? nodes * --back_bound / count : nodes;
+				}
+				return false;
+			});
+			access::on_traversal(list, visited);
+		}
+
+		// Observers
+	public:
+		[[nodiscard]] size_type count() const noexcept
+		{
+			return bounds_.empty() ? 0 : bounds_.size() - 1;
+		}
+
+		[[nodiscard]] size_type nodes() const noexcept
+		{
+			return nodes_;
+		}
+
+		// made from list and still the right size for it (stale segments of a list that got as many nodes back are not caught)
+		[[nodiscard]] bool fits(const MyList& list) const noexcept
+		{
+			return list_ == std::addressof(list) && detail::list_access::may_have_size(list, nodes_);
+		}
+	};
+
+	// Like std::for_each(policy, ...) on a list: f is called concurrently on the threads of the policy, in no particular order.
+	// Without segments the list is cut into one per thread first, a walk as long as the serial for_each:
+	// for cheap work on a list that is scanned more than once, pass segments made once
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Function,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	void for_each(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list,
+		const list_segments<my_lib::list<T, Alloc, Checking, Sizing, Stats>>& segments, Function f)
+	{
+		using access = detail::list_access;
+		using nodeptr = typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::nodeptr;
+		assert(segments.fits(list) && "segments of another list, or stale");
+
+		access::run_segments(policy, segments, [&f, &list](const nodeptr& first, const nodeptr& last, std::size_t) {
+			auto visit = [&f, &list](const nodeptr& node) { f(std::as_const(access::value_of(list, node))); return false; };
+			detail::walk_from_both_ends(first, last, visit, visit);
+		});
+		access::on_traversal(list, segments.nodes());
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Function,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	void for_each(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list, Function f)
+	{
+		auto threads = detail::scan_threads(policy, list);
+		if (threads < 2) {
+			list.for_each(f);
+			return;
+		}
+		my_lib::for_each(policy, list, list_segments{ list, threads }, f);
+	}
+
+	// Like list::count_if(pred), pred is called concurrently
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] std::size_t count_if(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list,
+		const list_segments<my_lib::list<T, Alloc, Checking, Sizing, Stats>>& segments, Predicate pred)
+	{
+		using access = detail::list_access;
+		using nodeptr = typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::nodeptr;
+		assert(segments.fits(list) && "segments of another list, or stale");
+
+		std::vector<std::size_t> counts(segments.count());
+		access::run_segments(policy, segments, [&](const nodeptr& first, const nodeptr& last, std::size_t segment) {
+			std::size_t found{};
+			auto visit = [&found, &pred, &list](const nodeptr& node) {
+				found += static_cast<std::size_t>(static_cast<bool>(pred(std::as_const(access::value_of(list, node)))));
+				return false;
+			};
+			detail::walk_from_both_ends(first, last, visit, visit);
+			counts[segment] = found;
+		});
+		access::on_traversal(list, segments.nodes());
+		return std::accumulate(counts.begin(), counts.end(), std::size_t{});
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] std::size_t count_if(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list, Predicate pred)
+	{
+		auto threads = detail::scan_threads(policy, list);
+		return threads < 2 ? list.count_if(pred) : my_lib::count_if(policy, list, list_segments{ list, threads }, pred);
+	}
+
+	// Like std::transform_reduce(policy, first, last, init, reduce, transform): reduce must be associative
+	// and commutative, the elements of a segment are combined in no particular order. Both are called concurrently
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class U, class BinaryOp, class UnaryOp,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] U transform_reduce(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list,
+		const list_segments<my_lib::list<T, Alloc, Checking, Sizing, Stats>>& segments, U init, BinaryOp reduce, UnaryOp transform)
+	{
+		using access = detail::list_access;
+		using nodeptr = typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::nodeptr;
+		assert(segments.fits(list) && "segments of another list, or stale");
+
+		std::vector<std::optional<U>> partials(segments.count()); // an empty segment has none
+		access::run_segments(policy, segments, [&](const nodeptr& first, const nodeptr& last, std::size_t segment) {
+			std::optional<U> front;
+			std::optional<U> back;
+			auto add = [&reduce, &transform, &list](std::optional<U>& to, const nodeptr& node) {
+				if (to) {
+					to = reduce(std::move(*to), transform(std::as_const(access::value_of(list, node))));
+				}
+				else {
+					to.emplace(transform(std::as_const(access::value_of(list, node))));
+				}
+				return false;
+			};
+			detail::walk_from_both_ends(first, last, [&](const nodeptr& node) { return add(front, node); },
+				[&](const nodeptr& node) { return add(back, node); });
+			if (front && back) {
+				front = reduce(std::move(*front), std::move(*back));
+			}
+			partials[segment] = std::move(front);
+		});
+		access::on_traversal(list, segments.nodes());
+
+		for (auto& partial : partials) {
+			if (partial) {
+				init = reduce(std::move(init), std::move(*partial));
+			}
+		}
+		return init;
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class U, class BinaryOp, class UnaryOp,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] U transform_reduce(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list,
+		U init, BinaryOp reduce, UnaryOp transform)
+	{
+		return my_lib::transform_reduce(policy, list, list_segments{ list, detail::scan_threads(policy, list) }, std::move(init), reduce, transform);
+	}
+
+	namespace detail
+	{
+		// list::find_if in every segment. A segment keeps its match only if no earlier one has one yet
+		template <class ExecutionPolicy, class MyList, class Predicate>
+		[[nodiscard]] typename MyList::nodeptr find_node(const ExecutionPolicy& policy, const MyList& list,
+			const list_segments<MyList>& segments, Predicate pred)
+		{
+			using access = list_access;
+			using nodeptr = typename MyList::nodeptr;
+			assert(segments.fits(list) && "segments of another list, or stale");
+
+			std::vector<nodeptr> matches(segments.count(), access::head(list));
+			std::vector<std::size_t> visits(segments.count());
+			std::atomic<std::size_t> first_match{ segments.count() }; // the earliest segment with a match
+			access::run_segments(policy, segments, [&](const nodeptr& first, const nodeptr& last, std::size_t segment) {
+				auto beaten = [&first_match, segment] { return first_match.load(std::memory_order_relaxed) < segment; };
+				auto front_match = last;
+				auto back_match = last;
+				visits[segment] = walk_from_both_ends(first, last, [&](const nodeptr& node) {
+					if (!pred(std::as_const(access::value_of(list, node)))) return beaten();
+					front_match = node;
+					return true;
+				}, [&](const nodeptr& node) {
+					if (pred(std::as_const(access::value_of(list, node)))) {
+						back_match = node;
+					}
+					return beaten();
+				});
+
+				auto match = front_match != last ? front_match : back_match;
+				if (match != last && !beaten()) {
+					matches[segment] = match;
+					auto earliest = first_match.load(std::memory_order_relaxed);
+					while (segment < earliest && !first_match.compare_exchange_weak(earliest, segment, std::memory_order_relaxed)) {}
+				}
+			});
+			access::on_traversal(list, std::accumulate(visits.begin(), visits.end(), std::size_t{}));
+
+			auto segment = first_match.load(std::memory_order_relaxed);
+			return segment < segments.count() ? matches[segment] : access::head(list);
+		}
+
+		template <class ExecutionPolicy, class MyList, class Predicate>
+		[[nodiscard]] typename MyList::nodeptr find_node(const ExecutionPolicy& policy, const MyList& list, Predicate pred)
+		{
+			auto threads = scan_threads(policy, list);
+			return threads < 2 ? list.find_if(pred).get_pointer() : find_node(policy, list, list_segments{ list, threads }, pred);
+		}
+	}
+
+	// Like list::find_if(pred): the first match in order. Every segment is searched like the serial find_if,
+	// a search gives up once an earlier segment has a match. pred is called concurrently
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] auto find_if(ExecutionPolicy&& policy, list<T, Alloc, Checking, Sizing, Stats>& list, Predicate pred)
+	{
+		return typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::iterator{ &list, detail::find_node(policy, std::as_const(list), pred) };
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] auto find_if(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list, Predicate pred)
+	{
+		return typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::const_iterator{ &list, detail::find_node(policy, list, pred) };
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] auto find_if(ExecutionPolicy&& policy, list<T, Alloc, Checking, Sizing, Stats>& list,
+		const list_segments<my_lib::list<T, Alloc, Checking, Sizing, Stats>>& segments, Predicate pred)
+	{
+		return typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::iterator{ &list, detail::find_node(policy, std::as_const(list), segments, pred) };
+	}
+
+	template <class ExecutionPolicy, class T, class Alloc, class Checking, class Sizing, class Stats, class Predicate,
+		std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int> = 0>
+	[[nodiscard]] auto find_if(ExecutionPolicy&& policy, const list<T, Alloc, Checking, Sizing, Stats>& list,
+		const list_segments<my_lib::list<T, Alloc, Checking, Sizing, Stats>>& segments, Predicate pred)
+	{
+		return typename my_lib::list<T, Alloc, Checking, Sizing, Stats>::const_iterator{ &list, detail::find_node(policy, list, segments, pred) };
+	}
+}
+
+#endif
@@ -0,0 +1,279 @@
+#pragma once
+#ifndef MY_LIB_SERIALIZE
+#define MY_LIB_SERIALIZE
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "list.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * serializer
+	 * detail::stream_header
+	 * serialize
+	 * deserialize
+	 *
+	 * Binary checkpoint of a my_lib::list:
+	 *     my_lib::serialize(values, file);
+	 *     auto values = my_lib::deserialize<my_lib::list<int>>(file);
+	 * Sink: std::ostream or anything with write(const char*, std::streamsize) and an operator bool that is false
+	 * after an error. Source: std::istream or anything with read(char*, std::streamsize) and the same operator bool.
+	 *
+	 * Format (version 1, native byte order and sizes):
+	 *     header: magic, version, flags, value size and kind (raw format only), element count
+	 *     chunks: element count of the chunk (32 bits) and the elements, a chunk of 0 elements ends the stream
+	 * Trivially copyable T is written raw: a chunk is the bytes of up to 64 KiB of values, read back into a
+	 * buffer and made into nodes by one bulk insert (a batch allocation with node_pool, the list is not touched
+	 * if a chunk is cut short). Any other T goes through serializer<T> one element at a time, nothing is buffered.
+	 * Errors throw std::runtime_error, deserialize gives no list then.
+	 */
+
+	// Customization point for the values that are not trivially copyable, specialize it for your types:
+	//     template <> struct my_lib::serializer<point> {
+	//         template <class Sink> static void write(Sink& sink, const point& value);
+	//         template <class Source> static point read(Source& source);
+	//     };
+	// The specializations below can be used to write the members
+	template <class T, class Enable = void>
+	struct serializer;
+
+	template <class T>
+	struct serializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+	{
+		template <class Sink>
+		static void write(Sink& sink, const T& value)
+		{
+			sink.write(reinterpret_cast<const char*>(std::addressof(value)), static_cast<std::streamsize>(sizeof(T)));
+		}
+
+		template <class Source>
+		static T read(Source& source)
+		{
+			T value;
+			source.read(reinterpret_cast<char*>(std::addressof(value)), static_cast<std::streamsize>(sizeof(T)));
+			if (!source) {
+				throw std::runtime_error{ "deserialize: stream cut short" };
+			}
+			return value;
+		}
+	};
+
+	// size, then the characters
+	template <class CharT, class Traits, class Alloc>
+	struct serializer<std::basic_string<CharT, Traits, Alloc>>
+	{
+		using string_type = std::basic_string<CharT, Traits, Alloc>;
+
+		template <class Sink>
+		static void write(Sink& sink, const string_type& value)
+		{
+			serializer<std::uint64_t>::write(sink, static_cast<std::uint64_t>(value.size()));
+			sink.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(CharT)));
+		}
+
+		template <class Source>
+		static string_type read(Source& source)
+		{
+			auto size = serializer<std::uint64_t>::read(source);
+			string_type value;
+			// grows with the data read, a corrupt size does not allocate gigabytes up front
+			constexpr std::uint64_t piece{ 4096 };
+			while (value.size() < size) {
+				auto old_size = value.size();
+				auto count = size - old_size < piece ? size - old_size : piece;
+				value.resize(old_size + static_cast<std::size_t>(count));
+				source.read(reinterpret_cast<char*>(value.data() + old_size), static_cast<std::streamsize>(count * sizeof(CharT)));
+				if (!source) {
+					throw std::runtime_error{ "deserialize: stream cut short" };
+				}
+			}
+			return value;
+		}
+	};
+
+	namespace detail
+	{
+		struct stream_header
+		{
+			static constexpr std::uint32_t magic_value{ 0x534c'594d }; // "MYLS", reads another value on a machine of the other byte order
+			static constexpr std::uint16_t current_version{ 1 };
+			static constexpr std::uint16_t raw_values{ 1 }; // flag: chunks hold the bytes of the values
+			static constexpr std::size_t raw_chunk_bytes{ 64 * 1024 };
+			static constexpr std::uint32_t chunk_elements{ 4096 }; // for serializer<T> values
+
+			std::uint32_t magic_{ magic_value };
+			std::uint16_t version_{ current_version };
+			std::uint16_t flags_{};
+			std::uint32_t value_size_{};
+			std::uint32_t value_kind_{}; // so an int is not read back as a float of the same size
+			std::uint64_t count_{};
+		};
+
+		template <class T>
+		constexpr std::uint32_t value_kind() noexcept
+		{
+			if constexpr (std::is_floating_point_v<T>) return 3;
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return 1;
+			else if constexpr (std::is_integral_v<T>) return 2;
+			else return 0;
+		}
+
+		template <class T>
+		constexpr bool is_raw_serializable_v{ std::is_trivially_copyable_v<T> };
+
+		template <class T>
+		constexpr std::size_t raw_chunk_elements{ sizeof(T) < stream_header::raw_chunk_bytes ? stream_header::raw_chunk_bytes / sizeof(T) : 1 };
+
+		template <class Sink>
+		void check_sink(Sink& sink)
+		{
+			if (!sink) {
+				throw std::runtime_error{ "serialize: write failed" };
+			}
+		}
+
+		// raw storage for count values, given back by the deleter
+		template <class T>
+		struct raw_buffer_deleter
+		{
+			std::size_t count_;
+
+			void operator()(T* ptr) const noexcept
+			{
+				std::allocator<T>{}.deallocate(ptr, count_);
+			}
+		};
+
+		template <class T>
+		using raw_buffer = std::unique_ptr<T, raw_buffer_deleter<T>>;
+
+		template <class T>
+		raw_buffer<T> make_raw_buffer(std::size_t count)
+		{
+			return raw_buffer<T>{ std::allocator<T>{}.allocate(count), raw_buffer_deleter<T>{ count } };
+		}
+	}
+
+	// Writes list to sink in the format above. Throws std::runtime_error when the sink fails
+	template <class T, class Alloc, class Checking, class Sizing, class Stats, class Sink>
+	void serialize(const list<T, Alloc, Checking, Sizing, Stats>& list, Sink& sink)
+	{
+		detail::stream_header header{};
+		header.count_ = list.size();
+		if constexpr (detail::is_raw_serializable_v<T>) {
+			header.flags_ = detail::stream_header::raw_values;
+			header.value_size_ = static_cast<std::uint32_t>(sizeof(T));
+			header.value_kind_ = detail::value_kind<T>();
+		}
+		serializer<detail::stream_header>::write(sink, header);
+		detail::check_sink(sink);
+
+		if constexpr (detail::is_raw_serializable_v<T>) {
+			// the values are gathered into a buffer and written a chunk at a time
+			constexpr auto chunk = detail::raw_chunk_elements<T>;
+			auto buffer = detail::make_raw_buffer<T>(chunk);
+			std::uint32_t used{};
+			auto flush = [&sink, &buffer, &used]() {
+				serializer<std::uint32_t>::write(sink, used);
+				sink.write(reinterpret_cast<const char*>(buffer.get()), static_cast<std::streamsize>(used * sizeof(T)));
+				detail::check_sink(sink);
+				used = 0;
+			};
+
+			list.for_each([&](const T& value) {
+				std::memcpy(static_cast<void*>(buffer.get() + used), std::addressof(value), sizeof(T));
+				if (++used == chunk) {
+					flush();
+				}
+			});
+			if (used != 0) {
+				flush();
+			}
+		}
+		else {
+			auto left = header.count_;
+			std::uint32_t in_chunk{};
+			list.for_each([&](const T& value) {
+				if (in_chunk == 0) {
+					in_chunk = left < detail::stream_header::chunk_elements ? static_cast<std::uint32_t>(left) : detail::stream_header::chunk_elements;
+					left -= in_chunk;
+					serializer<std::uint32_t>::write(sink, in_chunk);
+				}
+				serializer<T>::write(sink, value);
+				detail::check_sink(sink);
+				--in_chunk;
+			});
+		}
+
+		serializer<std::uint32_t>::write(sink, std::uint32_t{}); // end of the stream
+		detail::check_sink(sink);
+	}
+
+	// Reads a list written by serialize. The allocator is given to the new list
+	template <class List, class Source>
+	[[nodiscard]] List deserialize(Source& source, const typename List::allocator_type& allocator = typename List::allocator_type{})
+	{
+		using value_type = typename List::value_type;
+
+		auto header = serializer<detail::stream_header>::read(source);
+		if (header.magic_ != detail::stream_header::magic_value) {
+			throw std::runtime_error{ "deserialize: not a list stream, or written on a machine of the other byte order" };
+		}
+		if (header.version_ != detail::stream_header::current_version) {
+			throw std::runtime_error{ "deserialize: unknown format version" };
+		}
+		auto raw = (header.flags_ & detail::stream_header::raw_values) != 0;
+		if (raw != detail::is_raw_serializable_v<value_type> || (raw && (header.value_size_ != sizeof(value_type) || header.value_kind_ != detail::value_kind<value_type>()))) {
+			throw std::runtime_error{ "deserialize: stream written for another value type" };
+		}
+
+		List list(allocator);
+		std::uint64_t read{};
+		if constexpr (detail::is_raw_serializable_v<value_type>) {
+			constexpr auto chunk = detail::raw_chunk_elements<value_type>;
+			auto buffer = detail::make_raw_buffer<value_type>(chunk);
+			for (;;) {
+				auto count = serializer<std::uint32_t>::read(source);
+				if (count == 0) break;
+				if (count > chunk || count > header.count_ - read) {
+					throw std::runtime_error{ "deserialize: corrupt chunk" };
+				}
+				source.read(reinterpret_cast<char*>(buffer.get()), static_cast<std::streamsize>(count * sizeof(value_type)));
+				if (!source) {
+					throw std::runtime_error{ "deserialize: stream cut short" };
+				}
+				list.insert(list.end(), buffer.get(), buffer.get() + count);
+				read += count;
+			}
+		}
+		else {
+			for (;;) {
+				auto count = serializer<std::uint32_t>::read(source);
+				if (count == 0) break;
+				if (count > header.count_ - read) {
+					throw std::runtime_error{ "deserialize: corrupt chunk" };
+				}
+				for (std::uint32_t i{}; i < count; ++i) {
+					list.push_back(serializer<value_type>::read(source));
+				}
+				read += count;
+			}
+		}
+
+		if (read != header.count_) {
+			throw std::runtime_error{ "deserialize: stream cut short" };
+		}
+		return list;
+	}
+}
+
+#endif
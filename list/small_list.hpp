@@ -0,0 +1,537 @@
+#pragma once
+#ifndef MY_LIB_SMALL_LIST
+#define MY_LIB_SMALL_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <initializer_list>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include "list.hpp"
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * detail::inline_slots
+	 * detail::inline_slot_allocator
+	 * detail::inline_slots_holder
+	 * small_list
+	 *
+	 * small_list<T, N> is a my_lib::list whose first N nodes live inside the list object: a list of up to N
+	 * elements allocates nothing, the node N + 1 comes from Alloc. The interface is the one of my_lib::list.
+	 * A node in the buffer of one list cannot become a node of another one, so where list only relinks,
+	 * small_list moves the values of the inline nodes into new nodes of the target list:
+	 *     splice / merge from another small_list, move construction and assignment, swap
+	 * are O(number of inline elements moved) and invalidate the iterators to those elements (the heap nodes
+	 * are relinked as in list, their iterators stay valid). extract() of an inline element moves it to a heap node
+	 * first, so a node handle never points into a list. A moved-from small_list is empty.
+	 */
+
+	namespace detail
+	{
+		// Count raw slots of Size bytes, a bit per slot in free_
+		template <std::size_t Size, std::size_t Align, std::size_t Count>
+		class inline_slots
+		{
+			static_assert(Count > 0 && Count <= 64, "small_list keeps 1 to 64 nodes inline");
+
+			std::uint64_t free_{ Count == 64 ? ~std::uint64_t{} : (std::uint64_t{ 1 } << Count) - 1 };
+			bool spill_{}; // take() gives nothing, the next node goes to the heap (small_list::extract)
+			alignas(Align) std::byte bytes_[Size * Count];
+
+			[[nodiscard]] static std::size_t lowest_bit(std::uint64_t bits) noexcept
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+				std::size_t bit{};
+				for (; (bits & 1) == 0; bits >>= 1) {
+					++bit;
+				}
+				return bit;
+#endif
+			}
+
+		public:
+			static constexpr std::size_t slot_size{ Size };
+			static constexpr std::size_t slot_align{ Align };
+
+			inline_slots() noexcept = default;
+
+			inline_slots(const inline_slots&)				= delete;
+			inline_slots& operator=(const inline_slots&)	= delete;
+
+			// a free slot, nullptr if there is none
+			[[nodiscard]] void* take() noexcept
+			{
+				if (free_ == 0 || spill_) return nullptr;
+				auto slot = lowest_bit(free_);
+				free_ &= free_ - 1;
+				return bytes_ + slot * Size;
+			}
+
+			void give_back(const void* ptr) noexcept
+			{
+				auto slot = static_cast<std::size_t>(static_cast<const std::byte*>(ptr) - bytes_) / Size;
+				assert(slot < Count && (free_ & (std::uint64_t{ 1 } << slot)) == 0 && "slot given back twice");
+				free_ |= std::uint64_t{ 1 } << slot;
+			}
+
+			// ptr points into a slot (a node or its value)
+			[[nodiscard]] bool owns(const void* ptr) const noexcept
+			{
+				auto byte = static_cast<const std::byte*>(ptr);
+				return !std::less<const std::byte*>{}(byte, bytes_) && std::less<const std::byte*>{}(byte, bytes_ + Size * Count);
+			}
+
+			[[nodiscard]] bool any_used() const noexcept
+			{
+				return free_ != (Count == 64 ? ~std::uint64_t{} : (std::uint64_t{ 1 } << Count) - 1);
+			}
+
+			void spill(bool on) noexcept
+			{
+				spill_ = on;
+			}
+		};
+
+		// Single nodes from the slots while there are free ones, everything else from Alloc.
+		// Allocators of two lists compare equal when their Allocs do: list may then relink heap nodes between
+		// them, small_list never lets it relink an inline one
+		template <class T, class Slots, class Alloc>
+		class inline_slot_allocator
+		{
+			template <class U, class Slots2, class Alloc2>
+			friend class inline_slot_allocator;
+
+			// type aliases
+		public:
+			using value_type = T;
+			using base_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+			using propagate_on_container_copy_assignment = std::false_type;
+			using propagate_on_container_move_assignment = std::false_type;
+			using propagate_on_container_swap = std::false_type;
+			using is_always_equal = std::false_type;
+
+			template <class U>
+			struct rebind
+			{
+				using other = inline_slot_allocator<U, Slots, Alloc>;
+			};
+
+			static_assert(std::is_same_v<typename std::allocator_traits<base_allocator>::pointer, T*>, "small_list needs an allocator of raw pointers");
+
+		private:
+			Slots* slots_;
+			base_allocator base_;
+
+			// Ctors
+		public:
+			inline_slot_allocator(Slots& slots, const Alloc& base) noexcept : slots_{ std::addressof(slots) }, base_{ base } {}
+
+			template <class U>
+			inline_slot_allocator(const inline_slot_allocator<U, Slots, Alloc>& rhs) noexcept : slots_{ rhs.slots_ }, base_{ rhs.base_ } {}
+
+		public:
+			[[nodiscard]] T* allocate(std::size_t count)
+			{
+				if constexpr (sizeof(T) == Slots::slot_size && alignof(T) <= Slots::slot_align) {
+					if (count == 1) {
+						if (auto slot = slots_->take()) {
+							return static_cast<T*>(slot);
+						}
+					}
+				}
+				return std::allocator_traits<base_allocator>::allocate(base_, count);
+			}
+
+			void deallocate(T* ptr, std::size_t count) noexcept
+			{
+				if (slots_->owns(ptr)) {
+					slots_->give_back(ptr);
+					return;
+				}
+				std::allocator_traits<base_allocator>::deallocate(base_, ptr, count);
+			}
+
+			[[nodiscard]] const base_allocator& base() const noexcept
+			{
+				return base_;
+			}
+
+			[[nodiscard]] friend bool operator==(const inline_slot_allocator& lhs, const inline_slot_allocator& rhs) noexcept
+			{
+				return lhs.base_ == rhs.base_;
+			}
+
+			[[nodiscard]] friend bool operator!=(const inline_slot_allocator& lhs, const inline_slot_allocator& rhs) noexcept
+			{
+				return !(lhs == rhs);
+			}
+		};
+
+		// The first base of small_list (base-from-member): bases are destroyed in reverse order, so the slots
+		// are still there when ~list destroys the inline values and gives their slots back
+		template <class Slots>
+		struct inline_slots_holder
+		{
+			Slots slots_;
+		};
+	}
+
+	template <class T, std::size_t N, class Alloc = std::allocator<T>, class Checking = default_iterator_checking>
+	class small_list
+		: private detail::inline_slots_holder<detail::inline_slots<sizeof(list_node<T, void*, Checking::enabled>), alignof(list_node<T, void*, Checking::enabled>), N>>
+		, private list<T, detail::inline_slot_allocator<T, detail::inline_slots<sizeof(list_node<T, void*, Checking::enabled>), alignof(list_node<T, void*, Checking::enabled>), N>, Alloc>, Checking>
+	{
+		using slots_type = detail::inline_slots<sizeof(list_node<T, void*, Checking::enabled>), alignof(list_node<T, void*, Checking::enabled>), N>;
+		using slots_holder = detail::inline_slots_holder<slots_type>;
+		using inline_allocator = detail::inline_slot_allocator<T, slots_type, Alloc>;
+		using base_list = list<T, inline_allocator, Checking>;
+
+		static_assert(std::is_same_v<typename base_list::list_node_type, list_node<T, void*, Checking::enabled>>, "the slots are sized for another node");
+
+		// in the first base, so they are built before the list and destroyed after it. The allocator of the base
+		// only keeps their address: every constructor makes the base empty and adds the elements in its body
+		using slots_holder::slots_;
+
+		// type aliases
+	public:
+		using value_type				= T;
+		using allocator_type			= Alloc;
+		using size_type					= typename base_list::size_type;
+		using difference_type			= typename base_list::difference_type;
+		using reference					= typename base_list::reference;
+		using const_reference			= typename base_list::const_reference;
+		using pointer					= typename base_list::pointer;
+		using const_pointer				= typename base_list::const_pointer;
+		using iterator					= typename base_list::iterator;
+		using const_iterator			= typename base_list::const_iterator;
+		using reverse_iterator			= typename base_list::reverse_iterator;
+		using const_reverse_iterator	= typename base_list::const_reverse_iterator;
+		using node_type					= typename base_list::node_type;
+		using checking					= Checking;
+
+		// Ctors
+	public:
+		small_list() : small_list(allocator_type{}) {}
+
+		explicit small_list(const allocator_type& allocator) noexcept : base_list(make_allocator(allocator)) {}
+
+		explicit small_list(size_type count, const allocator_type& allocator = allocator_type{}) : small_list(allocator)
+		{
+			base_list::resize(count);
+		}
+
+		small_list(size_type count, const_reference value, const allocator_type& allocator = allocator_type{}) : small_list(allocator)
+		{
+			base_list::insert(end(), count, value);
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value, int> = 0>
+		small_list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : small_list(allocator)
+		{
+			base_list::insert(end(), first, last);
+		}
+
+		small_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type{}) : small_list(allocator)
+		{
+			base_list::insert(end(), ilist.begin(), ilist.end());
+		}
+
+		small_list(const small_list& rhs) : small_list(rhs.begin(), rhs.end(),
+			std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.get_allocator())) {}
+
+		// the inline elements of rhs are moved into the slots of this one, the heap nodes are taken
+		small_list(small_list&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) : small_list(rhs.get_allocator())
+		{
+			splice(end(), rhs);
+		}
+
+		small_list& operator=(const small_list& rhs)
+		{
+			base_list::operator=(rhs);
+			return *this;
+		}
+
+		small_list& operator=(small_list&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this == std::addressof(rhs)) return *this;
+			clear();
+			splice(end(), rhs);
+			return *this;
+		}
+
+		small_list& operator=(std::initializer_list<value_type> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(base_list::get_allocator().base());
+		}
+
+	private:
+		[[nodiscard]] inline_allocator make_allocator(const allocator_type& allocator) noexcept
+		{
+			return inline_allocator{ slots_, allocator };
+		}
+
+		[[nodiscard]] base_list& as_base() noexcept
+		{
+			return *this;
+		}
+
+		[[nodiscard]] const base_list& as_base() const noexcept
+		{
+			return *this;
+		}
+
+		[[nodiscard]] bool is_inline(const_iterator pos) const noexcept
+		{
+			return slots_.owns(std::addressof(*pos));
+		}
+
+		// Moves [first, last) of rhs (another list) before pos: heap nodes are relinked, the values of
+		// inline nodes are moved into nodes of this list. If a move throws, the elements before it are moved
+		void take_range(const_iterator pos, small_list& rhs, const_iterator first, const_iterator last)
+		{
+			if (!rhs.slots_.any_used()) {
+				base_list::splice(pos, rhs.as_base(), first, last);
+				return;
+			}
+
+			while (first != last) {
+				auto next = std::next(first);
+				if (rhs.is_inline(first)) {
+					base_list::emplace(pos, std::move(const_cast<reference>(*first)));
+					rhs.base_list::erase(first);
+				}
+				else {
+					base_list::splice(pos, rhs.as_base(), first);
+				}
+				first = next;
+			}
+		}
+
+		// list API
+	public:
+		using base_list::assign;
+
+		using base_list::front;
+		using base_list::back;
+
+		using base_list::begin;
+		using base_list::end;
+		using base_list::cbegin;
+		using base_list::cend;
+		using base_list::rbegin;
+		using base_list::rend;
+		using base_list::crbegin;
+		using base_list::crend;
+
+		using base_list::empty;
+		using base_list::size;
+		using base_list::max_size;
+		using base_list::reserve;
+		using base_list::shrink_to_fit;
+		using base_list::compact;
+
+		using base_list::clear;
+		using base_list::insert;
+		using base_list::emplace;
+		using base_list::erase;
+		using base_list::push_back;
+		using base_list::emplace_back;
+		using base_list::pop_back;
+		using base_list::push_front;
+		using base_list::emplace_front;
+		using base_list::pop_front;
+		using base_list::resize;
+
+		using base_list::remove;
+		using base_list::remove_if;
+		using base_list::reverse;
+		using base_list::unique;
+		using base_list::sort;
+
+		using base_list::for_each;
+		using base_list::accumulate;
+		using base_list::find;
+		using base_list::find_if;
+		using base_list::contains;
+		using base_list::count;
+		using base_list::count_if;
+		using base_list::min_element;
+		using base_list::max_element;
+
+		// Capacity
+	public:
+		[[nodiscard]] static constexpr size_type inline_capacity() noexcept
+		{
+			return N;
+		}
+
+		// Modifiers
+	public:
+		// An inline element is moved to a heap node first (the handle may outlive the list). The node is made
+		// by a list without spare nodes, a spare of this one (after reserve) may be an inline slot
+		[[nodiscard]] node_type extract(const_iterator pos)
+		{
+			assert(pos != end() && "cannot extract out of range iterator");
+			if (!is_inline(pos)) {
+				return base_list::extract(pos);
+			}
+
+			base_list heap{ base_list::get_allocator() };
+			slots_.spill(true);
+			try {
+				heap.emplace_back(std::move(const_cast<reference>(*pos)));
+			}
+			catch (...) {
+				slots_.spill(false);
+				throw;
+			}
+			slots_.spill(false);
+			base_list::erase(pos);
+			return heap.extract(heap.begin());
+		}
+
+		// Elements move between two small_lists (O(n) for the inline ones, see the top of the file)
+		void swap(small_list& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this == std::addressof(rhs)) return;
+			small_list tmp{ std::move(rhs) };
+			rhs = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		friend void swap(small_list& lhs, small_list& rhs) noexcept(noexcept(lhs.swap(rhs)))
+		{
+			lhs.swap(rhs);
+		}
+
+		// Operations
+	public:
+		void splice(const_iterator pos, small_list& rhs)
+		{
+			splice(pos, std::move(rhs));
+		}
+
+		// O(1) if rhs has no inline elements, else O(size of rhs)
+		void splice(const_iterator pos, small_list&& rhs)
+		{
+			if (this == std::addressof(rhs) || rhs.empty()) return;
+			if (!rhs.slots_.any_used()) {
+				base_list::splice(pos, rhs.as_base());
+				return;
+			}
+			take_range(pos, rhs, rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, small_list& rhs, const_iterator it)
+		{
+			splice(pos, std::move(rhs), it);
+		}
+
+		void splice(const_iterator pos, small_list&& rhs, const_iterator it)
+		{
+			if (this == std::addressof(rhs)) {
+				base_list::splice(pos, as_base(), it);
+				return;
+			}
+			take_range(pos, rhs, it, std::next(it));
+		}
+
+		void splice(const_iterator pos, small_list& rhs, const_iterator first, const_iterator last)
+		{
+			splice(pos, std::move(rhs), first, last);
+		}
+
+		void splice(const_iterator pos, small_list&& rhs, const_iterator first, const_iterator last)
+		{
+			if (this == std::addressof(rhs)) {
+				base_list::splice(pos, as_base(), first, last);
+				return;
+			}
+			take_range(pos, rhs, first, last);
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(small_list& rhs, Cmp cmp = Cmp{})
+		{
+			merge(std::move(rhs), cmp);
+		}
+
+		// The elements of rhs are spliced to the end (moving the inline ones), then the two sorted runs are
+		// merged by relinking inside this list. If cmp throws, all elements are in this list in some order
+		template <class Cmp = std::less<value_type>>
+		void merge(small_list&& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs) || rhs.empty()) return;
+			assert(std::is_sorted(begin(), end(), cmp) && std::is_sorted(rhs.begin(), rhs.end(), cmp) && "sequence not ordered");
+
+			if (empty()) {
+				splice(end(), rhs);
+				return;
+			}
+
+			auto last = std::prev(end());
+			splice(end(), rhs);
+			auto first = begin();
+			auto second = std::next(last);
+			while (first != second && second != end()) {
+				if (cmp(*second, *first)) {
+					auto next = std::next(second);
+					base_list::splice(first, as_base(), second);
+					second = next;
+				}
+				else {
+					++first;
+				}
+			}
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] friend bool operator==(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return lhs.as_base() == rhs.as_base();
+		}
+
+		[[nodiscard]] friend bool operator!=(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return !(lhs == rhs);
+		}
+
+		[[nodiscard]] friend bool operator<(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return lhs.as_base() < rhs.as_base();
+		}
+
+		[[nodiscard]] friend bool operator>(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return rhs < lhs;
+		}
+
+		[[nodiscard]] friend bool operator<=(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return !(rhs < lhs);
+		}
+
+		[[nodiscard]] friend bool operator>=(const small_list& lhs, const small_list& rhs) noexcept
+		{
+			return !(lhs < rhs);
+		}
+	};
+}
+
+#endif
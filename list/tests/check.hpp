@@ -0,0 +1,51 @@
+#pragma once
+#ifndef MY_LIB_TESTS_CHECK
+#define MY_LIB_TESTS_CHECK
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+namespace my_lib::tests
+{
+	/*
+	 * Structure of this file:
+	 * check, MY_LIB_CHECK
+	 * same_elements
+	 * report
+	 *
+	 * The tests need no framework: MY_LIB_CHECK prints the failed condition and goes on,
+	 * report() at the end of main makes the exit code.
+	 */
+
+	inline int failures{};
+
+	inline void check(bool ok, const char* what, const char* file, int line)
+	{
+		if (!ok) {
+			++failures;
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+		}
+	}
+
+	// Same elements in the same order, walked both ways (catches broken prev_ links too)
+	template <class Container, class Expected>
+	[[nodiscard]] bool same_elements(const Container& container, const Expected& expected)
+	{
+		std::vector<typename Expected::value_type> forward(container.begin(), container.end());
+		std::vector<typename Expected::value_type> backward(container.rbegin(), container.rend());
+		std::vector<typename Expected::value_type> wanted(expected.begin(), expected.end());
+		return forward == wanted && std::equal(backward.begin(), backward.end(), wanted.rbegin(), wanted.rend());
+	}
+
+	inline int report(const char* name)
+	{
+		std::printf("%s: %s\n", name, failures == 0 ? "ok" : "FAILED");
+		return failures == 0 ? 0 : 1;
+	}
+}
+
+#define MY_LIB_CHECK(...) ::my_lib::tests::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,169 @@
+// concurrent_ordered_list: one thread against std::set, then writers, racing inserts / erases and readers at once
+// (make tsan runs it under TSan)
+// g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I.. concurrent_ordered_list_stress_test.cpp -o concurrent_ordered_list_stress_test_tsan
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../concurrent_ordered_list.hpp"
+#include "check.hpp"
+
+namespace
+{
+	constexpr int writers{ 4 };
+	constexpr int readers{ 2 };
+	constexpr int keys{ 512 };
+
+	// long enough to live on the heap, so a value freed twice or never shows up under ASan
+	std::string make_value(int number)
+	{
+		auto digits = std::to_string(number);
+		return std::string(32 - digits.size(), '0') + digits; // ordered like number
+	}
+
+	std::vector<std::string> contents(my_lib::concurrent_ordered_list<std::string>& list)
+	{
+		std::vector<std::string> values;
+		list.for_each([&values](const std::string& value) { values.push_back(value); });
+		return values;
+	}
+
+	void single_thread()
+	{
+		std::mt19937 gen{ 2021 };
+		my_lib::concurrent_ordered_list<std::string> list;
+		std::set<std::string> model;
+
+		for (int step{}; step < 20'000; ++step) {
+			auto value = make_value(static_cast<int>(gen() % keys));
+			switch (gen() % 3) {
+			case 0:
+				MY_LIB_CHECK(list.insert(value) == model.insert(value).second);
+				break;
+			case 1:
+				MY_LIB_CHECK(list.erase(value) == (model.erase(value) == 1));
+				break;
+			default:
+				MY_LIB_CHECK(list.contains(value) == (model.count(value) == 1));
+				break;
+			}
+			MY_LIB_CHECK(list.empty() == model.empty());
+		}
+		MY_LIB_CHECK(contents(list) == std::vector<std::string>(model.begin(), model.end()));
+		// the rest is destroyed by the dtor
+	}
+
+	// Each writer owns the keys with key % writers == its number and keeps a std::set of them,
+	// readers walk meanwhile: what they see must be sorted without duplicates
+	void owned_keys()
+	{
+		my_lib::concurrent_ordered_list<std::string> list;
+		std::vector<std::set<std::string>> models(writers);
+		std::atomic<int> writing{ writers };
+		std::atomic<bool> agreed{ true };
+		std::atomic<bool> sorted{ true };
+
+		std::vector<std::thread> threads;
+		for (int writer{}; writer < writers; ++writer) {
+			threads.emplace_back([&, writer] {
+				std::mt19937 gen{ static_cast<std::uint32_t>(writer) };
+				auto& model = models[writer];
+				for (int step{}; step < 10'000; ++step) {
+					auto value = make_value(static_cast<int>(gen() % (keys / writers)) * writers + writer);
+					bool ok{};
+					switch (gen() % 3) {
+					case 0:
+						ok = list.insert(value) == model.insert(value).second;
+						break;
+					case 1:
+						ok = list.erase(value) == (model.erase(value) == 1);
+						break;
+					default:
+						ok = list.contains(value) == (model.count(value) == 1);
+						break;
+					}
+					if (!ok) {
+						agreed.store(false);
+					}
+				}
+				writing.fetch_sub(1);
+			});
+		}
+		for (int reader{}; reader < readers; ++reader) {
+			threads.emplace_back([&] {
+				while (writing.load() != 0) {
+					auto values = contents(list);
+					for (std::size_t i{ 1 }; i < values.size(); ++i) {
+						if (!(values[i - 1] < values[i])) {
+							sorted.store(false);
+						}
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		std::set<std::string> all;
+		for (auto& model : models) {
+			all.insert(model.begin(), model.end());
+		}
+		MY_LIB_CHECK(agreed.load());
+		MY_LIB_CHECK(sorted.load());
+		MY_LIB_CHECK(contents(list) == std::vector<std::string>(all.begin(), all.end()));
+	}
+
+	// Every thread inserts every key, then erases every key: exactly one insert and one erase of a key succeed
+	void racing_keys()
+	{
+		my_lib::concurrent_ordered_list<int> list;
+		std::vector<std::atomic<int>> inserted(keys);
+		std::vector<std::atomic<int>> erased(keys);
+		std::atomic<int> inserting{ writers };
+
+		std::vector<std::thread> threads;
+		for (int writer{}; writer < writers; ++writer) {
+			threads.emplace_back([&, writer] {
+				for (int i{}; i < keys; ++i) {
+					auto key = (i * 7 + writer * 61) % keys; // every thread in another order
+					if (list.insert(key)) {
+						inserted[key].fetch_add(1);
+					}
+				}
+				// no erase before all inserts are done
+				inserting.fetch_sub(1);
+				while (inserting.load() != 0) {
+					std::this_thread::yield();
+				}
+				for (int i{}; i < keys; ++i) {
+					auto key = (i * 7 + writer * 61) % keys;
+					if (list.erase(key)) {
+						erased[key].fetch_add(1);
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		int once{};
+		for (int key{}; key < keys; ++key) {
+			once += inserted[key].load() == 1 && erased[key].load() == 1;
+		}
+		MY_LIB_CHECK(once == keys);
+		MY_LIB_CHECK(list.empty());
+	}
+}
+
+int main()
+{
+	single_thread();
+	owned_keys();
+	racing_keys();
+	return my_lib::tests::report("concurrent_ordered_list_stress_test");
+}
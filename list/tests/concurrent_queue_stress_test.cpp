@@ -0,0 +1,109 @@
+// concurrent_queue: one thread against std::deque, then producers and consumers at once (make tsan runs it under TSan)
+// g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I.. concurrent_queue_stress_test.cpp -o concurrent_queue_stress_test_tsan
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../concurrent_queue.hpp"
+#include "check.hpp"
+
+namespace
+{
+	constexpr int producers{ 4 };
+	constexpr int consumers{ 4 };
+	constexpr long long per_producer{ 20'000 };
+
+	// long enough to live on the heap, so a value popped twice or never destroyed shows up under ASan
+	std::string make_value(int number)
+	{
+		return std::string(32, 'a' + number % 26) + std::to_string(number);
+	}
+
+	void single_thread()
+	{
+		std::mt19937 gen{ 2021 };
+		my_lib::concurrent_queue<std::string> queue;
+		std::deque<std::string> model;
+
+		for (int step{}; step < 20'000; ++step) {
+			if (gen() % 3 != 0) {
+				auto value = make_value(step);
+				queue.push_back(value);
+				model.push_back(value);
+			}
+			else {
+				std::string value;
+				bool popped = queue.try_pop_front(value);
+				MY_LIB_CHECK(popped == !model.empty());
+				if (popped && !model.empty()) {
+					MY_LIB_CHECK(value == model.front());
+					model.pop_front();
+				}
+			}
+			MY_LIB_CHECK(queue.empty() == model.empty());
+		}
+		// the rest is destroyed by the dtor
+	}
+
+	// Every value is popped once, and one consumer sees the values of one producer in push order
+	void producers_and_consumers()
+	{
+		my_lib::concurrent_queue<long long> queue;
+		constexpr auto total = producers * per_producer;
+		std::vector<std::atomic<int>> seen(total);
+		std::atomic<long long> popped{};
+		std::atomic<bool> in_order{ true };
+
+		std::vector<std::thread> threads;
+		for (int producer{}; producer < producers; ++producer) {
+			threads.emplace_back([&queue, producer] {
+				for (long long i{}; i < per_producer; ++i) {
+					queue.push_back(producer * per_producer + i);
+				}
+			});
+		}
+		for (int consumer{}; consumer < consumers; ++consumer) {
+			threads.emplace_back([&] {
+				std::vector<long long> last(producers, -1);
+				long long value{};
+				while (popped.load() < total) {
+					if (!queue.try_pop_front(value)) {
+						std::this_thread::yield();
+						continue;
+					}
+					popped.fetch_add(1);
+					seen[value].fetch_add(1);
+					auto& previous = last[value / per_producer];
+					if (value % per_producer <= previous) {
+						in_order.store(false);
+					}
+					previous = value % per_producer;
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		long long seen_once{};
+		for (auto& count : seen) {
+			seen_once += count.load() == 1;
+		}
+		MY_LIB_CHECK(seen_once == total);
+		MY_LIB_CHECK(in_order.load());
+		MY_LIB_CHECK(queue.empty());
+		long long value{};
+		MY_LIB_CHECK(!queue.try_pop_front(value));
+	}
+}
+
+int main()
+{
+	single_thread();
+	producers_and_consumers();
+	return my_lib::tests::report("concurrent_queue_stress_test");
+}
@@ -0,0 +1,234 @@
+// forward_list against std::forward_list: random calls on two lists, splice_after (all three forms) between and inside them
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. forward_list_test.cpp -o forward_list_test
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "../forward_list.hpp"
+#include "random_ops.hpp"
+
+namespace
+{
+	using my_lib::tests::heap_int;
+	using my_lib::tests::key_of;
+
+	template <class List>
+	std::size_t length(const List& list)
+	{
+		return static_cast<std::size_t>(std::distance(list.begin(), list.end()));
+	}
+
+	template <class Lhs, class Rhs>
+	bool same(const Lhs& lhs, const Rhs& rhs)
+	{
+		return std::vector<typename Lhs::value_type>(lhs.begin(), lhs.end()) == std::vector<typename Rhs::value_type>(rhs.begin(), rhs.end());
+	}
+
+	// like random_operations, with the *_after calls of a singly linked list. pos is the position of the iterator
+	// passed as "after", 0 is before_begin()
+	template <class T>
+	void random_forward_operations(std::uint32_t seed, int steps)
+	{
+		using list_type = my_lib::forward_list<T>;
+		using model_type = std::forward_list<T>;
+
+		std::mt19937 gen{ seed };
+		auto draw = [&gen](std::size_t bound) { return static_cast<std::size_t>(gen() % (bound + 1)); }; // [0, bound]
+		auto value = [&] { return T{ static_cast<int>(draw(15)) }; };
+		auto coarse = [](const T& lhs, const T& rhs) { return key_of(lhs) / 4 < key_of(rhs) / 4; };
+
+		list_type lists[2];
+		model_type models[2];
+
+		for (int step{}; step < steps; ++step) {
+			auto side = draw(1);
+			auto& list = lists[side];
+			auto& model = models[side];
+			auto& other = lists[1 - side];
+			auto& other_model = models[1 - side];
+			auto size = length(model);
+			auto other_size = length(other_model);
+			auto op = size > 64 && draw(1) == 0 ? 5 + draw(1) : draw(20);
+			auto pos = draw(size); // after before_begin() + pos
+			auto at = std::next(list.before_begin(), pos);
+			auto model_at = std::next(model.before_begin(), pos);
+
+			switch (op) {
+			case 0: {
+				auto v = value();
+				list.push_front(v);
+				model.push_front(v);
+				break;
+			}
+			case 1:
+				if (size != 0) {
+					list.pop_front();
+					model.pop_front();
+				}
+				break;
+			case 2: {
+				auto v = value();
+				auto it = list.insert_after(at, v);
+				model.insert_after(model_at, v);
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.before_begin(), it)) == pos + 1);
+				break;
+			}
+			case 3: {
+				auto count = draw(9);
+				auto v = value();
+				list.insert_after(at, count, v);
+				model.insert_after(model_at, count, v);
+				break;
+			}
+			case 4: {
+				std::vector<T> values(draw(20));
+				for (auto& v : values) {
+					v = value();
+				}
+				list.insert_after(at, values.begin(), values.end());
+				model.insert_after(model_at, values.begin(), values.end());
+				break;
+			}
+			case 5:
+				if (pos != size) {
+					list.erase_after(at);
+					model.erase_after(model_at);
+				}
+				break;
+			case 6: {
+				auto last = pos + 1 + draw(size - pos);
+				auto it = list.erase_after(at, std::next(list.before_begin(), last));
+				model.erase_after(model_at, std::next(model.before_begin(), last));
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.before_begin(), it)) == pos + 1);
+				break;
+			}
+			case 7: {
+				auto new_size = draw(size + 10);
+				if (draw(1) == 0) {
+					list.resize(new_size);
+					model.resize(new_size);
+				}
+				else {
+					auto v = value();
+					list.resize(new_size, v);
+					model.resize(new_size, v);
+				}
+				break;
+			}
+			case 8:
+				list.splice_after(at, other);
+				model.splice_after(model_at, other_model);
+				break;
+			case 9:
+				if (other_size != 0) {
+					auto from = draw(other_size - 1); // the element after before_begin() + from
+					list.splice_after(at, other, std::next(other.before_begin(), from));
+					model.splice_after(model_at, other_model, std::next(other_model.before_begin(), from));
+				}
+				break;
+			case 10: {
+				// (first, last) of the other list, last may be end()
+				auto first = draw(other_size);
+				auto last = first + 1 + draw(other_size - first);
+				auto last_it = last > other_size ? other.end() : std::next(other.before_begin(), last);
+				auto model_last = last > other_size ? other_model.end() : std::next(other_model.before_begin(), last);
+				list.splice_after(at, other, std::next(other.before_begin(), first), last_it);
+				model.splice_after(model_at, other_model, std::next(other_model.before_begin(), first), model_last);
+				break;
+			}
+			case 11:
+				// one element of the list itself, also after itself or its predecessor
+				if (size != 0) {
+					auto from = draw(size - 1);
+					list.splice_after(at, list, std::next(list.before_begin(), from));
+					model.splice_after(model_at, model, std::next(model.before_begin(), from));
+				}
+				break;
+			case 12: {
+				// (first, last) of the list itself, pos is not inside it
+				auto first = draw(size);
+				auto last = first + 1 + draw(size - first);
+				if (pos > first && pos < last) {
+					pos = first;
+				}
+				auto last_it = last > size ? list.end() : std::next(list.before_begin(), last);
+				auto model_last = last > size ? model.end() : std::next(model.before_begin(), last);
+				list.splice_after(std::next(list.before_begin(), pos), list, std::next(list.before_begin(), first), last_it);
+				model.splice_after(std::next(model.before_begin(), pos), model, std::next(model.before_begin(), first), model_last);
+				break;
+			}
+			case 13: {
+				auto v = value();
+				list.remove(v);
+				model.remove(v);
+				break;
+			}
+			case 14: {
+				auto v = value();
+				list.remove_if([&v](const T& elem) { return elem < v; });
+				model.remove_if([&v](const T& elem) { return elem < v; });
+				break;
+			}
+			case 15:
+				if (draw(1) == 0) {
+					list.unique();
+					model.unique();
+				}
+				else {
+					list.unique(coarse);
+					model.unique(coarse);
+				}
+				break;
+			case 16:
+				list.sort(coarse);
+				model.sort(coarse);
+				break;
+			case 17:
+				list.sort(coarse);
+				model.sort(coarse);
+				other.sort(coarse);
+				other_model.sort(coarse);
+				list.merge(other, coarse);
+				model.merge(other_model, coarse);
+				break;
+			case 18:
+				list.reverse();
+				model.reverse();
+				break;
+			case 19:
+				list.swap(other);
+				model.swap(other_model);
+				break;
+			default: {
+				std::vector<T> values(draw(40));
+				for (auto& v : values) {
+					v = value();
+				}
+				list.assign(values.begin(), values.end());
+				model.assign(values.begin(), values.end());
+				break;
+			}
+			}
+
+			for (std::size_t i{}; i < 2; ++i) {
+				MY_LIB_CHECK(same(lists[i], models[i]));
+				MY_LIB_CHECK(lists[i].empty() == models[i].empty());
+			}
+			if (my_lib::tests::failures != 0) {
+				std::fprintf(stderr, "seed %u, step %d, operation %zu\n", seed, step, op);
+				return;
+			}
+		}
+	}
+}
+
+int main()
+{
+	for (std::uint32_t seed{ 1 }; seed <= 20; ++seed) {
+		random_forward_operations<int>(seed, 2'000);
+		random_forward_operations<heap_int>(seed, 2'000);
+	}
+	return my_lib::tests::report("forward_list_test");
+}
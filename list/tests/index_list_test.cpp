@@ -0,0 +1,52 @@
+// index_list against std::list: random calls, and iterators that survive the growth of the node array
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. index_list_test.cpp -o index_list_test
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <vector>
+#include "../index_list.hpp"
+#include "random_ops.hpp"
+
+namespace
+{
+	using my_lib::tests::heap_int;
+
+	template <class T>
+	void check_capacity(const my_lib::index_list<T>& list, const std::list<T>&)
+	{
+		MY_LIB_CHECK(list.capacity() >= list.size());
+	}
+
+	// the array grows under held iterators, and the elements around them are erased and inserted again
+	void iterators_survive_growth()
+	{
+		my_lib::index_list<heap_int> list{ 1, 2, 3 };
+		auto first = list.begin();
+		auto last = std::prev(list.end());
+		auto capacity = list.capacity();
+		for (int i{}; i < 1'000; ++i) {
+			list.push_back(i);
+			list.push_front(i);
+		}
+		MY_LIB_CHECK(list.capacity() > capacity);
+		MY_LIB_CHECK(key_of(*first) == 1 && key_of(*last) == 3);
+
+		list.erase(list.begin(), first);
+		list.erase(std::next(last), list.end());
+		list.erase(std::next(first));
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, std::vector<heap_int>{ 1, 3 }));
+		list.insert(last, 2);
+		MY_LIB_CHECK(std::next(first, 2) == last);
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, std::vector<heap_int>{ 1, 2, 3 }));
+	}
+}
+
+int main()
+{
+	for (std::uint32_t seed{ 1 }; seed <= 20; ++seed) {
+		my_lib::tests::random_operations<my_lib::index_list<int>>(seed, 2'000, &check_capacity<int>);
+		my_lib::tests::random_operations<my_lib::index_list<heap_int>>(seed, 2'000, &check_capacity<heap_int>);
+	}
+	iterators_survive_growth();
+	return my_lib::tests::report("index_list_test");
+}
@@ -0,0 +1,70 @@
+// indexed_list against std::list: random calls, with nth, operator[] and index_of checked against positions every step
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. indexed_list_test.cpp -o indexed_list_test
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+#include "../indexed_list.hpp"
+#include "random_ops.hpp"
+
+namespace
+{
+	using my_lib::tests::heap_int;
+
+	// the index answers like a std::vector of the elements (the spans and towers are right)
+	template <class T>
+	void check_index(const my_lib::indexed_list<T>& list, const std::list<T>& model)
+	{
+		std::vector<T> expected(model.begin(), model.end());
+		std::size_t pos{};
+		for (auto it = list.begin(); it != list.end(); ++it, ++pos) {
+			MY_LIB_CHECK(list.nth(pos) == it);
+			MY_LIB_CHECK(list.index_of(it) == pos);
+			MY_LIB_CHECK(list[pos] == expected[pos]);
+		}
+		MY_LIB_CHECK(list.nth(list.size()) == list.end());
+		MY_LIB_CHECK(list.index_of(list.end()) == list.size());
+	}
+
+	// long lists get towers of several levels, which the short ones of random_operations rarely do
+	void long_list()
+	{
+		my_lib::indexed_list<int> list;
+		std::vector<int> expected;
+		for (int i{}; i < 5'000; ++i) {
+			list.push_back(i);
+			expected.push_back(i);
+		}
+		for (int i{}; i < 1'000; ++i) {
+			list.push_front(-i);
+			expected.insert(expected.begin(), -i);
+		}
+		for (std::size_t pos{ 7 }; pos < expected.size(); pos += 97) {
+			list.erase(list.nth(pos));
+			expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(pos));
+		}
+		list.erase(list.nth(100), list.nth(2'100));
+		expected.erase(expected.begin() + 100, expected.begin() + 2'100);
+		for (int i{}; i < 500; ++i) {
+			list.pop_front();
+			expected.erase(expected.begin());
+		}
+
+		MY_LIB_CHECK(list.size() == expected.size());
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+		for (std::size_t pos{}; pos < expected.size(); ++pos) {
+			MY_LIB_CHECK(list[pos] == expected[pos]);
+			MY_LIB_CHECK(list.index_of(list.nth(pos)) == pos);
+		}
+	}
+}
+
+int main()
+{
+	for (std::uint32_t seed{ 1 }; seed <= 20; ++seed) {
+		my_lib::tests::random_operations<my_lib::indexed_list<int>>(seed, 2'000, &check_index<int>);
+		my_lib::tests::random_operations<my_lib::indexed_list<heap_int>>(seed, 2'000, &check_index<heap_int>);
+	}
+	long_list();
+	return my_lib::tests::report("indexed_list_test");
+}
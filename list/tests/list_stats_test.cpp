@@ -0,0 +1,144 @@
+// list_stats: the counters of known operations on a collect_stats list, and their to_json
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. list_stats_test.cpp -o list_stats_test
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include "../list.hpp"
+#include "../list_stats.hpp"
+#include "../node_pool.hpp"
+#include "check.hpp"
+
+namespace
+{
+	template <class Alloc = std::allocator<int>, class Sizing = my_lib::eager_size>
+	using stats_list = my_lib::list<int, Alloc, my_lib::unchecked_iterators, Sizing, my_lib::collect_stats>;
+
+	using histogram = my_lib::log2_histogram;
+
+	const std::string zeros{ "{\"allocations\":0,\"batch_allocations\":0,\"frees\":0,\"recycled\":0,\"traversals\":0,\"nodes_visited\":0,"
+		"\"traversal_lengths\":[],\"splices\":0,\"unsized_splices\":0,\"splice_sizes\":[],\"merges\":0,\"merged_nodes\":0,"
+		"\"sorts\":0,\"sort_sizes\":[],\"sort_ns\":0,\"max_sort_ns\":0}" };
+
+	void buckets()
+	{
+		MY_LIB_CHECK(histogram::bucket_of(0) == 0);
+		MY_LIB_CHECK(histogram::bucket_of(1) == 1);
+		MY_LIB_CHECK(histogram::bucket_of(2) == 2 && histogram::bucket_of(3) == 2);
+		MY_LIB_CHECK(histogram::bucket_of(4) == 3 && histogram::bucket_of(7) == 3);
+		MY_LIB_CHECK(histogram::bucket_of(std::uint64_t{ 1 } << 30) == 31);
+		MY_LIB_CHECK(histogram::bucket_of(~std::uint64_t{}) == histogram::bucket_count - 1);
+	}
+
+	// a few operations whose counts are known, then the whole JSON
+	void known_operations()
+	{
+		stats_list<> list;
+		MY_LIB_CHECK(list.stats().to_json() == zeros);
+
+		for (int i{ 1 }; i <= 4; ++i) {
+			list.push_back(i);
+		}
+		list.pop_back();
+		list.remove(2); // walks 3 nodes, frees 1
+		stats_list<> other{ 7, 8 };
+		list.splice(list.end(), other);
+		stats_list<> five{ 5 };
+		list.merge(five);
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, std::initializer_list<int>{ 1, 3, 5, 7, 8 }));
+
+		auto stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 4 && stats.frees_ == 2 && stats.batch_allocations_ == 0 && stats.recycled_ == 0);
+		MY_LIB_CHECK(stats.traversals_ == 1 && stats.nodes_visited_ == 3 && stats.traversal_lengths_.buckets_[2] == 1);
+		MY_LIB_CHECK(stats.splices_ == 1 && stats.unsized_splices_ == 0 && stats.splice_sizes_.buckets_[2] == 1);
+		MY_LIB_CHECK(stats.merges_ == 1 && stats.merged_nodes_ == 1 && stats.sorts_ == 0);
+		MY_LIB_CHECK(stats.to_json() == "{\"allocations\":4,\"batch_allocations\":0,\"frees\":2,\"recycled\":0,\"traversals\":1,"
+			"\"nodes_visited\":3,\"traversal_lengths\":[0,0,1],\"splices\":1,\"unsized_splices\":0,\"splice_sizes\":[0,0,1],"
+			"\"merges\":1,\"merged_nodes\":1,\"sorts\":0,\"sort_sizes\":[],\"sort_ns\":0,\"max_sort_ns\":0}");
+
+		// the other lists count their own nodes
+		MY_LIB_CHECK(other.stats().allocations_ == 2 && other.stats().splices_ == 0);
+
+		list.reset_stats();
+		MY_LIB_CHECK(list.stats().to_json() == zeros);
+	}
+
+	// the traversals, the three splices, sort, reserve; copies start at zero
+	void more_operations()
+	{
+		stats_list<> list;
+		for (int i{}; i < 20; ++i) {
+			list.push_back(19 - i);
+		}
+		(void)list.count(3); // 20 nodes
+		list.for_each([](int) {});
+		(void)list.accumulate(0);
+		list.unique(); // 20
+		list.remove_if([](int value) { return value >= 16; }); // 20, frees 4
+		auto stats = list.stats();
+		MY_LIB_CHECK(stats.traversals_ == 5 && stats.nodes_visited_ == 100 && stats.traversal_lengths_.buckets_[5] == 5);
+		MY_LIB_CHECK(stats.frees_ == 4);
+		(void)list.find(100); // a miss walks the whole list, 16 nodes
+		stats = list.stats();
+		MY_LIB_CHECK(stats.traversals_ == 6 && stats.nodes_visited_ == 116);
+
+		stats_list<> other{ 100, 101, 102, 103, 104, 105 };
+		list.splice(list.begin(), other, other.begin()); // 1
+		list.splice(list.begin(), other, other.begin(), std::next(other.begin(), 3)); // 3
+		list.splice(list.begin(), other, other.begin(), other.end(), 2); // 2, counted by the caller
+		stats = list.stats();
+		MY_LIB_CHECK(stats.splices_ == 3 && stats.unsized_splices_ == 0);
+		MY_LIB_CHECK(stats.splice_sizes_.buckets_[1] == 1 && stats.splice_sizes_.buckets_[2] == 2);
+		list.splice(list.end(), list, list.begin(), std::next(list.begin(), 2)); // inside the list: the length is not counted
+		MY_LIB_CHECK(list.stats().unsized_splices_ == 1 && list.stats().splices_ == 4);
+
+		list.sort();
+		list.sort();
+		stats = list.stats();
+		MY_LIB_CHECK(stats.sorts_ == 2 && stats.sort_sizes_.buckets_[histogram::bucket_of(list.size())] == 2);
+		MY_LIB_CHECK(stats.max_sort_ns_ <= stats.sort_ns_);
+
+		list.reserve(30); // 22 elements, 8 spares
+		list.clear();
+		for (int i{}; i < 30; ++i) {
+			list.push_back(i);
+		}
+		stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 28 && stats.recycled_ == 30 && stats.frees_ == 4);
+
+		auto copy = list;
+		MY_LIB_CHECK(copy.stats().allocations_ == 30 && copy.stats().traversals_ == 0 && copy.stats().sorts_ == 0);
+		copy = list;
+		MY_LIB_CHECK(copy.stats().allocations_ == 30); // the nodes were reused, nothing new
+	}
+
+	// lazy_size range splices between lists, and the blocks of a node_pool batch
+	void unsized_and_batch()
+	{
+		stats_list<std::allocator<int>, my_lib::lazy_size> lhs{ 1, 2, 3 };
+		stats_list<std::allocator<int>, my_lib::lazy_size> rhs{ 4, 5, 6, 7 };
+		lhs.splice(lhs.end(), rhs, rhs.begin(), std::next(rhs.begin(), 2));
+		lhs.splice(lhs.end(), rhs); // rhs is stale now, unsized too
+		auto stats = lhs.stats();
+		MY_LIB_CHECK(stats.splices_ == 2 && stats.unsized_splices_ == 2 && stats.splice_sizes_.buckets_[0] == 0);
+		MY_LIB_CHECK(stats.to_json().find("\"splices\":2,\"unsized_splices\":2,\"splice_sizes\":[],") != std::string::npos);
+
+		my_lib::node_pool<int> pool;
+		stats_list<my_lib::node_pool<int>> pooled{ pool };
+		pooled.insert(pooled.end(), 100, 1);
+		pooled.push_back(2);
+		stats = pooled.stats();
+		MY_LIB_CHECK(stats.batch_allocations_ == 1 && stats.allocations_ == 101);
+		MY_LIB_CHECK(stats.to_json().find("{\"allocations\":101,\"batch_allocations\":1,") == 0);
+	}
+}
+
+int main()
+{
+	buckets();
+	known_operations();
+	more_operations();
+	unsized_and_batch();
+	return my_lib::tests::report("list_stats_test");
+}
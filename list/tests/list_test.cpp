@@ -0,0 +1,408 @@
+// list, small_list and intrusive_list against std::list: splice inside one list, assign after an unsized splice,
+// the spare nodes of reserve, node handles, compact
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. list_test.cpp -o list_test
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <list>
+#include <memory>
+#include <vector>
+#include "../list.hpp"
+#include "../list_stats.hpp"
+#include "../node_pool.hpp"
+#include "../small_list.hpp"
+#include "../intrusive_list.hpp"
+#include "check.hpp"
+
+namespace
+{
+	using lazy_list = my_lib::list<int, std::allocator<int>, my_lib::unchecked_iterators, my_lib::lazy_size>;
+	using stats_list = my_lib::list<int, std::allocator<int>, my_lib::unchecked_iterators, my_lib::eager_size, my_lib::collect_stats>;
+
+	struct item
+	{
+		int value;
+		my_lib::list_hook hook;
+
+		friend bool operator==(const item& lhs, const item& rhs) noexcept
+		{
+			return lhs.value == rhs.value;
+		}
+	};
+
+	using item_list = my_lib::intrusive_list<item, &item::hook>;
+
+	// the copy throws when the value is negative
+	struct picky
+	{
+		int value;
+
+		picky(int init) : value{ init } {}
+
+		picky(const picky& rhs) : value{ rhs.value }
+		{
+			if (value < 0) {
+				throw std::runtime_error{ "picky" };
+			}
+		}
+
+		picky& operator=(const picky&) = default;
+	};
+
+	using picky_list = my_lib::list<picky, std::allocator<picky>, my_lib::unchecked_iterators, my_lib::eager_size, my_lib::collect_stats>;
+
+	// long enough to live on the heap, so a node handle that leaks or frees twice shows up under ASan
+	using pooled_strings = my_lib::list<std::string, my_lib::node_pool<std::string>, my_lib::checked_iterators>;
+
+	std::string long_string(int number)
+	{
+		return std::string(32, 'a' + number % 26) + std::to_string(number);
+	}
+
+	template <class Fn>
+	bool throws(Fn fn)
+	{
+		try {
+			fn();
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+
+	// splice(pos, *this, first, last) for every first <= last and pos outside [first, last), pos == last included
+	template <class List>
+	void self_splice_ranges()
+	{
+		constexpr int size{ 6 };
+		for (int first{}; first <= size; ++first) {
+			for (int last{ first }; last <= size; ++last) {
+				for (int pos{}; pos <= size; ++pos) {
+					if (pos >= first && pos < last) continue;
+
+					List list{ 0, 1, 2, 3, 4, 5 };
+					std::list<int> expected{ 0, 1, 2, 3, 4, 5 };
+					list.splice(std::next(list.begin(), pos), list, std::next(list.begin(), first), std::next(list.begin(), last));
+					expected.splice(std::next(expected.begin(), pos), expected,
+						std::next(expected.begin(), first), std::next(expected.begin(), last));
+					MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+					MY_LIB_CHECK(list.size() == expected.size());
+				}
+			}
+		}
+	}
+
+	void self_splice_intrusive()
+	{
+		constexpr int size{ 6 };
+		for (int first{}; first <= size; ++first) {
+			for (int last{ first }; last <= size; ++last) {
+				for (int pos{}; pos <= size; ++pos) {
+					if (pos >= first && pos < last) continue;
+
+					std::vector<item> items(size);
+					item_list list;
+					for (int i{}; i < size; ++i) {
+						items[i].value = i;
+						list.push_back(items[i]);
+					}
+					std::list<item> expected(items.begin(), items.end());
+					list.splice(std::next(list.begin(), pos), list, std::next(list.begin(), first), std::next(list.begin(), last));
+					expected.splice(std::next(expected.begin(), pos), expected,
+						std::next(expected.begin(), first), std::next(expected.begin(), last));
+					MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+					MY_LIB_CHECK(list.size() == expected.size());
+					list.clear();
+				}
+			}
+
+			// one element before itself or its successor
+			std::vector<item> items(size);
+			item_list list;
+			for (int i{}; i < size; ++i) {
+				items[i].value = i;
+				list.push_back(items[i]);
+			}
+			if (first < size) {
+				auto it = std::next(list.begin(), first);
+				list.splice(it, list, it);
+				list.splice(std::next(it), list, it);
+				MY_LIB_CHECK(my_lib::tests::same_elements(list, std::vector<item>(items.begin(), items.end())));
+			}
+			list.clear();
+		}
+	}
+
+	// the unsized splice leaves size_ stale in both lists, assign has to count before it grows or shrinks
+	void assign_after_unsized_splice()
+	{
+		std::vector<int> longer{ 9, 8, 7, 6, 5, 4, 3, 2 };
+		std::vector<int> shorter{ 1, 2 };
+
+		lazy_list lhs{ 1, 2, 3 };
+		lazy_list rhs{ 4, 5, 6, 7 };
+		lhs.splice(lhs.end(), rhs, std::next(rhs.begin()), rhs.end());
+		lhs.assign(longer.begin(), longer.end());
+		rhs.assign(longer.begin(), longer.end());
+		MY_LIB_CHECK(my_lib::tests::same_elements(lhs, longer) && lhs.size() == longer.size());
+		MY_LIB_CHECK(my_lib::tests::same_elements(rhs, longer) && rhs.size() == longer.size());
+
+		lhs.splice(lhs.begin(), rhs, rhs.begin(), std::next(rhs.begin(), 6));
+		lhs.assign(shorter.begin(), shorter.end());
+		rhs.assign(shorter.begin(), shorter.end());
+		MY_LIB_CHECK(my_lib::tests::same_elements(lhs, shorter) && lhs.size() == shorter.size());
+		MY_LIB_CHECK(my_lib::tests::same_elements(rhs, shorter) && rhs.size() == shorter.size());
+	}
+
+	// clear, erase, pop and remove leave the nodes on the spares, so refilling allocates nothing
+	void refill_after_reserve()
+	{
+		stats_list list;
+		list.reserve(100);
+		MY_LIB_CHECK(list.stats().allocations_ == 100);
+		for (int round{}; round < 5; ++round) {
+			for (int i{}; i < 60; ++i) {
+				list.push_back(i);
+			}
+			list.insert(list.begin(), 30, 7);
+			list.emplace_front(1);
+			list.resize(100, 2);
+			MY_LIB_CHECK(list.size() == 100);
+			list.pop_front();
+			list.pop_back();
+			list.remove(7);
+			list.erase(list.begin(), std::next(list.begin(), 10));
+			list.clear();
+		}
+		auto stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 100 && stats.frees_ == 0 && stats.recycled_ == 5 * 100);
+
+		// not capped at the reserved count: the spares grow to the largest size reached
+		list.assign(150, 3);
+		list.clear();
+		list.assign(150, 4);
+		stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 150 && stats.frees_ == 0);
+
+		list.clear();
+		list.shrink_to_fit();
+		MY_LIB_CHECK(list.stats().frees_ == 150);
+		list.push_back(1);
+		list.pop_back(); // freed again, no spares any more
+		stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 151 && stats.frees_ == 151);
+	}
+
+	// a node taken from the spares goes back there when the value throws
+	void spares_kept_on_throw()
+	{
+		picky_list list;
+		list.reserve(10);
+		picky bad{ -1 };
+		std::vector<picky> some_bad(5, picky{ 1 });
+		some_bad[3].value = -1;
+		MY_LIB_CHECK(throws([&] { list.push_back(bad); }));
+		MY_LIB_CHECK(throws([&] { list.insert(list.end(), 3, bad); }));
+		MY_LIB_CHECK(throws([&] { list.insert(list.end(), some_bad.begin(), some_bad.end()); }));
+		MY_LIB_CHECK(list.empty());
+		for (int i{}; i < 10; ++i) {
+			list.push_back(picky{ i });
+		}
+		auto stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ == 10 && stats.frees_ == 0);
+
+		// without reserve the node is freed
+		picky_list plain;
+		MY_LIB_CHECK(throws([&] { plain.push_back(bad); }));
+		stats = plain.stats();
+		MY_LIB_CHECK(stats.allocations_ == 1 && stats.frees_ == 1);
+	}
+
+	// extract / insert between two lists of one pool: the node and the value stay where they are
+	void node_handles()
+	{
+		my_lib::node_pool<std::string> pool;
+		pooled_strings lhs{ pool };
+		pooled_strings rhs{ pool };
+		for (int i{}; i < 5; ++i) {
+			lhs.push_back(long_string(i));
+			rhs.push_back(long_string(10 + i));
+		}
+		MY_LIB_CHECK(pool.live() == 10);
+
+		auto pos = std::next(lhs.begin(), 2);
+		auto* address = std::addressof(*pos);
+		auto handle = lhs.extract(pos);
+		MY_LIB_CHECK(!handle.empty() && handle && handle.value() == long_string(2));
+		MY_LIB_CHECK(std::addressof(handle.value()) == address);
+		MY_LIB_CHECK(handle.get_allocator() == pool);
+		MY_LIB_CHECK(lhs.size() == 4 && pool.live() == 10);
+
+		// moved to another handle, then into the other list
+		pooled_strings::node_type moved{ std::move(handle) };
+		MY_LIB_CHECK(handle.empty() && !handle && moved);
+		auto it = rhs.insert(std::next(rhs.begin()), std::move(moved));
+		MY_LIB_CHECK(moved.empty());
+		MY_LIB_CHECK(std::addressof(*it) == address && it == std::next(rhs.begin()));
+		MY_LIB_CHECK(my_lib::tests::same_elements(rhs, std::vector<std::string>{ long_string(10), long_string(2), long_string(11),
+			long_string(12), long_string(13), long_string(14) }));
+		MY_LIB_CHECK(rhs.size() == 6 && pool.live() == 10);
+
+		// back into the first list, at both ends
+		rhs.erase(rhs.begin()); // it is still valid
+		lhs.push_front(rhs.extract(it));
+		lhs.push_back(rhs.extract(rhs.begin()));
+		MY_LIB_CHECK(std::addressof(lhs.front()) == address);
+		MY_LIB_CHECK(my_lib::tests::same_elements(lhs, std::vector<std::string>{ long_string(2), long_string(0), long_string(1),
+			long_string(3), long_string(4), long_string(11) }));
+		MY_LIB_CHECK(lhs.size() == 6 && rhs.size() == 3 && pool.live() == 9);
+
+		// an empty handle inserts nothing
+		pooled_strings::node_type empty;
+		MY_LIB_CHECK(empty.empty());
+		MY_LIB_CHECK(lhs.insert(lhs.begin(), std::move(empty)) == lhs.end());
+		lhs.push_back(std::move(empty));
+		lhs.push_front(pooled_strings::node_type{});
+		MY_LIB_CHECK(lhs.size() == 6 && pool.live() == 9);
+
+		// a handle destroys its element, also when it is assigned or swapped away
+		{
+			auto first = lhs.extract(lhs.begin());
+			auto second = lhs.extract(lhs.begin());
+			swap(first, second);
+			MY_LIB_CHECK(first.value() == long_string(0) && second.value() == long_string(2));
+			first = std::move(second);
+			MY_LIB_CHECK(second.empty() && first.value() == long_string(2));
+			MY_LIB_CHECK(pool.live() == 8);
+			first.swap(empty);
+			MY_LIB_CHECK(first.empty() && empty.value() == long_string(2));
+		}
+		MY_LIB_CHECK(pool.live() == 8);
+		empty = pooled_strings::node_type{};
+		MY_LIB_CHECK(pool.live() == 7 && lhs.size() == 4);
+		(void)rhs.extract(rhs.begin());
+		MY_LIB_CHECK(pool.live() == 6 && rhs.size() == 2);
+	}
+
+	// a pooled list scattered by sort and erase, the other list is the expected one
+	pooled_strings scattered_list(const my_lib::node_pool<std::string>& pool, std::vector<std::string>& expected)
+	{
+		pooled_strings list{ pool };
+		for (int i{}; i < 200; ++i) {
+			list.push_back(long_string(i * 37 % 200));
+		}
+		list.sort();
+		list.remove_if([](const std::string& value) { return value.back() == '3'; });
+		expected.assign(list.begin(), list.end());
+		return list;
+	}
+
+	// compact(first, budget) in steps over the whole list and once in the middle: the values, the size and the
+	// returned iterator are kept, the relocated nodes are in address order
+	void compact_steps()
+	{
+		for (std::size_t budget : { 1, 7, 180, 1'000 }) {
+			my_lib::node_pool<std::string> pool;
+			std::vector<std::string> expected;
+			auto list = scattered_list(pool, expected);
+			auto live = pool.live();
+
+			std::size_t done{};
+			for (auto it = list.begin(); it != list.end(); ) {
+				auto next = list.compact(it, budget);
+				done += std::min(budget, expected.size() - done);
+				MY_LIB_CHECK(next == std::next(list.begin(), static_cast<std::ptrdiff_t>(done)));
+				MY_LIB_CHECK(list.size() == expected.size() && pool.live() == live);
+				it = next;
+			}
+			MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+			MY_LIB_CHECK(list.compact(list.end(), budget) == list.end());
+			if (budget >= expected.size()) {
+				MY_LIB_CHECK(std::is_sorted(list.begin(), list.end(), [](const std::string& lhs, const std::string& rhs) {
+					return std::addressof(lhs) < std::addressof(rhs);
+				}));
+			}
+
+			// in the middle, the nodes before and after the range are not touched
+			auto before = std::next(list.begin(), 10);
+			auto count = std::min(budget, expected.size() - 11);
+			auto after = std::next(before, static_cast<std::ptrdiff_t>(count + 1)); // end() for the big budgets
+			auto* after_address = after == list.end() ? nullptr : std::addressof(*after);
+			auto next = list.compact(std::next(before), budget);
+			MY_LIB_CHECK(next == after && std::next(before) != after && *before == expected[10]);
+			MY_LIB_CHECK(after == list.end() || std::addressof(*after) == after_address);
+			MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+			MY_LIB_CHECK(list.compact(list.begin(), 0) == list.begin());
+		}
+
+		pooled_strings empty;
+		empty.compact();
+		MY_LIB_CHECK(empty.compact(empty.end(), 7) == empty.end() && empty.empty());
+	}
+
+	// compact() keeps the spares of a recycling list and does not recycle the old nodes
+	void compact_recycling()
+	{
+		stats_list list;
+		list.reserve(150);
+		for (int i{}; i < 100; ++i) {
+			list.push_back(i * 7 % 100);
+		}
+		list.sort();
+		list.remove_if([](int value) { return value % 3 == 0; });
+		std::vector<int> expected(list.begin(), list.end());
+		auto before = list.stats();
+
+		list.compact();
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, expected) && list.size() == expected.size());
+		for (auto it = list.begin(); it != list.end(); ) {
+			it = list.compact(it, 7);
+		}
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, expected) && list.size() == expected.size());
+		auto stats = list.stats();
+		MY_LIB_CHECK(stats.allocations_ - before.allocations_ == 2 * expected.size());
+		MY_LIB_CHECK(stats.frees_ - before.frees_ == 2 * expected.size());
+
+		// the 150 reserved nodes are still there
+		list.assign(150, 1);
+		MY_LIB_CHECK(list.stats().allocations_ == stats.allocations_);
+	}
+
+	// refill_after_reserve counted in the pool
+	void refill_after_reserve_pooled()
+	{
+		my_lib::node_pool<int> pool;
+		my_lib::list<int, my_lib::node_pool<int>> list{ pool };
+		list.reserve(100);
+		MY_LIB_CHECK(pool.live() == 100);
+		for (int round{}; round < 5; ++round) {
+			list.assign(100, round);
+			list.clear();
+			MY_LIB_CHECK(pool.live() == 100);
+		}
+		list.reserve(10); // fewer than the spares, none is freed
+		MY_LIB_CHECK(pool.live() == 100);
+		list.shrink_to_fit();
+		MY_LIB_CHECK(pool.live() == 0);
+	}
+}
+
+int main()
+{
+	self_splice_ranges<my_lib::list<int>>();
+	self_splice_ranges<lazy_list>();
+	self_splice_ranges<my_lib::small_list<int, 4>>();
+	self_splice_intrusive();
+	assign_after_unsized_splice();
+	refill_after_reserve();
+	refill_after_reserve_pooled();
+	spares_kept_on_throw();
+	node_handles();
+	compact_steps();
+	compact_recycling();
+	return my_lib::tests::report("list_test");
+}
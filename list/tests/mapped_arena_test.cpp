@@ -0,0 +1,139 @@
+// mapped_arena: a list built in the file is reopened at another address, corrupt and full files are refused
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. mapped_arena_test.cpp -o mapped_arena_test
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../list.hpp"
+#include "../mapped_arena.hpp"
+#include "check.hpp"
+
+namespace
+{
+	using allocator_type = my_lib::mapped_arena_allocator<int>;
+
+	template <class Checking>
+	using arena_list = my_lib::list<int, allocator_type, Checking>;
+
+	template <class Fn>
+	bool throws(Fn fn)
+	{
+		try {
+			fn();
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+
+	// Built in one mapping, read and changed in a second one that a decoy arena pushes to another address
+	template <class Checking>
+	void reopen_elsewhere(const std::string& path)
+	{
+		using list_type = arena_list<Checking>;
+		std::remove(path.c_str());
+		std::vector<int> expected;
+		const void* first_address{};
+		{
+			my_lib::mapped_arena arena{ path, 64 << 20 };
+			MY_LIB_CHECK(arena.created());
+			first_address = arena.header();
+			auto& list = arena.find_or_construct<list_type>(allocator_type{ arena });
+			std::mt19937 gen{ 2021 };
+			for (int i{}; i < 100'000; ++i) {
+				list.push_back(static_cast<int>(gen() % 1'000));
+			}
+			list.sort();
+			list.unique();
+			list.insert(list.begin(), 50, 7);
+			list.remove(13);
+			list_type other{ allocator_type{ arena } };
+			other.assign(list.begin(), list.end());
+			list.splice(list.end(), other);
+			list.reverse();
+			list.compact();
+			list.reserve(list.size() + 10);
+			list.pop_front();
+			list.erase(list.begin(), std::next(list.begin(), 100));
+			MY_LIB_CHECK(other.empty());
+			expected.assign(list.begin(), list.end());
+		}
+		{
+			my_lib::mapped_arena decoy{ path + ".decoy", 64 << 20 };
+			my_lib::mapped_arena arena{ path, 1 };
+			MY_LIB_CHECK(!arena.created());
+			MY_LIB_CHECK(arena.header() != first_address);
+			auto& list = arena.find_or_construct<list_type>(allocator_type{ arena });
+			MY_LIB_CHECK(list.size() == expected.size());
+			MY_LIB_CHECK(my_lib::tests::same_elements(list, expected));
+
+			// spares and free lists found in the file are reused
+			auto used = arena.used();
+			for (int i{}; i < 1'000; ++i) {
+				list.push_back(i);
+				list.pop_front();
+			}
+			MY_LIB_CHECK(arena.used() == used);
+			list.clear();
+			list.shrink_to_fit();
+			MY_LIB_CHECK(arena.live() == 1); // only the list itself
+			for (int i{}; i < 10; ++i) {
+				list.push_back(i);
+			}
+			MY_LIB_CHECK(arena.used() == used);
+
+			MY_LIB_CHECK(throws([&arena] { (void)arena.find_or_construct<double>(); })); // the root has another type
+			MY_LIB_CHECK(throws([&path] { my_lib::mapped_arena again{ path, 1 }; })); // still open
+		}
+		{
+			my_lib::mapped_arena arena{ path, 1 };
+			auto& list = arena.find_or_construct<list_type>(allocator_type{ arena });
+			MY_LIB_CHECK(list.size() == 10 && list.front() == 0 && list.back() == 9);
+			list.~list_type();
+			MY_LIB_CHECK(arena.live() == 1);
+		}
+		std::remove((path + ".decoy").c_str());
+		std::remove(path.c_str());
+	}
+
+	void refused_files()
+	{
+		std::string path{ "mapped_arena_test_garbage.arena" };
+		{
+			std::ofstream file{ path };
+			file << std::string(100'000, 'x');
+		}
+		MY_LIB_CHECK(throws([&path] { my_lib::mapped_arena arena{ path, 1 }; }));
+		std::remove(path.c_str());
+
+		// the file does not grow
+		path = "mapped_arena_test_small.arena";
+		bool full{};
+		try {
+			my_lib::mapped_arena arena{ path, 1 << 12 };
+			auto& list = arena.find_or_construct<arena_list<my_lib::unchecked_iterators>>(allocator_type{ arena });
+			for (;;) {
+				list.push_back(1);
+			}
+		}
+		catch (const std::bad_alloc&) {
+			full = true;
+		}
+		MY_LIB_CHECK(full);
+		std::remove(path.c_str());
+	}
+}
+
+int main()
+{
+	reopen_elsewhere<my_lib::checked_iterators>("mapped_arena_test_checked.arena");
+	reopen_elsewhere<my_lib::unchecked_iterators>("mapped_arena_test_unchecked.arena");
+	refused_files();
+	return my_lib::tests::report("mapped_arena_test");
+}
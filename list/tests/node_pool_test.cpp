@@ -0,0 +1,174 @@
+// node_pool: single and batch blocks, slabs kept until trim(), rebind and the pool of a copied list
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. node_pool_test.cpp -o node_pool_test
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+#include "../list.hpp"
+#include "../node_pool.hpp"
+#include "check.hpp"
+
+namespace
+{
+	using storage_type = my_lib::detail::pool_storage;
+
+	struct alignas(64) wide
+	{
+		char bytes[80];
+	};
+
+	template <class T>
+	bool aligned(const T* ptr)
+	{
+		return reinterpret_cast<std::uintptr_t>(ptr) % alignof(T) == 0;
+	}
+
+	// distinct aligned blocks, a freed block is the next one given, more slabs as it grows
+	template <class T>
+	void single_blocks()
+	{
+		my_lib::node_pool<T> pool;
+		std::vector<T*> blocks;
+		std::set<T*> distinct;
+		for (std::size_t i{}; i < 3 * storage_type::first_slab_blocks; ++i) {
+			auto block = pool.allocate(1);
+			MY_LIB_CHECK(aligned(block));
+			blocks.push_back(block);
+			distinct.insert(block);
+		}
+		MY_LIB_CHECK(distinct.size() == blocks.size() && pool.live() == blocks.size());
+		MY_LIB_CHECK(pool.slab_count() > 1);
+
+		auto* freed = blocks[7];
+		pool.deallocate(freed, 1);
+		MY_LIB_CHECK(pool.live() == blocks.size() - 1);
+		MY_LIB_CHECK(pool.allocate(1) == freed);
+
+		// other counts are not pooled
+		auto* many = pool.allocate(3);
+		MY_LIB_CHECK(pool.live() == blocks.size());
+		pool.deallocate(many, 3);
+
+		auto slabs = pool.slab_count();
+		for (auto* block : blocks) {
+			pool.deallocate(block, 1);
+		}
+		MY_LIB_CHECK(pool.live() == 0 && pool.slab_count() == slabs); // kept for the next fill
+		for (std::size_t i{}; i < blocks.size(); ++i) {
+			blocks[i] = pool.allocate(1);
+		}
+		MY_LIB_CHECK(pool.slab_count() == slabs);
+		for (auto* block : blocks) {
+			pool.deallocate(block, 1);
+		}
+	}
+
+	// count blocks in a row, freed one by one; the rest of a short slab is not lost
+	void batch_blocks()
+	{
+		my_lib::node_pool<double> pool;
+		auto* single = pool.allocate(1);
+		auto* batch = pool.allocate_batch(100);
+		MY_LIB_CHECK(batch != nullptr && pool.live() == 101);
+		for (std::size_t i{}; i < 100; ++i) {
+			batch[i] = static_cast<double>(i); // ASan checks the whole run is ours
+		}
+		MY_LIB_CHECK(pool.allocate_batch(0) == nullptr);
+
+		auto slabs = pool.slab_count();
+		std::vector<double*> rest;
+		for (std::size_t i{}; i + 1 < storage_type::first_slab_blocks; ++i) {
+			rest.push_back(pool.allocate(1)); // from the rest of the first slab, not a new one
+		}
+		MY_LIB_CHECK(pool.slab_count() == slabs);
+		pool.deallocate(single, 1);
+		for (std::size_t i{}; i < 100; ++i) {
+			pool.deallocate(batch + i, 1);
+		}
+		MY_LIB_CHECK(pool.live() == rest.size());
+
+		// a pool fixed to bigger blocks gives no batch of smaller ones, but single blocks
+		my_lib::node_pool<char> chars{ pool };
+		MY_LIB_CHECK(chars.allocate_batch(4) == nullptr);
+		auto* c = chars.allocate(1);
+		MY_LIB_CHECK(pool.live() == rest.size() + 1);
+		chars.deallocate(c, 1);
+		MY_LIB_CHECK(!pool.trim());
+		for (auto* block : rest) {
+			pool.deallocate(block, 1);
+		}
+		MY_LIB_CHECK(pool.trim());
+	}
+
+	void trim()
+	{
+		my_lib::node_pool<int> pool;
+		MY_LIB_CHECK(pool.trim() && pool.slab_count() == 0);
+		auto* first = pool.allocate(1);
+		auto* second = pool.allocate(1);
+		MY_LIB_CHECK(pool.slab_count() == 1);
+		pool.deallocate(first, 1);
+		MY_LIB_CHECK(!pool.trim() && pool.slab_count() == 1); // second is in use
+		pool.deallocate(second, 1);
+		MY_LIB_CHECK(pool.trim() && pool.slab_count() == 0 && pool.live() == 0);
+
+		// usable again after trim
+		auto* again = pool.allocate(1);
+		*again = 1;
+		MY_LIB_CHECK(pool.slab_count() == 1 && pool.live() == 1);
+		pool.deallocate(again, 1);
+		MY_LIB_CHECK(pool.trim());
+	}
+
+	// rebinds and copies share the pool, a copy constructed container gets a new one
+	void rebind_and_copies()
+	{
+		using traits = std::allocator_traits<my_lib::node_pool<int>>;
+		static_assert(std::is_same_v<traits::rebind_alloc<long>, my_lib::node_pool<long>>);
+		static_assert(!traits::propagate_on_container_copy_assignment::value);
+		static_assert(traits::propagate_on_container_move_assignment::value);
+
+		my_lib::node_pool<int> pool;
+		traits::rebind_alloc<long> longs{ pool };
+		my_lib::node_pool<int> back{ longs };
+		MY_LIB_CHECK(longs == pool && back == pool && !(back != pool));
+		auto* block = longs.allocate(1);
+		MY_LIB_CHECK(pool.live() == 1);
+		longs.deallocate(block, 1);
+		MY_LIB_CHECK(pool.live() == 0);
+
+		auto selected = traits::select_on_container_copy_construction(pool);
+		MY_LIB_CHECK(selected != pool);
+
+		// the longs fixed the block size of pool, the nodes need another one
+		pool = my_lib::node_pool<int>{};
+		my_lib::node_pool<int> copy{ pool };
+		MY_LIB_CHECK(copy == pool);
+		my_lib::list<int, my_lib::node_pool<int>> list{ pool };
+		for (int i{}; i < 50; ++i) {
+			list.push_back(i);
+		}
+		MY_LIB_CHECK(pool.live() == 50);
+		auto copied = list;
+		MY_LIB_CHECK(copied.get_allocator() != pool && copied.get_allocator().live() == 50);
+		MY_LIB_CHECK(copied == list && pool.live() == 50);
+
+		// copy assignment keeps the pool of the target
+		my_lib::list<int, my_lib::node_pool<int>> assigned{ copy };
+		assigned = copied;
+		MY_LIB_CHECK(assigned.get_allocator() == pool && pool.live() == 100);
+		copied.clear();
+		MY_LIB_CHECK(copied.get_allocator().live() == 0);
+	}
+}
+
+int main()
+{
+	single_blocks<int>();
+	single_blocks<wide>();
+	batch_blocks();
+	trim();
+	rebind_and_copies();
+	return my_lib::tests::report("node_pool_test");
+}
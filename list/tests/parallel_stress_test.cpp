@@ -0,0 +1,245 @@
+// parallel.hpp: my_lib::sort(policy, list, pred) against std::stable_sort over thread counts, the traversal algorithms
+// and list_segments against the serial ones (make tsan runs it under TSan)
+// g++ -std=c++17 -O1 -g -fsanitize=thread -pthread -I.. parallel_stress_test.cpp -o parallel_stress_test_tsan
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../list.hpp"
+#include "../parallel.hpp"
+#include "check.hpp"
+
+namespace
+{
+	// seq is the position before the sort, the sorts compare key only
+	struct record
+	{
+		int key;
+		int seq;
+
+		friend bool operator==(const record& lhs, const record& rhs) noexcept
+		{
+			return lhs.key == rhs.key && lhs.seq == rhs.seq;
+		}
+	};
+
+	using record_list = my_lib::list<record, std::allocator<record>, my_lib::checked_iterators>;
+	using int_list = my_lib::list<int, std::allocator<int>, my_lib::checked_iterators>;
+	using segments_type = my_lib::list_segments<int_list>;
+
+	bool by_key(const record& lhs, const record& rhs) noexcept
+	{
+		return lhs.key < rhs.key;
+	}
+
+	// few keys, so most elements have equal ones and stability shows
+	record_list make_records(std::size_t size, std::uint32_t seed)
+	{
+		std::mt19937 gen{ seed };
+		record_list list;
+		for (std::size_t i{}; i < size; ++i) {
+			list.push_back(record{ static_cast<int>(gen() % 100), static_cast<int>(i) });
+		}
+		return list;
+	}
+
+	// sorted like std::stable_sort, and every iterator taken before still points to its element
+	template <class Policy>
+	void sort_like_stable_sort(const Policy& policy, std::size_t size, std::uint32_t seed)
+	{
+		auto list = make_records(size, seed);
+		std::vector<record> expected(list.begin(), list.end());
+		std::stable_sort(expected.begin(), expected.end(), by_key);
+		std::vector<record_list::iterator> iterators;
+		for (auto it = list.begin(); it != list.end(); ++it) {
+			iterators.push_back(it);
+		}
+
+		my_lib::sort(policy, list, by_key);
+		MY_LIB_CHECK(my_lib::tests::same_elements(list, expected) && list.size() == size);
+		bool valid{ true };
+		for (std::size_t i{}; i < iterators.size(); ++i) {
+			valid = valid && iterators[i]->seq == static_cast<int>(i);
+		}
+		MY_LIB_CHECK(valid);
+	}
+
+	template <class Policy>
+	void sort_sizes(const Policy& policy)
+	{
+		// below and above the size that is worth a second thread
+		for (std::size_t size : { 0, 1, 2, 1'000, 40'000, 100'000 }) {
+			sort_like_stable_sort(policy, size, static_cast<std::uint32_t>(size));
+		}
+	}
+
+	// the default predicate, and one that throws on some thread: the list is not changed
+	void default_pred_and_throw()
+	{
+		std::mt19937 gen{ 7 };
+		my_lib::list<int> ints;
+		for (int i{}; i < 50'000; ++i) {
+			ints.push_back(static_cast<int>(gen() % 1'000));
+		}
+		std::vector<int> expected(ints.begin(), ints.end());
+		auto before = expected;
+		std::sort(expected.begin(), expected.end());
+
+		std::atomic<int> calls{};
+		bool thrown{};
+		try {
+			my_lib::sort(my_lib::execution::par(4), ints, [&calls](int lhs, int rhs) {
+				if (calls.fetch_add(1, std::memory_order_relaxed) == 100'000) {
+					throw std::runtime_error{ "pred" };
+				}
+				return lhs < rhs;
+			});
+		}
+		catch (const std::runtime_error&) {
+			thrown = true;
+		}
+		MY_LIB_CHECK(thrown && my_lib::tests::same_elements(ints, before));
+
+		my_lib::sort(my_lib::execution::par(4), ints);
+		MY_LIB_CHECK(my_lib::tests::same_elements(ints, expected));
+	}
+
+	int_list make_ints(int size)
+	{
+		int_list list;
+		for (int i{}; i < size; ++i) {
+			list.push_back(i);
+		}
+		return list;
+	}
+
+	// every element once, from every segment
+	template <class Policy, class... Segments>
+	bool each_once(const Policy& policy, const int_list& list, const Segments&... segments)
+	{
+		std::vector<std::atomic<int>> seen(list.size());
+		my_lib::for_each(policy, list, segments..., [&seen](int value) { seen[static_cast<std::size_t>(value)].fetch_add(1); });
+		return std::all_of(seen.begin(), seen.end(), [](const std::atomic<int>& count) { return count.load() == 1; });
+	}
+
+	// for_each, count_if and transform_reduce give what the serial ones give, with and without segments
+	template <class Policy, class... Segments>
+	void scans_like_serial(const Policy& policy, const int_list& list, const Segments&... segments)
+	{
+		auto third = [](int value) { return value % 3 == 0; };
+		auto square = [](int value) { return static_cast<long long>(value) * value; };
+		MY_LIB_CHECK(each_once(policy, list, segments...));
+		MY_LIB_CHECK(my_lib::count_if(policy, list, segments..., third) == static_cast<std::size_t>(std::count_if(list.begin(), list.end(), third)));
+		MY_LIB_CHECK(my_lib::transform_reduce(policy, list, segments..., 5LL, std::plus<>{}, square)
+			== std::transform_reduce(list.begin(), list.end(), 5LL, std::plus<>{}, square));
+	}
+
+	void traversals(std::size_t threads)
+	{
+		my_lib::execution::parallel_policy policy{ threads };
+		for (int size : { 0, 1, 5, 1'000 }) {
+			auto list = make_ints(size);
+			scans_like_serial(policy, list);
+			for (std::size_t count : { 1, 3, 7, 64 }) {
+				scans_like_serial(policy, list, segments_type{ list, count });
+			}
+		}
+		// long enough to be cut without segments given
+		auto list = make_ints(100'000);
+		scans_like_serial(policy, list);
+		scans_like_serial(my_lib::execution::seq, list);
+#ifdef __cpp_lib_execution
+		scans_like_serial(std::execution::par, list);
+#endif
+	}
+
+	// the first match in list order: around the segment bounds, with more matches after it in the same and in later
+	// segments, and none
+	void find_first(std::size_t threads)
+	{
+		my_lib::execution::parallel_policy policy{ threads };
+		constexpr int size{ 1'000 };
+		auto list = make_ints(size);
+		const auto& const_list = list;
+		for (std::size_t count : { 1, 2, 7, 64 }) {
+			segments_type segments{ list, count };
+			for (std::size_t bound{}; bound <= count; ++bound) {
+				auto at = static_cast<int>(size * bound / count);
+				for (auto first : { at - 1, at, at + 1 }) {
+					if (first < 0 || first >= size) continue;
+					auto from = [first](int value) { return value >= first; };
+					auto two = [first](int value) { return value == first || value == (first + size / 2) % size; };
+					auto first_of_two = std::min(first, (first + size / 2) % size);
+					auto it = my_lib::find_if(policy, list, segments, from);
+					MY_LIB_CHECK(it != list.end() && *it == first && it == std::next(list.begin(), first));
+					MY_LIB_CHECK(*my_lib::find_if(policy, const_list, segments, two) == first_of_two);
+					MY_LIB_CHECK(*my_lib::find_if(policy, list, from) == first);
+				}
+			}
+			MY_LIB_CHECK(my_lib::find_if(policy, list, segments, [](int value) { return value < 0; }) == list.end());
+			MY_LIB_CHECK(my_lib::find_if(policy, const_list, segments, [](int) { return true; }) == const_list.begin());
+		}
+
+		auto big = make_ints(100'000);
+		for (int first : { 0, 16'383, 16'384, 50'000, 99'999 }) {
+			MY_LIB_CHECK(*my_lib::find_if(policy, big, [first](int value) { return value >= first; }) == first);
+		}
+		MY_LIB_CHECK(my_lib::find_if(policy, big, [](int value) { return value < 0; }) == big.end());
+
+		int_list empty;
+		segments_type empty_segments{ empty, 4 };
+		MY_LIB_CHECK(my_lib::find_if(policy, empty, [](int) { return true; }) == empty.end());
+		MY_LIB_CHECK(my_lib::find_if(policy, empty, empty_segments, [](int) { return true; }) == empty.end());
+		MY_LIB_CHECK(my_lib::find_if(policy, std::as_const(empty), empty_segments, [](int) { return true; }) == empty.cend());
+	}
+
+	void segments()
+	{
+		segments_type none;
+		MY_LIB_CHECK(none.count() == 0 && none.nodes() == 0);
+
+		auto list = make_ints(10);
+		auto other = make_ints(10);
+		for (std::size_t count : { 0, 1, 3, 10, 11, 100 }) {
+			segments_type segments{ list, count };
+			MY_LIB_CHECK(segments.count() == std::max<std::size_t>(1, std::min<std::size_t>(count, 10)));
+			MY_LIB_CHECK(segments.nodes() == 10 && segments.fits(list) && !segments.fits(other));
+		}
+		segments_type segments{ list, 3 };
+		list.push_back(10);
+		MY_LIB_CHECK(!segments.fits(list)); // stale
+		segments = segments_type{ list, 3 };
+		MY_LIB_CHECK(segments.fits(list) && segments.nodes() == 11);
+
+		int_list empty;
+		segments_type empty_segments{ empty, 4 };
+		MY_LIB_CHECK(empty_segments.count() == 1 && empty_segments.nodes() == 0 && empty_segments.fits(empty));
+	}
+}
+
+int main()
+{
+	sort_sizes(my_lib::execution::seq);
+	sort_sizes(my_lib::execution::par);
+	for (std::size_t threads{ 1 }; threads <= 8; ++threads) {
+		sort_like_stable_sort(my_lib::execution::par(threads), 100'000, static_cast<std::uint32_t>(threads));
+	}
+#ifdef __cpp_lib_execution
+	sort_sizes(std::execution::seq);
+	sort_sizes(std::execution::par);
+#endif
+	default_pred_and_throw();
+	for (std::size_t threads{ 1 }; threads <= 4; ++threads) {
+		traversals(threads);
+		find_first(threads);
+	}
+	segments();
+	return my_lib::tests::report("parallel_stress_test");
+}
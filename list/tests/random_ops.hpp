@@ -0,0 +1,299 @@
+#pragma once
+#ifndef MY_LIB_TESTS_RANDOM_OPS
+#define MY_LIB_TESTS_RANDOM_OPS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+
+namespace my_lib::tests
+{
+	/*
+	 * Structure of this file:
+	 * heap_int
+	 * random_operations
+	 *
+	 * random_operations runs the same random calls on two lists of the tested type and on two std::lists
+	 * and compares them after every step. Values are small, so remove and unique find something, and sort / merge
+	 * compare key_of(value) / 4 only, so their stability is checked too. The value type is int or heap_int.
+	 * check(list, model) is called after every step for the invariants of the tested type.
+	 */
+
+	inline int key_of(int value) noexcept
+	{
+		return value;
+	}
+
+	// An int on the heap: a lost, doubled or skipped destructor shows up under ASan
+	class heap_int
+	{
+		std::unique_ptr<int> value_;
+
+		// Ctors
+	public:
+		heap_int() : value_{ std::make_unique<int>() } {}
+
+		heap_int(int value) : value_{ std::make_unique<int>(value) } {}
+
+		heap_int(const heap_int& rhs) : value_{ std::make_unique<int>(*rhs.value_) } {}
+
+		heap_int(heap_int&& rhs) noexcept = default;
+
+		heap_int& operator=(const heap_int& rhs)
+		{
+			value_ = std::make_unique<int>(*rhs.value_); // this may be moved from
+			return *this;
+		}
+
+		heap_int& operator=(heap_int&& rhs) noexcept = default;
+
+		// Observers
+	public:
+		friend int key_of(const heap_int& value) noexcept
+		{
+			return *value.value_;
+		}
+
+		friend bool operator==(const heap_int& lhs, const heap_int& rhs) noexcept
+		{
+			return *lhs.value_ == *rhs.value_;
+		}
+
+		friend bool operator<(const heap_int& lhs, const heap_int& rhs) noexcept
+		{
+			return *lhs.value_ < *rhs.value_;
+		}
+	};
+
+	template <class List, class Check>
+	void random_operations(std::uint32_t seed, int steps, Check check)
+	{
+		using value_type = typename List::value_type;
+		using model_type = std::list<value_type>;
+
+		std::mt19937 gen{ seed };
+		auto draw = [&gen](std::size_t bound) { return static_cast<std::size_t>(gen() % (bound + 1)); }; // [0, bound]
+		auto value = [&] { return value_type{ static_cast<int>(draw(15)) }; };
+		auto coarse = [](const value_type& lhs, const value_type& rhs) { return key_of(lhs) / 4 < key_of(rhs) / 4; };
+
+		List lists[2];
+		model_type models[2];
+
+		for (int step{}; step < steps; ++step) {
+			auto side = draw(1);
+			auto& list = lists[side];
+			auto& model = models[side];
+			auto& other = lists[1 - side];
+			auto& other_model = models[1 - side];
+			auto size = model.size();
+			// lists longer than 64 mostly shrink
+			auto op = size > 64 && draw(1) == 0 ? 8 + draw(1) : draw(26);
+			auto pos = draw(size);
+			auto at = std::next(list.begin(), pos);
+			auto model_at = std::next(model.begin(), pos);
+
+			switch (op) {
+			case 0: {
+				auto v = value();
+				list.push_back(v);
+				model.push_back(v);
+				break;
+			}
+			case 1: {
+				auto v = value();
+				list.push_front(v);
+				model.push_front(v);
+				break;
+			}
+			case 2:
+				if (size != 0) {
+					list.pop_back();
+					model.pop_back();
+				}
+				break;
+			case 3:
+				if (size != 0) {
+					list.pop_front();
+					model.pop_front();
+				}
+				break;
+			case 4: {
+				auto v = value();
+				auto it = list.insert(at, v);
+				model.insert(model_at, v);
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.begin(), it)) == pos);
+				break;
+			}
+			case 5: {
+				auto count = draw(9);
+				auto v = value();
+				auto it = list.insert(at, count, v);
+				model.insert(model_at, count, v);
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.begin(), it)) == pos);
+				break;
+			}
+			case 6: {
+				std::vector<value_type> values(draw(20));
+				for (auto& v : values) {
+					v = value();
+				}
+				auto it = list.insert(at, values.begin(), values.end());
+				model.insert(model_at, values.begin(), values.end());
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.begin(), it)) == pos);
+				break;
+			}
+			case 7: {
+				auto v = value();
+				auto it = list.emplace(at, v);
+				model.emplace(model_at, v);
+				MY_LIB_CHECK(*it == v);
+				break;
+			}
+			case 8:
+				if (pos != size) {
+					auto it = list.erase(at);
+					model.erase(model_at);
+					MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.begin(), it)) == pos);
+				}
+				break;
+			case 9: {
+				auto last = pos + draw(size - pos);
+				auto it = list.erase(at, std::next(list.begin(), last));
+				model.erase(model_at, std::next(model.begin(), last));
+				MY_LIB_CHECK(static_cast<std::size_t>(std::distance(list.begin(), it)) == pos);
+				break;
+			}
+			case 10: {
+				auto new_size = draw(size + 10);
+				list.resize(new_size);
+				model.resize(new_size);
+				break;
+			}
+			case 11: {
+				auto new_size = draw(size + 10);
+				auto v = value();
+				list.resize(new_size, v);
+				model.resize(new_size, v);
+				break;
+			}
+			case 12:
+				list.splice(at, other);
+				model.splice(model_at, other_model);
+				break;
+			case 13:
+				if (!other_model.empty()) {
+					auto from = draw(other_model.size() - 1);
+					list.splice(at, other, std::next(other.begin(), from));
+					model.splice(model_at, other_model, std::next(other_model.begin(), from));
+				}
+				break;
+			case 14: {
+				auto first = draw(other_model.size());
+				auto last = first + draw(other_model.size() - first);
+				list.splice(at, other, std::next(other.begin(), first), std::next(other.begin(), last));
+				model.splice(model_at, other_model, std::next(other_model.begin(), first), std::next(other_model.begin(), last));
+				break;
+			}
+			case 15: {
+				// a range of the list itself, pos is not inside it
+				auto first = draw(size);
+				auto last = first + draw(size - first);
+				if (pos >= first && pos < last) {
+					pos = last;
+				}
+				list.splice(std::next(list.begin(), pos), list, std::next(list.begin(), first), std::next(list.begin(), last));
+				model.splice(std::next(model.begin(), pos), model, std::next(model.begin(), first), std::next(model.begin(), last));
+				break;
+			}
+			case 16: {
+				auto v = value();
+				list.remove(v);
+				model.remove(v);
+				break;
+			}
+			case 17: {
+				auto v = value();
+				list.remove_if([&v](const value_type& elem) { return elem < v; });
+				model.remove_if([&v](const value_type& elem) { return elem < v; });
+				break;
+			}
+			case 18:
+				list.unique();
+				model.unique();
+				break;
+			case 19:
+				list.sort(coarse);
+				model.sort(coarse);
+				break;
+			case 20:
+				list.sort(coarse);
+				model.sort(coarse);
+				other.sort(coarse);
+				other_model.sort(coarse);
+				list.merge(other, coarse);
+				model.merge(other_model, coarse);
+				break;
+			case 21:
+				list.reverse();
+				model.reverse();
+				break;
+			case 22: {
+				std::vector<value_type> values(draw(40));
+				for (auto& v : values) {
+					v = value();
+				}
+				list.assign(values.begin(), values.end());
+				model.assign(values.begin(), values.end());
+				break;
+			}
+			case 23:
+				list = other;
+				model = other_model;
+				MY_LIB_CHECK(list == other);
+				break;
+			case 24: {
+				List copy{ other };
+				list = std::move(copy);
+				model = other_model;
+				break;
+			}
+			case 25:
+				list.swap(other);
+				model.swap(other_model);
+				break;
+			default:
+				if (draw(3) == 0) {
+					list.clear();
+					model.clear();
+				}
+				break;
+			}
+
+			for (std::size_t i{}; i < 2; ++i) {
+				MY_LIB_CHECK(lists[i].size() == models[i].size());
+				MY_LIB_CHECK(lists[i].empty() == models[i].empty());
+				MY_LIB_CHECK(same_elements(lists[i], models[i]));
+				check(lists[i], models[i]);
+			}
+			if (failures != 0) {
+				std::fprintf(stderr, "seed %u, step %d, operation %zu\n", seed, step, op);
+				return;
+			}
+		}
+	}
+
+	template <class List>
+	void random_operations(std::uint32_t seed, int steps)
+	{
+		random_operations<List>(seed, steps, [](const List&, const std::list<typename List::value_type>&) {});
+	}
+}
+
+#endif
@@ -0,0 +1,164 @@
+// serialize / deserialize: round trips of raw values and of serializer<std::string>, and the streams that are refused
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. serialize_test.cpp -o serialize_test
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../list.hpp"
+#include "../node_pool.hpp"
+#include "../serialize.hpp"
+#include "check.hpp"
+
+namespace
+{
+	using my_lib::tests::same_elements;
+	using header_type = my_lib::detail::stream_header;
+
+	struct point
+	{
+		double x;
+		double y;
+
+		friend bool operator==(const point& lhs, const point& rhs) noexcept
+		{
+			return lhs.x == rhs.x && lhs.y == rhs.y;
+		}
+	};
+
+	template <class List>
+	std::string write(const List& list)
+	{
+		std::ostringstream out;
+		my_lib::serialize(list, out);
+		return out.str();
+	}
+
+	template <class List>
+	List read(const std::string& bytes)
+	{
+		std::istringstream in{ bytes };
+		return my_lib::deserialize<List>(in);
+	}
+
+	// deserialize throws std::runtime_error
+	template <class List>
+	bool refused(const std::string& bytes)
+	{
+		try {
+			(void)read<List>(bytes);
+		}
+		catch (const std::runtime_error&) {
+			return true;
+		}
+		return false;
+	}
+
+	template <class Field>
+	void patch(std::string& bytes, std::size_t offset, Field value)
+	{
+		std::memcpy(bytes.data() + offset, &value, sizeof(value));
+	}
+
+	// more than one 64 KiB chunk, read back into a list with another allocator too
+	void raw_round_trip()
+	{
+		my_lib::list<int> ints;
+		for (int i{}; i < 50'000; ++i) {
+			ints.push_back(i * 7 - 1'000);
+		}
+		auto bytes = write(ints);
+		MY_LIB_CHECK(bytes.size() > 3 * header_type::raw_chunk_bytes);
+		auto copy = read<my_lib::list<int>>(bytes);
+		MY_LIB_CHECK(copy == ints);
+		auto pooled = read<my_lib::list<int, my_lib::node_pool<int>>>(bytes);
+		MY_LIB_CHECK(same_elements(pooled, std::vector<int>(ints.begin(), ints.end())));
+
+		my_lib::list<point> points;
+		for (int i{}; i < 10'000; ++i) {
+			points.push_back(point{ i * 0.5, -i * 0.25 });
+		}
+		MY_LIB_CHECK(read<my_lib::list<point>>(write(points)) == points);
+	}
+
+	// several chunks of serializer<T>::chunk_elements, strings up to a few KiB
+	void string_round_trip()
+	{
+		my_lib::list<std::string> strings;
+		for (int i{}; i < 10'000; ++i) {
+			strings.push_back(std::string(static_cast<std::size_t>(i % 5'000), static_cast<char>('a' + i % 26)));
+		}
+		strings.push_back(std::string{ "with\0zero", 9 });
+		MY_LIB_CHECK(read<my_lib::list<std::string>>(write(strings)) == strings);
+	}
+
+	void empty_round_trip()
+	{
+		auto ints = read<my_lib::list<int>>(write(my_lib::list<int>{}));
+		MY_LIB_CHECK(ints.empty());
+		auto strings = read<my_lib::list<std::string>>(write(my_lib::list<std::string>{}));
+		MY_LIB_CHECK(strings.empty());
+		// a stream that is only a header and the end mark
+		MY_LIB_CHECK(write(my_lib::list<int>{}).size() == sizeof(header_type) + sizeof(std::uint32_t));
+	}
+
+	void refused_streams()
+	{
+		my_lib::list<int> ints{ 1, 2, 3, 4, 5 };
+		my_lib::list<std::string> strings{ "one", "two", "three" };
+		auto int_bytes = write(ints);
+		auto string_bytes = write(strings);
+
+		// cut in the header, in a chunk count, in the values, before the end mark
+		for (auto size : { std::size_t{}, sizeof(header_type) / 2, sizeof(header_type) + 2, int_bytes.size() - 8, int_bytes.size() - 4 }) {
+			MY_LIB_CHECK(refused<my_lib::list<int>>(int_bytes.substr(0, size)));
+		}
+		for (auto size : { sizeof(header_type) + 6, string_bytes.size() - 6, string_bytes.size() - 4 }) {
+			MY_LIB_CHECK(refused<my_lib::list<std::string>>(string_bytes.substr(0, size)));
+		}
+
+		auto bad = int_bytes;
+		patch(bad, offsetof(header_type, magic_), std::uint32_t{ 0x4d59'4c53 }); // other byte order
+		MY_LIB_CHECK(refused<my_lib::list<int>>(bad));
+
+		bad = int_bytes;
+		patch(bad, offsetof(header_type, version_), std::uint16_t{ header_type::current_version + 1 });
+		MY_LIB_CHECK(refused<my_lib::list<int>>(bad));
+
+		// another size, another kind of the same size, raw read as serializer<T> and back
+		MY_LIB_CHECK(refused<my_lib::list<long long>>(int_bytes));
+		MY_LIB_CHECK(refused<my_lib::list<float>>(int_bytes));
+		MY_LIB_CHECK(refused<my_lib::list<unsigned>>(int_bytes));
+		MY_LIB_CHECK(refused<my_lib::list<std::string>>(int_bytes));
+		MY_LIB_CHECK(refused<my_lib::list<int>>(string_bytes));
+		bad = int_bytes;
+		patch(bad, offsetof(header_type, value_size_), std::uint32_t{ 8 });
+		MY_LIB_CHECK(refused<my_lib::list<int>>(bad));
+		bad = int_bytes;
+		patch(bad, offsetof(header_type, value_kind_), my_lib::detail::value_kind<float>());
+		MY_LIB_CHECK(refused<my_lib::list<int>>(bad));
+
+		// the chunks hold more elements than the header counts, or fewer
+		for (auto count : { std::uint64_t{ 4 }, std::uint64_t{ 0 }, std::uint64_t{ 6 } }) {
+			bad = int_bytes;
+			patch(bad, offsetof(header_type, count_), count);
+			MY_LIB_CHECK(refused<my_lib::list<int>>(bad));
+		}
+		for (auto count : { std::uint64_t{ 2 }, std::uint64_t{ 0 }, std::uint64_t{ 4 } }) {
+			bad = string_bytes;
+			patch(bad, offsetof(header_type, count_), count);
+			MY_LIB_CHECK(refused<my_lib::list<std::string>>(bad));
+		}
+	}
+}
+
+int main()
+{
+	raw_round_trip();
+	string_round_trip();
+	empty_round_trip();
+	refused_streams();
+	return my_lib::tests::report("serialize_test");
+}
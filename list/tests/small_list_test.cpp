@@ -0,0 +1,114 @@
+// small_list against std::list: random calls, extract, move and swap of inline and heap elements
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. small_list_test.cpp -o small_list_test
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "../small_list.hpp"
+#include "random_ops.hpp"
+
+namespace
+{
+	using my_lib::tests::heap_int;
+	using my_lib::tests::same_elements;
+
+	using list_type = my_lib::small_list<heap_int, 3>;
+
+	// the element lives in the buffer of the list object
+	template <class List>
+	bool is_inline(const List& list, const heap_int& value)
+	{
+		auto first = reinterpret_cast<const unsigned char*>(&list);
+		auto at = reinterpret_cast<const unsigned char*>(&value);
+		return first <= at && at < first + sizeof(List);
+	}
+
+	// 1, 2, 3 inline, 4, 5 on the heap
+	list_type make_list()
+	{
+		list_type list{ 1, 2, 3, 4, 5 };
+		MY_LIB_CHECK(is_inline(list, list.front()) && !is_inline(list, list.back()));
+		return list;
+	}
+
+	// after reserve a spare node may be an inline slot, extract must not put the element there
+	void extract_after_reserve()
+	{
+		my_lib::small_list<int, 2>::node_type handle;
+		{
+			my_lib::small_list<int, 2> list{ 1, 2 };
+			list.reserve(4);
+			list.push_back(3);
+			list.push_back(4);
+			list.pop_back();
+			list.pop_back();
+			list.erase(list.begin());
+			handle = list.extract(list.begin());
+		}
+		MY_LIB_CHECK(!handle.empty() && handle.value() == 2);
+	}
+
+	// an inline element gets a heap node, a heap one keeps its node, both can outlive the list
+	void extract_inline_and_heap()
+	{
+		list_type::node_type inline_handle;
+		list_type::node_type heap_handle;
+		const heap_int* heap_address{};
+		{
+			auto list = make_list();
+			heap_address = &list.back();
+			inline_handle = list.extract(list.begin());
+			heap_handle = list.extract(std::prev(list.end()));
+			MY_LIB_CHECK(same_elements(list, std::vector<heap_int>{ 2, 3, 4 }));
+			MY_LIB_CHECK(list.size() == 3);
+		}
+		MY_LIB_CHECK(key_of(inline_handle.value()) == 1);
+		MY_LIB_CHECK(&heap_handle.value() == heap_address);
+
+		auto other = make_list();
+		other.insert(other.begin(), std::move(inline_handle));
+		other.insert(other.end(), std::move(heap_handle));
+		MY_LIB_CHECK(inline_handle.empty() && heap_handle.empty());
+		MY_LIB_CHECK(same_elements(other, std::vector<heap_int>{ 1, 1, 2, 3, 4, 5, 5 }));
+		MY_LIB_CHECK(&other.back() == heap_address);
+	}
+
+	// inline values are moved into the slots of the target, heap nodes are relinked (same address)
+	void move_and_swap()
+	{
+		auto list = make_list();
+		auto heap_address = &list.back();
+		list_type moved{ std::move(list) };
+		MY_LIB_CHECK(list.empty());
+		MY_LIB_CHECK(same_elements(moved, std::vector<heap_int>{ 1, 2, 3, 4, 5 }));
+		MY_LIB_CHECK(is_inline(moved, moved.front()));
+		MY_LIB_CHECK(&moved.back() == heap_address);
+
+		list_type assigned{ 9 };
+		assigned = std::move(moved);
+		MY_LIB_CHECK(moved.empty());
+		MY_LIB_CHECK(same_elements(assigned, std::vector<heap_int>{ 1, 2, 3, 4, 5 }));
+		MY_LIB_CHECK(is_inline(assigned, assigned.front()));
+		MY_LIB_CHECK(&assigned.back() == heap_address);
+
+		list_type other{ 7, 8 };
+		swap(assigned, other);
+		MY_LIB_CHECK(same_elements(assigned, std::vector<heap_int>{ 7, 8 }));
+		MY_LIB_CHECK(same_elements(other, std::vector<heap_int>{ 1, 2, 3, 4, 5 }));
+		MY_LIB_CHECK(is_inline(assigned, assigned.front()) && is_inline(other, other.front()));
+		MY_LIB_CHECK(&other.back() == heap_address);
+	}
+}
+
+int main()
+{
+	for (std::uint32_t seed{ 1 }; seed <= 20; ++seed) {
+		my_lib::tests::random_operations<my_lib::small_list<heap_int, 1>>(seed, 2'000);
+		my_lib::tests::random_operations<my_lib::small_list<heap_int, 4>>(seed, 2'000);
+		my_lib::tests::random_operations<my_lib::small_list<int, 8>>(seed, 2'000);
+	}
+	extract_after_reserve();
+	extract_inline_and_heap();
+	move_and_swap();
+	return my_lib::tests::report("small_list_test");
+}
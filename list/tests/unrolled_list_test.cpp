@@ -0,0 +1,25 @@
+// unrolled_list against std::list: random calls on blocks of 1, 3 and 4 elements and the default size
+// g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.. unrolled_list_test.cpp -o unrolled_list_test
+#include <cstdint>
+#include <memory>
+#include "../unrolled_list.hpp"
+#include "random_ops.hpp"
+
+namespace
+{
+	using my_lib::tests::heap_int;
+
+	template <class T, std::size_t N>
+	using unrolled = my_lib::unrolled_list<T, std::allocator<T>, N>;
+}
+
+int main()
+{
+	for (std::uint32_t seed{ 1 }; seed <= 20; ++seed) {
+		my_lib::tests::random_operations<unrolled<int, 1>>(seed, 2'000);
+		my_lib::tests::random_operations<unrolled<int, 4>>(seed, 2'000);
+		my_lib::tests::random_operations<my_lib::unrolled_list<int>>(seed, 2'000);
+		my_lib::tests::random_operations<unrolled<heap_int, 3>>(seed, 2'000);
+	}
+	return my_lib::tests::report("unrolled_list_test");
+}
@@ -0,0 +1,1125 @@
+#pragma once
+#ifndef MY_LIB_UNROLLED_LIST
+#define MY_LIB_UNROLLED_LIST
+
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <initializer_list>
+#include <limits>
+#include <algorithm>
+#include <exception>
+#include <vector>
+#include <cassert>
+#include "my_utilities.hpp" // my custom library
+
+namespace my_lib
+{
+	/*
+	 * Structure of this file:
+	 * unrolled_list_const_iterator
+	 * unrolled_list_iterator
+	 * unrolled_node
+	 * unrolled_list
+	 *
+	 * unrolled_list keeps up to N elements per node in a contiguous array, so a scan costs one cache miss
+	 * per block instead of one per element. The interface is the one of my_lib::list, but elements are moved
+	 * inside and between blocks: insert, erase, splice, merge and sort invalidate iterators
+	 * into the blocks they touch (end() stays valid).
+	 */
+
+	// about 256 bytes of values per block, but at least 4 elements
+	template <class T>
+	constexpr std::size_t unrolled_default_capacity = sizeof(T) < 64 ? 256 / sizeof(T) : 4;
+
+	template <class MyList>
+	class unrolled_list_const_iterator
+	{
+		// type aliases
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+
+		using nodeptr = typename MyList::nodeptr;
+		using value_type = typename MyList::value_type;
+		using pointer = typename MyList::const_pointer;
+		using reference = typename MyList::const_reference;
+		using difference_type = typename MyList::difference_type;
+		using size_type = typename MyList::size_type;
+
+	private:
+		nodeptr ptr_;
+		size_type index_; // position in the block, end() is (head, 0)
+
+		// Ctors
+	public:
+		unrolled_list_const_iterator(const nodeptr ptr, size_type index) noexcept : ptr_{ ptr }, index_{ index } {}
+
+		unrolled_list_const_iterator() noexcept = default;
+
+		// Access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			assert(index_ < ptr_->count_ && "cannot dereference end iterator");
+			return ptr_->data()[index_];
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return std::pointer_traits<pointer>::pointer_to(**this);
+		}
+
+		// Increment / decrement
+	public:
+		unrolled_list_const_iterator& operator++() noexcept
+		{
+			assert(index_ < ptr_->count_ && "cannot increment end iterator");
+			if (++index_ == ptr_->count_) {
+				ptr_ = ptr_->next_;
+				index_ = 0;
+			}
+			return *this;
+		}
+
+		unrolled_list_const_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		unrolled_list_const_iterator& operator--() noexcept
+		{
+			if (index_ == 0) {
+				ptr_ = ptr_->prev_;
+				assert(ptr_->count_ != 0 && "cannot decrement begin iterator");
+				index_ = ptr_->count_;
+			}
+			--index_;
+			return *this;
+		}
+
+		unrolled_list_const_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+		// Compare
+	public:
+		[[nodiscard]] bool operator ==(const unrolled_list_const_iterator& rhs) const noexcept
+		{
+			return ptr_ == rhs.ptr_ && index_ == rhs.index_;
+		}
+
+		[[nodiscard]] bool operator !=(const unrolled_list_const_iterator& rhs) const noexcept
+		{
+			return !(*this == rhs);
+		}
+
+	public:
+		const nodeptr& get_pointer() const noexcept
+		{
+			return ptr_;
+		}
+
+		size_type get_index() const noexcept
+		{
+			return index_;
+		}
+	};
+
+	template <class MyList>
+	class unrolled_list_iterator : public unrolled_list_const_iterator<MyList>
+	{
+	// type aliases
+	public:
+		using mybase			= unrolled_list_const_iterator<MyList>;
+		using mybase::mybase; // ctors
+
+		using nodeptr			= typename MyList::nodeptr;
+		using value_type		= typename MyList::value_type;
+		using pointer			= typename MyList::pointer;
+		using reference			= typename MyList::reference;
+		using difference_type	= typename MyList::difference_type;
+
+	// public access
+	public:
+		[[nodiscard]] reference operator*() const noexcept
+		{
+			return const_cast<reference>(mybase::operator*());
+		}
+
+		[[nodiscard]] pointer operator->() const noexcept
+		{
+			return const_cast<pointer>(mybase::operator->());
+		}
+
+	// increment / decrement
+	public:
+		unrolled_list_iterator& operator++() noexcept
+		{
+			mybase::operator++();
+			return *this;
+		}
+
+		unrolled_list_iterator operator++(int) noexcept
+		{
+			auto tmp{ *this };
+			++* this;
+			return tmp;
+		}
+
+
+		unrolled_list_iterator& operator--() noexcept
+		{
+			mybase::operator--();
+			return *this;
+		}
+
+		unrolled_list_iterator operator--(int) noexcept
+		{
+			auto tmp{ *this };
+			--* this;
+			return tmp;
+		}
+
+	// compare
+	public:
+		using mybase::operator==;
+		using mybase::operator!=;
+	};
+
+	// the head is a node with count_ == 0, every other node holds 1..N elements
+	template <class T, class Pointer, std::size_t N>
+	struct unrolled_node
+	{
+		// type aliases
+		using value_type = T;
+		using nodeptr = typename std::pointer_traits<Pointer>::template rebind<unrolled_node>;
+
+		// data
+		nodeptr		next_; // next block, or first if head
+		nodeptr		prev_; // previous block, or last if head
+		std::size_t count_; // constructed values, they are [0, count_)
+		alignas(T) unsigned char storage_[sizeof(T) * N];
+
+		unrolled_node(nodeptr next, nodeptr prev) noexcept : next_{ next }, prev_{ prev }, count_{} {}
+
+		// copying
+		unrolled_node(const unrolled_node&)				= delete;
+		unrolled_node& operator=(const unrolled_node&)	= delete;
+
+		[[nodiscard]] T* data() noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(storage_));
+		}
+
+		[[nodiscard]] const T* data() const noexcept
+		{
+			return std::launder(reinterpret_cast<const T*>(storage_));
+		}
+	};
+
+	template <class T, class Alloc = std::allocator<T>, std::size_t N = unrolled_default_capacity<T>>
+	class unrolled_list
+	{
+		static_assert(N != 0, "unrolled_list block cannot be empty");
+
+		// type aliases
+	public:
+		// value type aliases
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		// allocator types aliases and node pointer aliases
+		using allocator_type = Alloc;
+		using list_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+		using list_allocator_traits = std::allocator_traits<list_allocator>;
+		using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<unrolled_node<T, typename std::allocator_traits<Alloc>::void_pointer, N>>;
+		using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+		using node_type = unrolled_node<T, typename node_allocator_traits::void_pointer, N>;
+		using nodeptr = typename node_allocator_traits::pointer;
+
+		// iterator aliases
+		using iterator = unrolled_list_iterator<unrolled_list<T, Alloc, N>>;
+		using const_iterator = unrolled_list_const_iterator<unrolled_list<T, Alloc, N>>;
+
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		constexpr static size_type block_capacity{ N };
+
+		// list data
+	private:
+		node_allocator_type allocator_;
+		nodeptr head_;
+		size_type size_;
+
+		// Block helpers
+	private:
+		[[nodiscard]] nodeptr create_head()
+		{
+			auto head = allocator_.allocate(1);
+			node_allocator_traits::construct(allocator_, head, head, head);
+			return head;
+		}
+
+		// new empty block linked before `where`
+		[[nodiscard]] nodeptr insert_block(nodeptr where)
+		{
+			auto node = allocator_.allocate(1);
+			node_allocator_traits::construct(allocator_, node, where, where->prev_);
+			where->prev_->next_ = node;
+			where->prev_ = node;
+			return node;
+		}
+
+		// unlink and free the block, its values must be destroyed already
+		void free_block(nodeptr node) noexcept
+		{
+			assert(node->count_ == 0 && "block is not empty");
+			node->prev_->next_ = node->next_;
+			node->next_->prev_ = node->prev_;
+			node_allocator_traits::destroy(allocator_, std::addressof(*node));
+			allocator_.deallocate(node, 1);
+		}
+
+		// destroy values [from, count_) of the block
+		void destroy_values(nodeptr node, size_type from) noexcept
+		{
+			auto values = node->data();
+			for (auto i = from; i < node->count_; ++i) {
+				node_allocator_traits::destroy(allocator_, values + i);
+			}
+			node->count_ = from;
+		}
+
+		// move values [from, count_) of `node` to the end of `to`, nothing changes if a move throws
+		void move_values(nodeptr node, size_type from, nodeptr to)
+		{
+			auto values = node->data();
+			auto target = to->data();
+			auto old_count = to->count_;
+			try {
+				for (auto i = from; i < node->count_; ++i) {
+					node_allocator_traits::construct(allocator_, target + to->count_, std::move_if_noexcept(values[i]));
+					++to->count_;
+				}
+			}
+			catch (...) {
+				destroy_values(to, old_count);
+				throw;
+			}
+			destroy_values(node, from);
+		}
+
+		// construct a value at the end of the block, an empty block is freed if the ctor throws
+		template <class... Args>
+		void construct_back(nodeptr node, Args&&... args)
+		{
+			try {
+				node_allocator_traits::construct(allocator_, node->data() + node->count_, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				if (node->count_ == 0) {
+					free_block(node);
+				}
+				throw;
+			}
+			++node->count_;
+			++size_;
+		}
+
+		// construct a value at the end of the block before `where` (or of a new block if that one is full)
+		template <class... Args>
+		void construct_before(nodeptr where, Args&&... args)
+		{
+			auto node = where->prev_;
+			if (node == head_ || node->count_ == N) {
+				node = insert_block(where);
+			}
+			construct_back(node, std::forward<Args>(args)...);
+		}
+
+		// merge the block with the next one if both fit in one
+		void try_merge(nodeptr node) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+		{
+			if (node == head_ || node->next_ == head_) return;
+			auto next = node->next_;
+			if (node->count_ + next->count_ <= N) {
+				move_values(next, 0, node);
+				free_block(next);
+			}
+		}
+
+		// makes pos the first value of a block and returns this block (head for end())
+		nodeptr split_at(const_iterator pos)
+		{
+			auto node = pos.get_pointer();
+			auto index = pos.get_index();
+			if (index == 0) return node;
+			if (index == node->count_) return node->next_; // already split here
+
+			auto right = insert_block(node->next_);
+			try {
+				move_values(node, index, right);
+			}
+			catch (...) {
+				free_block(right);
+				throw;
+			}
+			return right;
+		}
+
+		void tidy() noexcept
+		{
+			for (auto node = head_->next_; node != head_; ) {
+				auto next = node->next_;
+				destroy_values(node, 0);
+				node_allocator_traits::destroy(allocator_, std::addressof(*node));
+				allocator_.deallocate(node, 1);
+				node = next;
+			}
+			head_->next_ = head_;
+			head_->prev_ = head_;
+			size_ = 0;
+		}
+
+		[[nodiscard]] iterator make_iterator(nodeptr node, size_type index) noexcept
+		{
+			if (index == node->count_) {
+				return iterator{ node->next_, 0 };
+			}
+			return iterator{ node, index };
+		}
+
+		// Ctors and dtor
+	public:
+		unrolled_list() : unrolled_list(allocator_type{}) {}
+
+		explicit unrolled_list(const allocator_type& allocator) : allocator_{ allocator }, head_{ create_head() }, size_{} {}
+
+		explicit unrolled_list(size_type count, const allocator_type& allocator = allocator_type{}) : unrolled_list(allocator)
+		{
+			resize(count);
+		}
+
+		unrolled_list(size_type count, const_reference value, const allocator_type& allocator = allocator_type{}) : unrolled_list(allocator)
+		{
+			insert(end(), count, value);
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		unrolled_list(Iter first, Iter last, const allocator_type& allocator = allocator_type{}) : unrolled_list(allocator)
+		{
+			insert(end(), first, last);
+		}
+
+		unrolled_list(const unrolled_list& rhs) : unrolled_list(std::allocator_traits<allocator_type>::select_on_container_copy_construction(rhs.allocator_))
+		{
+			insert(end(), rhs.begin(), rhs.end());
+		}
+
+		unrolled_list(const unrolled_list& rhs, const allocator_type& allocator) : unrolled_list(allocator)
+		{
+			insert(end(), rhs.begin(), rhs.end());
+		}
+
+		unrolled_list(unrolled_list&& rhs) : allocator_{ rhs.allocator_ }, head_{ create_head() }, size_{}
+		{
+			std::swap(head_, rhs.head_);
+			std::swap(size_, rhs.size_);
+		}
+
+		unrolled_list(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type{}) : unrolled_list(allocator)
+		{
+			insert(end(), ilist.begin(), ilist.end());
+		}
+
+		~unrolled_list() noexcept
+		{
+			tidy();
+			node_allocator_traits::destroy(allocator_, std::addressof(*head_));
+			allocator_.deallocate(head_, 1);
+		}
+
+		// Member functions (operator=, assign, get_allocator)
+	public:
+		unrolled_list& operator=(const unrolled_list& rhs)
+		{
+			if (this != std::addressof(rhs)) {
+				assign(rhs.begin(), rhs.end());
+			}
+			return *this;
+		}
+
+		unrolled_list& operator=(unrolled_list&& rhs)
+		{
+			if (this == std::addressof(rhs)) return *this;
+
+			if (allocator_ == rhs.allocator_) {
+				clear();
+			}
+			else if (list_allocator_traits::propagate_on_container_move_assignment::value) {
+				tidy(); // use old allocator to free the storage
+				node_allocator_traits::destroy(allocator_, std::addressof(*head_));
+				allocator_.deallocate(head_, 1);
+				allocator_ = rhs.allocator_;
+				head_ = create_head();
+			}
+			else {
+				assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+				rhs.clear();
+				return *this;
+			}
+
+			std::swap(head_, rhs.head_);
+			std::swap(size_, rhs.size_);
+			return *this;
+		}
+
+		unrolled_list& operator=(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		template <class Iter, std::enable_if_t<is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		void assign(Iter first, const Iter last)
+		{
+			clear();
+			insert(end(), first, last);
+		}
+
+		void assign(size_type count, const_reference value)
+		{
+			clear();
+			insert(end(), count, value);
+		}
+
+		void assign(std::initializer_list<T> ilist)
+		{
+			assign(ilist.begin(), ilist.end());
+		}
+
+		[[nodiscard]] allocator_type get_allocator() const noexcept
+		{
+			return static_cast<allocator_type>(allocator_);
+		}
+
+		// Element access
+	public:
+		[[nodiscard]] reference front()
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return head_->next_->data()[0];
+		}
+
+		[[nodiscard]] const_reference front() const
+		{
+			assert(size_ != 0 && "front() on empty container");
+			return head_->next_->data()[0];
+		}
+
+		[[nodiscard]] reference back()
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return head_->prev_->data()[head_->prev_->count_ - 1];
+		}
+
+		[[nodiscard]] const_reference back() const
+		{
+			assert(size_ != 0 && "back() on empty container");
+			return head_->prev_->data()[head_->prev_->count_ - 1];
+		}
+
+		// Iterators
+	public:
+		[[nodiscard]] iterator begin() noexcept
+		{
+			return iterator(head_->next_, 0);
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept
+		{
+			return const_iterator(head_->next_, 0);
+		}
+
+		[[nodiscard]] iterator end() noexcept
+		{
+			return iterator(head_, 0);
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return const_iterator(head_, 0);
+		}
+
+		[[nodiscard]] const_iterator cbegin() const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept
+		{
+			return end();
+		}
+
+		[[nodiscard]] reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator(end());
+		}
+
+		[[nodiscard]] const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator(end());
+		}
+
+		[[nodiscard]] reverse_iterator rend() noexcept
+		{
+			return reverse_iterator(begin());
+		}
+
+		[[nodiscard]] const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator(begin());
+		}
+
+		[[nodiscard]] const_reverse_iterator crbegin() const noexcept
+		{
+			return const_reverse_iterator(end());
+		}
+
+		[[nodiscard]] const_reverse_iterator crend() const noexcept
+		{
+			return const_reverse_iterator(begin());
+		}
+
+		// Capacity
+	public:
+		[[nodiscard]] bool empty() const noexcept
+		{
+			return size_ == 0;
+		}
+
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] size_type max_size() const noexcept
+		{
+			auto diff_max = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+			auto alnode_max = static_cast<size_type>(node_allocator_traits::max_size(allocator_)) * N;
+			if (diff_max < alnode_max) return diff_max;
+			return alnode_max;
+		}
+
+		// Modifiers
+	public:
+		void clear() noexcept
+		{
+			tidy();
+		}
+
+		iterator insert(const_iterator pos, const_reference value)
+		{
+			return emplace(pos, value);
+		}
+
+		iterator insert(const_iterator pos, value_type&& value)
+		{
+			return emplace(pos, std::move(value));
+		}
+
+		// the values go to the end of the block before pos (after a split) and to new blocks
+		iterator insert(const_iterator pos, size_type count, const_reference value)
+		{
+			if (count == 0) return iterator{ pos.get_pointer(), pos.get_index() };
+
+			auto where = split_at(pos);
+			auto before = where->prev_;
+			auto before_count = before->count_;
+			for (size_type i{}; i < count; ++i) {
+				construct_before(where, value);
+			}
+			return make_iterator(before, before_count);
+		}
+
+		template <class Iter, std::enable_if_t <is_iterator<Iter>::value || std::is_pointer<Iter>::value, int> = 0>
+		iterator insert(const_iterator pos, Iter first, Iter last)
+		{
+			if (first == last) return iterator{ pos.get_pointer(), pos.get_index() };
+
+			auto where = split_at(pos);
+			auto before = where->prev_;
+			auto before_count = before->count_;
+			for (; first != last; ++first) {
+				construct_before(where, *first);
+			}
+			return make_iterator(before, before_count);
+		}
+
+		iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+		{
+			return insert(pos, ilist.begin(), ilist.end());
+		}
+
+		template <class... Args>
+		iterator emplace(const_iterator pos, Args&&... what)
+		{
+			auto node = pos.get_pointer();
+			auto index = pos.get_index();
+
+			if (node == head_ || (index == 0 && node->prev_ != head_ && node->prev_->count_ < N)) {
+				// append to the previous block when there is room
+				node = node->prev_;
+				if (node == head_ || node->count_ == N) {
+					node = insert_block(pos.get_pointer());
+				}
+				index = node->count_;
+			}
+			else if (node->count_ == N) {
+				if (index == 0) {
+					node = insert_block(node);
+				}
+				else {
+					auto half = N / 2;
+					auto right = split_at(const_iterator{ node, half });
+					if (index > half) {
+						node = right;
+						index -= half;
+					}
+				}
+			}
+
+			if (index == node->count_) {
+				construct_back(node, std::forward<Args>(what)...);
+			}
+			else {
+				value_type tmp(std::forward<Args>(what)...); // args may refer to a value of this block
+				auto values = node->data();
+				auto count = node->count_;
+				node_allocator_traits::construct(allocator_, values + count, std::move(values[count - 1]));
+				++node->count_;
+				++size_;
+				std::move_backward(values + index, values + count - 1, values + count);
+				values[index] = std::move(tmp);
+			}
+			return iterator{ node, index };
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			auto node = pos.get_pointer();
+			auto index = pos.get_index();
+			assert(node != head_ && "cannot erase end iterator");
+
+			auto values = node->data();
+			std::move(values + index + 1, values + node->count_, values + index);
+			destroy_values(node, node->count_ - 1);
+			--size_;
+
+			if (node->count_ == 0) {
+				auto next = node->next_;
+				free_block(node);
+				return iterator{ next, 0 };
+			}
+
+			if (node->count_ < N / 4) {
+				try_merge(node);
+			}
+			return make_iterator(node, index);
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			if (first == last) return iterator{ last.get_pointer(), last.get_index() };
+
+			auto end = split_at(last); // last first, so first stays valid when both are in one block
+			auto begin = split_at(first);
+			for (auto node = begin; node != end; ) {
+				auto next = node->next_;
+				size_ -= node->count_;
+				destroy_values(node, 0);
+				free_block(node);
+				node = next;
+			}
+			return iterator{ end, 0 };
+		}
+
+
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		template <class... Args>
+		reference emplace_back(Args&&... what)
+		{
+			construct_before(head_, std::forward<Args>(what)...);
+			return back();
+		}
+
+		void pop_back() noexcept
+		{
+			assert(size_ != 0 && "cannot pop from empty container");
+
+			auto node = head_->prev_;
+			destroy_values(node, node->count_ - 1);
+			if (node->count_ == 0) {
+				free_block(node);
+			}
+			--size_;
+		}
+
+
+		void push_front(const_reference value)
+		{
+			emplace_front(value);
+		}
+
+		void push_front(value_type&& value)
+		{
+			emplace_front(std::move(value));
+		}
+
+		template <class... Args>
+		reference emplace_front(Args&&... what)
+		{
+			return *emplace(begin(), std::forward<Args>(what)...);
+		}
+
+		void pop_front()
+		{
+			assert(size_ != 0 && "cannot pop on empty container");
+			erase(begin());
+		}
+
+
+		void resize(size_type new_size)
+		{
+			while (size_ < new_size) {
+				emplace_back();
+			}
+			while (new_size < size_) {
+				pop_back();
+			}
+		}
+
+		void resize(size_type new_size, const_reference value)
+		{
+			if (size_ < new_size) {
+				insert(end(), new_size - size_, value);
+			}
+			while (new_size < size_) {
+				pop_back();
+			}
+		}
+
+
+		void swap(unrolled_list& rhs) noexcept(node_allocator_traits::propagate_on_container_swap::value
+			|| node_allocator_traits::is_always_equal::value)
+		{
+			if (this != std::addressof(rhs)) {
+				if constexpr (node_allocator_traits::propagate_on_container_swap::value) {
+					std::swap(allocator_, rhs.allocator_);
+				}
+				else {
+					assert(allocator_ == rhs.allocator_ && "list allocators incompatible for swap");
+				}
+
+				std::swap(head_, rhs.head_);
+				std::swap(size_, rhs.size_);
+			}
+		}
+
+		// Operations
+	private:
+		// Keeps the values for which remove(last kept, value) is false and packs them to the front
+		// of the block chain, emptied blocks are freed. If remove throws, the rest is kept
+		template <class Remove>
+		void compact(Remove remove)
+		{
+			std::exception_ptr error;
+			auto wnode = head_->next_;
+			size_type windex{};
+			pointer last_kept{};
+
+			for (auto rnode = head_->next_; rnode != head_; rnode = rnode->next_) {
+				auto values = rnode->data();
+				for (size_type i{}; i < rnode->count_; ++i) {
+					if (!error) {
+						try {
+							if (remove(last_kept, values[i])) continue;
+						}
+						catch (...) {
+							error = std::current_exception();
+						}
+					}
+
+					if (wnode != rnode || windex != i) {
+						wnode->data()[windex] = std::move(values[i]);
+					}
+					last_kept = wnode->data() + windex;
+					if (++windex == wnode->count_) {
+						wnode = wnode->next_;
+						windex = 0;
+					}
+				}
+			}
+
+			while (wnode != head_) {
+				auto next = wnode->next_;
+				size_ -= wnode->count_ - windex;
+				destroy_values(wnode, windex);
+				if (wnode->count_ == 0) {
+					free_block(wnode);
+				}
+				wnode = next;
+				windex = 0;
+			}
+
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		}
+
+	public:
+		template <class Cmp = std::less<value_type>>
+		void merge(unrolled_list& rhs, Cmp cmp = Cmp{})
+		{
+			merge(std::move(rhs), cmp);
+		}
+
+		template <class Cmp = std::less<value_type>>
+		void merge(unrolled_list&& rhs, Cmp cmp = Cmp{})
+		{
+			if (this == std::addressof(rhs) || rhs.size_ == 0) return;
+			assert(std::is_sorted(begin(), end(), cmp) && std::is_sorted(rhs.begin(), rhs.end(), cmp) && "sequence not ordered");
+
+			unrolled_list result(get_allocator());
+			auto lhsnode = begin();
+			auto rhsnode = rhs.begin();
+			while (lhsnode != end() && rhsnode != rhs.end()) {
+				if (cmp(*rhsnode, *lhsnode)) {
+					result.emplace_back(std::move(*rhsnode++));
+				}
+				else {
+					result.emplace_back(std::move(*lhsnode++));
+				}
+			}
+			for (; lhsnode != end(); ++lhsnode) {
+				result.emplace_back(std::move(*lhsnode));
+			}
+			for (; rhsnode != rhs.end(); ++rhsnode) {
+				result.emplace_back(std::move(*rhsnode));
+			}
+
+			rhs.clear();
+			clear();
+			std::swap(head_, result.head_);
+			std::swap(size_, result.size_);
+		}
+
+
+		void splice(const_iterator pos, unrolled_list& rhs)
+		{
+			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, unrolled_list&& rhs)
+		{
+			splice(pos, std::move(rhs), rhs.begin(), rhs.end());
+		}
+
+		void splice(const_iterator pos, unrolled_list& rhs, const_iterator it)
+		{
+			splice(pos, std::move(rhs), it);
+		}
+
+		void splice(const_iterator pos, unrolled_list&& rhs, const_iterator it)
+		{
+			auto next = it;
+			splice(pos, std::move(rhs), it, ++next);
+		}
+
+		void splice(const_iterator pos, unrolled_list& rhs, const_iterator first, const_iterator last)
+		{
+			splice(pos, std::move(rhs), first, last);
+		}
+
+		// The range becomes whole blocks which are relinked, only the boundary blocks move values
+		void splice(const_iterator pos, unrolled_list&& rhs, const_iterator first, const_iterator last)
+		{
+			assert(allocator_ == rhs.allocator_ && "list allocators incompatible for splice");
+			if (first == last) return;
+
+			// a split moves the values after it, so the points of one block are split from the last one
+			const_iterator points[]{ pos, first, last };
+			nodeptr blocks[3]{};
+			int order[]{ 0, 1, 2 };
+			std::sort(std::begin(order), std::end(order), [&points](int lhs, int rhs) {
+				if (points[lhs].get_pointer() != points[rhs].get_pointer()) {
+					return std::less<nodeptr>{}(points[lhs].get_pointer(), points[rhs].get_pointer());
+				}
+				return points[lhs].get_index() > points[rhs].get_index();
+			});
+			for (auto i : order) {
+				blocks[i] = split_at(points[i]);
+			}
+
+			auto where = blocks[0];
+			auto begin = blocks[1];
+			auto end = blocks[2];
+			if (where == begin || where == end) return; // already there
+
+			auto back = end->prev_;
+			size_type range_size{};
+			for (auto node = begin; node != end; node = node->next_) {
+				range_size += node->count_;
+			}
+
+			auto rhs_before = begin->prev_;
+			rhs_before->next_ = end;
+			end->prev_ = rhs_before;
+
+			begin->prev_ = where->prev_;
+			where->prev_->next_ = begin;
+			back->next_ = where;
+			where->prev_ = back;
+
+			rhs.size_ -= range_size;
+			size_ += range_size;
+
+			rhs.try_merge(rhs_before);
+			try_merge(back);
+			try_merge(begin->prev_);
+		}
+
+
+		void remove(const_reference value)
+		{
+			compact([&value](const_pointer, const_reference current) { return current == value; });
+		}
+
+		template <class Predicate>
+		void remove_if(Predicate pred)
+		{
+			compact([&pred](const_pointer, reference current) { return pred(current); });
+		}
+
+
+		void reverse() noexcept
+		{
+			auto node = head_;
+			do {
+				std::swap(node->next_, node->prev_);
+				std::reverse(node->data(), node->data() + node->count_);
+				node = node->prev_; // the old next
+			} while (node != head_);
+		}
+
+		void unique()
+		{
+			unique(std::equal_to<value_type>{});
+		}
+
+		template <class BinaryPredicate>
+		void unique(BinaryPredicate pred)
+		{
+			compact([&pred](const_pointer last_kept, const_reference current) { return last_kept && pred(*last_kept, current); });
+		}
+
+		// Stable sort of pointers to the values, then the values are moved into place through a buffer.
+		// If pred throws, the list is not changed
+		template <class BinaryPred = std::less<value_type>>
+		void sort(BinaryPred pred = BinaryPred{})
+		{
+			if (size_ < 2) return;
+
+			std::vector<pointer> order;
+			order.reserve(size_);
+			for (auto node = head_->next_; node != head_; node = node->next_) {
+				for (size_type i{}; i < node->count_; ++i) {
+					order.push_back(node->data() + i);
+				}
+			}
+			std::stable_sort(order.begin(), order.end(), [&pred](pointer lhs, pointer rhs) { return pred(*lhs, *rhs); });
+
+			std::vector<value_type> sorted;
+			sorted.reserve(size_);
+			for (auto value : order) {
+				sorted.push_back(std::move_if_noexcept(*value));
+			}
+
+			auto value = sorted.begin();
+			for (auto node = head_->next_; node != head_; node = node->next_) {
+				for (size_type i{}; i < node->count_; ++i, ++value) {
+					node->data()[i] = std::move(*value);
+				}
+			}
+		}
+	};
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator==(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+	}
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator!=(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator<(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator>(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return rhs < lhs;
+	}
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator<=(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+
+	template <class T, class Alloc, std::size_t N>
+	[[nodiscard]] bool operator>=(const unrolled_list<T, Alloc, N>& lhs, const unrolled_list<T, Alloc, N>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+}
+
+namespace std {
+	template <class T, class Alloc, std::size_t N>
+	void swap(my_lib::unrolled_list<T, Alloc, N>& lhs, my_lib::unrolled_list<T, Alloc, N>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif